@@ -0,0 +1,91 @@
+// Replacement of global operator new and delete that counts allocations, see AllocationCounter.h.
+// Operators live in their own file, so the compiler never sees malloc and free under new and delete
+// of the benchmarks and doesn't take them for mismatched pairs
+#include <atomic>
+#include <new>
+#include <cstdlib>
+
+#include "AllocationCounter.h"
+
+AllocationCounters Allocated;
+
+// Header keeps alignment of the block the same as of the block of malloc
+const size_t AllocationHeaderSize = 16;
+
+// Helpers aren't inlined into the operators for the same reason
+#ifdef _MSC_VER
+#define COUNTER_NOINLINE __declspec(noinline)
+#else
+#define COUNTER_NOINLINE __attribute__((noinline))
+#endif
+
+COUNTER_NOINLINE void* CountedAllocate(size_t Size) {
+	void* Block = malloc(Size + AllocationHeaderSize);
+	if (!Block) {
+		return NULL;
+	}
+	*(size_t*)Block = Size;
+	Allocated.Allocations.fetch_add(1, std::memory_order_relaxed);
+	long long InUse = Allocated.BytesInUse.fetch_add(Size, std::memory_order_relaxed) + Size;
+	long long Peak = Allocated.PeakBytes.load(std::memory_order_relaxed);
+	while (InUse > Peak && !Allocated.PeakBytes.compare_exchange_weak(Peak, InUse, std::memory_order_relaxed)) {
+	}
+	return (char*)Block + AllocationHeaderSize;
+}
+
+COUNTER_NOINLINE void CountedFree(void* Pointer) {
+	if (!Pointer) {
+		return;
+	}
+	void* Block = (char*)Pointer - AllocationHeaderSize;
+	Allocated.BytesInUse.fetch_sub(*(size_t*)Block, std::memory_order_relaxed);
+	free(Block);
+}
+
+void ResetPeakBytes() {
+	Allocated.PeakBytes.store(Allocated.BytesInUse.load());
+}
+
+void* operator new(size_t Size) {
+	void* Pointer = CountedAllocate(Size);
+	if (!Pointer) {
+		throw std::bad_alloc();
+	}
+	return Pointer;
+}
+
+void* operator new[](size_t Size) {
+	return operator new(Size);
+}
+
+void* operator new(size_t Size, const std::nothrow_t&) noexcept {
+	return CountedAllocate(Size);
+}
+
+void* operator new[](size_t Size, const std::nothrow_t&) noexcept {
+	return CountedAllocate(Size);
+}
+
+void operator delete(void* Pointer) noexcept {
+	CountedFree(Pointer);
+}
+
+void operator delete[](void* Pointer) noexcept {
+	CountedFree(Pointer);
+}
+
+void operator delete(void* Pointer, size_t) noexcept {
+	CountedFree(Pointer);
+}
+
+void operator delete[](void* Pointer, size_t) noexcept {
+	CountedFree(Pointer);
+}
+
+void operator delete(void* Pointer, const std::nothrow_t&) noexcept {
+	CountedFree(Pointer);
+}
+
+void operator delete[](void* Pointer, const std::nothrow_t&) noexcept {
+	CountedFree(Pointer);
+}
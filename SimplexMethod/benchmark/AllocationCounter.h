@@ -0,0 +1,16 @@
+#pragma once
+
+// Counts allocations of the whole program by replacing global operator new and delete (AllocationCounter.cpp).
+// Every block has a header with its size, so the counter knows how many bytes are in use and their peak.
+// Link AllocationCounter.cpp into a benchmark that includes it
+
+struct AllocationCounters {
+	std::atomic<long long> Allocations{ 0 };
+	std::atomic<long long> BytesInUse{ 0 };
+	std::atomic<long long> PeakBytes{ 0 };
+};
+
+extern AllocationCounters Allocated;
+
+// Peak is measured from this moment
+void ResetPeakBytes();
@@ -0,0 +1,25 @@
+#pragma once
+
+// Values of JSON files with results of the benchmarks
+
+static void WriteJsonString(FILE* File, const char* Text) {
+	fputc('"', File);
+	for (const char* Character = Text; *Character; Character++) {
+		if (*Character == '"' || *Character == '\\') {
+			fputc('\\', File);
+		}
+		if ((unsigned char)*Character >= ' ') {
+			fputc(*Character, File);
+		}
+	}
+	fputc('"', File);
+}
+
+// Numbers JSON can't have are written as null
+static void WriteJsonNumber(FILE* File, double Value) {
+	if (std::isfinite(Value)) {
+		fprintf(File, "%.17g", Value);
+	} else {
+		fprintf(File, "null");
+	}
+}
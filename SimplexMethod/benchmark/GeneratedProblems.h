@@ -0,0 +1,201 @@
+#pragma once
+
+// Problems the benchmarks are run on, the same seed gives the same problem
+
+// Problem with a known admissible point, so artificial basis method makes a step for every limitation
+static void GenerateProblem(int NumberOfLimitations, int NumberOfVariables, unsigned Seed, Problem& problem) {
+	std::mt19937 Random(Seed);
+	std::uniform_int_distribution<int> Coefficient(0, 6);
+	std::uniform_int_distribution<int> Point(0, 5);
+
+	problem.Resize(NumberOfLimitations, NumberOfVariables);
+	std::vector<int> X(NumberOfVariables);
+	for (int& x : X) {
+		x = Point(Random);
+	}
+	for (int i = 0; i < NumberOfLimitations; i++) {
+		int B = 0;
+		for (int j = 0; j < NumberOfVariables; j++) {
+			int a = Coefficient(Random);
+			problem.RealMatrix[i][j] = (float)a;
+			problem.FracMatrix[i][j] = Fraction(a, 1);
+			B += a * X[j];
+		}
+		problem.RealMatrix[i][NumberOfVariables] = (float)B;
+		problem.FracMatrix[i][NumberOfVariables] = Fraction(B, 1);
+	}
+	for (int j = 0; j < NumberOfVariables; j++) {
+		int c = Coefficient(Random);
+		problem.RealTargetFunction[j] = (float)c;
+		problem.FractionalTargetFunction[j] = Fraction(c, 1);
+	}
+}
+
+// Element of the matrix of limitations in both types, column NumberOfVariables is vector B
+static void SetGeneratedElement(Problem& problem, int Row, int Column, Fraction Value) {
+	problem.RealMatrix[Row][Column] = (float)ToDouble(Value);
+	problem.FracMatrix[Row][Column] = Value;
+}
+
+static void SetGeneratedCost(Problem& problem, int Column, Fraction Value) {
+	problem.RealTargetFunction[Column] = (float)ToDouble(Value);
+	problem.FractionalTargetFunction[Column] = Value;
+}
+
+// Sparse problem of the same kind: every row has a few elements and one on the diagonal, so no row is empty
+static void GenerateSparseProblem(int NumberOfLimitations, int NumberOfVariables, unsigned Seed, Problem& problem) {
+	std::mt19937 Random(Seed);
+	std::uniform_int_distribution<int> Coefficient(1, 9);
+	std::uniform_int_distribution<int> Point(0, 5);
+	std::uniform_int_distribution<int> Column(0, NumberOfVariables - 1);
+	const int ElementsInRow = 4;
+
+	problem.Resize(NumberOfLimitations, NumberOfVariables);
+	std::vector<int> X(NumberOfVariables);
+	for (int& x : X) {
+		x = Point(Random);
+	}
+	for (int i = 0; i < NumberOfLimitations; i++) {
+		int B = 0;
+		for (int k = 0; k < ElementsInRow; k++) {
+			int j = k == 0 ? i : Column(Random);
+			if (problem.FracMatrix[i][j].numerator == 0) {
+				int a = Coefficient(Random);
+				SetGeneratedElement(problem, i, j, Fraction(a, 1));
+				B += a * X[j];
+			}
+		}
+		SetGeneratedElement(problem, i, NumberOfVariables, Fraction(B, 1));
+	}
+	for (int j = 0; j < NumberOfVariables; j++) {
+		SetGeneratedCost(problem, j, Fraction(Coefficient(Random) - 3, 1));
+	}
+}
+
+// Klee-Minty cube of dimension N with slack variables, N limitations and 2N variables:
+// max sum 2^(N-j) x_j, sum over j < i of 2^(i-j+1) x_j + x_i + s_i = 5^i.
+// Numbers grow exponentially, so it also shows where the types of elements lose precision
+static void GenerateKleeMintyProblem(int Dimension, Problem& problem) {
+	problem.Resize(Dimension, Dimension * 2);
+	for (int i = 0; i < Dimension; i++) {
+		for (int j = 0; j < i; j++) {
+			SetGeneratedElement(problem, i, j, Fraction(1 << std::min(i - j + 1, 30), 1));
+		}
+		SetGeneratedElement(problem, i, i, Fraction(1, 1));
+		SetGeneratedElement(problem, i, Dimension + i, Fraction(1, 1));
+		double B = pow(5.0, i + 1);
+		problem.RealMatrix[i][Dimension * 2] = (float)B;
+		problem.FracMatrix[i][Dimension * 2] = Fraction(B < INT32_MAX ? (int)B : INT32_MAX, 1);
+	}
+	for (int j = 0; j < Dimension; j++) {
+		SetGeneratedCost(problem, j, Fraction(-(1 << std::min(Dimension - 1 - j, 30)), 1));
+	}
+}
+
+// Assignment of N workers to N jobs, every basis is highly degenerate.
+// Variable i * N + j is worker i doing job j. The last job has no limitation, it follows from the others
+static void GenerateAssignmentProblem(int N, unsigned Seed, Problem& problem) {
+	std::mt19937 Random(Seed);
+	std::uniform_int_distribution<int> Cost(1, 20);
+
+	problem.Resize(2 * N - 1, N * N);
+	for (int i = 0; i < N; i++) {
+		for (int j = 0; j < N; j++) {
+			SetGeneratedElement(problem, i, i * N + j, Fraction(1, 1));
+			if (j < N - 1) {
+				SetGeneratedElement(problem, N + j, i * N + j, Fraction(1, 1));
+			}
+			SetGeneratedCost(problem, i * N + j, Fraction(Cost(Random), 1));
+		}
+	}
+	for (int i = 0; i < 2 * N - 1; i++) {
+		SetGeneratedElement(problem, i, N * N, Fraction(1, 1));
+	}
+}
+
+// Balanced transportation problem from N suppliers to N consumers.
+// Variable i * N + j is the amount from supplier i to consumer j, the last consumer has no limitation
+static void GenerateTransportationProblem(int N, unsigned Seed, Problem& problem) {
+	std::mt19937 Random(Seed);
+	std::uniform_int_distribution<int> Amount(1, 50);
+	std::uniform_int_distribution<int> Cost(1, 30);
+
+	std::vector<int> Supply(N);
+	std::vector<int> Demand(N, 0);
+	int Total = 0;
+	for (int& Value : Supply) {
+		Value = Amount(Random);
+		Total += Value;
+	}
+	// Demands are random too, the last one takes the rest
+	int Rest = Total;
+	for (int j = 0; j < N - 1; j++) {
+		Demand[j] = std::min(Rest, Amount(Random) * Total / (N * 50) + 1);
+		Rest -= Demand[j];
+	}
+	Demand[N - 1] = Rest;
+
+	problem.Resize(2 * N - 1, N * N);
+	for (int i = 0; i < N; i++) {
+		for (int j = 0; j < N; j++) {
+			SetGeneratedElement(problem, i, i * N + j, Fraction(1, 1));
+			if (j < N - 1) {
+				SetGeneratedElement(problem, N + j, i * N + j, Fraction(1, 1));
+			}
+			SetGeneratedCost(problem, i * N + j, Fraction(Cost(Random), 1));
+		}
+		SetGeneratedElement(problem, i, N * N, Fraction(Supply[i], 1));
+	}
+	for (int j = 0; j < N - 1; j++) {
+		SetGeneratedElement(problem, N + j, N * N, Fraction(Demand[j], 1));
+	}
+}
+
+// Power of ten as a fraction, negative powers go to the denominator
+static Fraction PowerOfTen(int Power) {
+	int Value = 1;
+	for (int k = 0; k < abs(Power); k++) {
+		Value *= 10;
+	}
+	return Power < 0 ? Fraction(1, Value) : Fraction(Value, 1);
+}
+
+// Problem of GenerateProblem with rows and columns multiplied by powers of ten from 10^-3 to 10^3.
+// Optimum of the target function stays the same, only its point is scaled
+static void GenerateScaledProblem(int NumberOfLimitations, int NumberOfVariables, unsigned Seed, Problem& problem) {
+	GenerateProblem(NumberOfLimitations, NumberOfVariables, Seed, problem);
+	std::mt19937 Random(Seed + 1);
+	std::uniform_int_distribution<int> Power(-3, 3);
+
+	std::vector<Fraction> RowScales(NumberOfLimitations);
+	for (Fraction& Scale : RowScales) {
+		Scale = PowerOfTen(Power(Random));
+	}
+	for (int j = 0; j <= NumberOfVariables; j++) {
+		Fraction ColumnScale = j < NumberOfVariables ? PowerOfTen(Power(Random)) : Fraction(1, 1);
+		for (int i = 0; i < NumberOfLimitations; i++) {
+			SetGeneratedElement(problem, i, j, problem.FracMatrix[i][j] * RowScales[i] * ColumnScale);
+		}
+		SetGeneratedCost(problem, j, problem.FractionalTargetFunction[j] * ColumnScale);
+	}
+}
+
+// Blocks of GenerateProblem on the diagonal, limitations of different blocks share no variables
+static void GenerateSeparableProblem(int Blocks, int NumberOfLimitations, int NumberOfVariables, unsigned Seed, Problem& problem) {
+	problem.Resize(Blocks * NumberOfLimitations, Blocks * NumberOfVariables);
+	Problem Block;
+	for (int k = 0; k < Blocks; k++) {
+		GenerateProblem(NumberOfLimitations, NumberOfVariables, Seed + k, Block);
+		int Row = k * NumberOfLimitations;
+		int Column = k * NumberOfVariables;
+		for (int i = 0; i < NumberOfLimitations; i++) {
+			for (int j = 0; j < NumberOfVariables; j++) {
+				SetGeneratedElement(problem, Row + i, Column + j, Block.FracMatrix[i][j]);
+			}
+			SetGeneratedElement(problem, Row + i, Blocks * NumberOfVariables, Block.FracMatrix[i][NumberOfVariables]);
+		}
+		for (int j = 0; j < NumberOfVariables; j++) {
+			SetGeneratedCost(problem, Column + j, Block.FractionalTargetFunction[j]);
+		}
+	}
+}
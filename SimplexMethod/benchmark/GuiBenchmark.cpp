@@ -0,0 +1,252 @@
+// Benchmark of the user interface without a display.
+// GLFW is built for its null platform (_GLFW_OSMESA), window has no client API and nothing is rendered:
+// frames are built by ImGui the same way the application builds them and only the CPU cost is measured.
+// Heatmap overview needs OpenGL, so it's turned off and big tables are drawn as cells.
+//
+// Usage: GuiBenchmark [--frames N] [--steps N] [--fractions] [--seed N] MxN...
+//   MxN  size of a generated problem: M limitations and N variables (default 50x100 200x400)
+#include <imgui/imgui.h>
+#include <imgui/imgui_impl_glfw.h>
+
+#include <glad/glad.h>
+#include <stdio.h>
+
+#include <GLFW/glfw3.h>
+
+#include <vector>
+#include <string>
+#include <type_traits>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <new>
+#include <thread>
+#include <future>
+#include <map>
+#include <functional>
+#include <random>
+#include <cstdint>
+#include <cerrno>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+
+#include "tinyfiledialogs.h"
+#include "Common.h"
+#include "Profiler.h"
+#include "Simplex.h"
+#include "NumberParser.h"
+#include "MpsFile.h"
+#include "LpFile.h"
+#include "ProblemFile.h"
+#include "CsvFile.h"
+#include "Snapshot.h"
+#include "StepTrace.h"
+#include "BackgroundSolver.h"
+#include "Heatmap.h"
+#include "GUILayer.h"
+#include "GeneratedProblems.h"
+
+struct BenchmarkOptions {
+	int Frames = 300;
+	int Steps = 100;
+	bool IsFractionalCoefficients = false;
+	unsigned Seed = 1;
+};
+
+struct FrameStatistics {
+	std::vector<double> Milliseconds;
+	double Vertices = 0;
+	double Indices = 0;
+	double Commands = 0;
+};
+
+// Steps of the artificial basis method as the solution window keeps them
+template<typename MatrixType, typename ElementType> void MakeSteps(Problem& problem, int MaxSteps, std::vector<Step>& Steps) {
+	Step step = MakeArtificialBasisStep<MatrixType>(problem);
+	int OriginalColNumber = StepMatrix<MatrixType>(step).ColNumber;
+	Steps.push_back(step);
+	while (!step.IsCompleted && Steps.size() < MaxSteps) {
+		Step NewStep = SimplexStep<MatrixType, ElementType>(step);
+		if (NewStep.IsCompleted) {
+			break;
+		}
+		CompleteArtificialStep<MatrixType>(NewStep, OriginalColNumber);
+		Steps.push_back(NewStep);
+		step = NewStep;
+	}
+}
+
+// Builds one frame and measures it. Draw function is called inside a window that covers the display
+template<typename Proc> void MeasureFrame(FrameStatistics& Statistics, Proc DrawFunction) {
+	glfwPollEvents();
+	auto Start = std::chrono::steady_clock::now();
+
+	ImGui_ImplGlfw_NewFrame();
+	ImGui::NewFrame();
+	ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+	ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+	ImGui::Begin("Benchmark", NULL, ImGuiWindowFlags_NoDecoration);
+	DrawFunction();
+	ImGui::End();
+	ImGui::Render();
+
+	Statistics.Milliseconds.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count());
+	ImDrawData* DrawData = ImGui::GetDrawData();
+	Statistics.Vertices += DrawData->TotalVtxCount;
+	Statistics.Indices += DrawData->TotalIdxCount;
+	for (int i = 0; i < DrawData->CmdListsCount; i++) {
+		Statistics.Commands += DrawData->CmdLists[i]->CmdBuffer.Size;
+	}
+}
+
+static void PrintStatistics(const char* Problem, const char* Scenario, FrameStatistics& Statistics) {
+	std::vector<double> Sorted = Statistics.Milliseconds;
+	std::sort(Sorted.begin(), Sorted.end());
+	double Sum = 0.0;
+	for (double Value : Sorted) {
+		Sum += Value;
+	}
+	int Frames = Sorted.size();
+	printf("%-10s %-10s %8d %10.3f %10.3f %10.3f %10.3f %10.0f %10.0f %8.0f\n", Problem, Scenario, Frames,
+		Sum / Frames, Sorted[Frames / 2], Sorted[std::min(Frames - 1, Frames * 95 / 100)], Sorted.back(),
+		Statistics.Vertices / Frames, Statistics.Indices / Frames, Statistics.Commands / Frames);
+}
+
+template<typename MatrixType, typename ElementType> void RunScenarios(const char* Name, Problem& problem, const BenchmarkOptions& Options) {
+	std::vector<Step> Steps;
+	MakeSteps<MatrixType, ElementType>(problem, Options.Steps, Steps);
+	MatrixType& Input = StepMatrix<MatrixType>(Steps[0]);
+
+	// Table of steps scrolled through the whole history
+	FrameStatistics StepsStatistics;
+	for (int Frame = 0; Frame < Options.Frames; Frame++) {
+		MeasureFrame(StepsStatistics, [&]() {
+			ImGui::SetNextWindowContentSize(ImVec2(GUILayer::StepsContentWidth(Steps, Options.IsFractionalCoefficients), 0.0f));
+			ImGui::BeginChild("Steps", ImVec2(0.0f, 0.0f), true, ImGuiWindowFlags_HorizontalScrollbar);
+			ImGui::SetScrollY(ImGui::GetScrollMaxY() * Frame / std::max(1, Options.Frames - 1));
+			GUILayer::DisplaySteps(Steps, 1, Options.IsFractionalCoefficients);
+			ImGui::EndChild();
+		});
+	}
+	PrintStatistics(Name, "steps", StepsStatistics);
+
+	// Input of the matrix of limitations scrolled from the top left to the bottom right corner
+	FrameStatistics InputStatistics;
+	for (int Frame = 0; Frame < Options.Frames; Frame++) {
+		MeasureFrame(InputStatistics, [&]() {
+			ImVec2 ContentSize = GUILayer::MatrixInputContentSize(Input);
+			ImGui::SetNextWindowContentSize(ContentSize);
+			ImGui::BeginChild("Matrix Of Limitations", ImVec2(0.0f, 0.0f), false, ImGuiWindowFlags_HorizontalScrollbar);
+			float Position = (float)Frame / std::max(1, Options.Frames - 1);
+			ImGui::SetScrollX(ImGui::GetScrollMaxX() * Position);
+			ImGui::SetScrollY(ImGui::GetScrollMaxY() * Position);
+			GUILayer::MatrixInput(Input);
+			ImGui::EndChild();
+		});
+	}
+	PrintStatistics(Name, "input", InputStatistics);
+
+	// Solution tabs: steps of the method and vector of the solution.
+	// Like the application, the last step is copied and sorted by basis variables every frame
+	FrameStatistics SolutionStatistics;
+	for (int Frame = 0; Frame < Options.Frames; Frame++) {
+		MeasureFrame(SolutionStatistics, [&]() {
+			if (ImGui::BeginTabBar("Solution Tabs")) {
+				if (ImGui::BeginTabItem("Artificial Basis")) {
+					ImGui::SetNextWindowContentSize(ImVec2(GUILayer::StepsContentWidth(Steps, Options.IsFractionalCoefficients), 0.0f));
+					ImGui::BeginChild("Matrix Of Limitations", ImVec2(0.0f, ImGui::GetWindowHeight() * 0.7f), true, ImGuiWindowFlags_HorizontalScrollbar);
+					GUILayer::DisplaySteps(Steps, 1, Options.IsFractionalCoefficients);
+					ImGui::EndChild();
+
+					Step LastStep = Steps.back();
+					MatrixType& LastMatrix = StepMatrix<MatrixType>(LastStep);
+					std::vector<int> BaseVariables(LastStep.NumbersOfVariables.begin(), LastStep.NumbersOfVariables.begin() + (LastMatrix.RowNumber - 1));
+					ImGui::BeginChild("Solution", ImVec2(0.0f, 0.0f), true);
+					BubbleSort(LastMatrix, BaseVariables, true);
+					GUILayer::DisplaySolutionVector(LastMatrix, BaseVariables, LastStep.NumbersOfVariables.size(), false);
+					ImGui::EndChild();
+					ImGui::EndTabItem();
+				}
+				ImGui::EndTabBar();
+			}
+		});
+	}
+	PrintStatistics(Name, "solution", SolutionStatistics);
+}
+
+int main(int argc, char** argv) {
+	BenchmarkOptions Options;
+	std::vector<std::pair<int, int>> Sizes;
+	for (int i = 1; i < argc; i++) {
+		bool HasValue = i + 1 < argc;
+		int NumberOfLimitations, NumberOfVariables;
+		if (strcmp(argv[i], "--frames") == 0 && HasValue) {
+			Options.Frames = std::max(1, atoi(argv[++i]));
+		} else if (strcmp(argv[i], "--steps") == 0 && HasValue) {
+			Options.Steps = std::max(2, atoi(argv[++i]));
+		} else if (strcmp(argv[i], "--seed") == 0 && HasValue) {
+			Options.Seed = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--fractions") == 0) {
+			Options.IsFractionalCoefficients = true;
+		} else if (sscanf(argv[i], "%dx%d", &NumberOfLimitations, &NumberOfVariables) == 2 && NumberOfLimitations > 0 && NumberOfLimitations <= NumberOfVariables) {
+			Sizes.push_back(std::make_pair(NumberOfLimitations, NumberOfVariables));
+		} else {
+			printf("Usage: GuiBenchmark [--frames N] [--steps N] [--fractions] [--seed N] MxN...\n");
+			return 1;
+		}
+	}
+	if (Sizes.empty()) {
+		Sizes.push_back(std::make_pair(50, 100));
+		Sizes.push_back(std::make_pair(200, 400));
+	}
+
+	if (!glfwInit()) {
+		printf("Failed to initialize GLFW\n");
+		return 1;
+	}
+	glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	GLFWwindow* window = glfwCreateWindow(1600, 900, "GuiBenchmark", NULL, NULL);
+	if (!window) {
+		printf("Failed to create window\n");
+		return 1;
+	}
+
+	IMGUI_CHECKVERSION();
+	ImGui::CreateContext();
+	ImGuiIO& io = ImGui::GetIO();
+	io.IniFilename = NULL;
+	ImGui::StyleColorsLight();
+	ImGui_ImplGlfw_InitForOpenGL(window, false);
+
+	// There's no renderer to build the font atlas
+	unsigned char* Pixels;
+	int Width, Height;
+	io.Fonts->GetTexDataAsRGBA32(&Pixels, &Width, &Height);
+	GUILayer::IsOverviewEnabled = false;
+
+	printf("%-10s %-10s %8s %10s %10s %10s %10s %10s %10s %8s\n", "problem", "scenario", "frames", "mean, ms", "p50, ms", "p95, ms", "max, ms", "vertices", "indices", "cmds");
+	for (std::pair<int, int> Size : Sizes) {
+		Problem problem;
+		problem.IsFractionalCoefficients = Options.IsFractionalCoefficients;
+		GenerateProblem(Size.first, Size.second, Options.Seed, problem);
+
+		char Name[32];
+		snprintf(Name, sizeof(Name), "%dx%d", Size.first, Size.second);
+		if (Options.IsFractionalCoefficients) {
+			RunScenarios<FractionalMatrix, Fraction>(Name, problem, Options);
+		} else {
+			RunScenarios<Matrix, float>(Name, problem, Options);
+		}
+	}
+
+	ImGui_ImplGlfw_Shutdown();
+	ImGui::DestroyContext();
+	glfwDestroyWindow(window);
+	glfwTerminate();
+	return 0;
+}
@@ -0,0 +1,335 @@
+// Microbenchmarks of the primitives of Common.h that every pivot uses: operators of Fraction, gcd and NormalizeFraction,
+// DeleteColumn, SwapRows, SwapColumns and BubbleSort of both types of matrices.
+// Every benchmark is measured in several rounds, a round repeats operations until it takes the minimal time.
+// The median of the rounds is printed with the fastest round and allocations per operation.
+//
+// Operands of fractions come from distributions:
+//   integer        integers from -50 to 50
+//   small          numerators from -50 to 50 and denominators from 1 to 12, as in first steps of a solution
+//   large          numerators and denominators up to 2000
+//   near-overflow  numerators and denominators up to 30000, their products take up to 84% of int
+//
+// Usage: PrimitivesBenchmark [--filter text] [--rounds N] [--min-time MS] [--matrices list] [--label text] [--json file]
+//   --filter text    only benchmarks whose names contain the text
+//   --rounds N       rounds of every benchmark (default 5)
+//   --min-time MS    minimal time of a round (default 50)
+//   --matrices list  tables MxN separated by commas: M limitations and N variables (default 50x100,200x400)
+#include <stdio.h>
+
+#include <vector>
+#include <string>
+#include <type_traits>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <random>
+#include <cstdint>
+#include <cerrno>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+
+#include "Common.h"
+#include "AllocationCounter.h"
+#include "BenchmarkJson.h"
+
+struct BenchmarkOptions {
+	const char* Filter = "";
+	int Rounds = 5;
+	double MinimalMilliseconds = 50.0;
+	std::vector<std::pair<int, int>> Matrices;
+	const char* Label = "";
+	const char* JsonFileName = NULL;
+};
+
+struct MicroResult {
+	std::string Name;
+	std::string Values;
+	long long Operations = 0;
+	double MedianNanoseconds = 0.0;
+	double BestNanoseconds = 0.0;
+	double AllocationsPerOperation = 0.0;
+};
+
+// Results of operations are added here, so the compiler can't throw them away
+static volatile unsigned Sink;
+
+// Measures Run(Index) that makes one operation. Prepare(Count) is called before every batch of Count operations
+// out of the measured time, it makes copies for operations that change their operands
+template<typename PrepareProc, typename RunProc> void Measure(const BenchmarkOptions& Options, const char* Name, const char* Values, int BatchSize,
+		PrepareProc Prepare, RunProc Run, std::vector<MicroResult>& Results) {
+	std::string FullName = std::string(Name) + " " + Values;
+	if (!strstr(FullName.c_str(), Options.Filter)) {
+		return;
+	}
+	MicroResult Result;
+	Result.Name = Name;
+	Result.Values = Values;
+	std::vector<double> RoundNanoseconds;
+	long long Allocations = 0;
+	for (int Round = 0; Round < Options.Rounds; Round++) {
+		double Nanoseconds = 0.0;
+		long long Operations = 0;
+		while (Nanoseconds < Options.MinimalMilliseconds * 1e6) {
+			Prepare(BatchSize);
+			long long AllocationsBefore = Allocated.Allocations.load();
+			auto Start = std::chrono::steady_clock::now();
+			unsigned Accumulator = 0;
+			for (int i = 0; i < BatchSize; i++) {
+				Accumulator += Run(i);
+			}
+			Nanoseconds += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - Start).count();
+			Allocations += Allocated.Allocations.load() - AllocationsBefore;
+			Sink = Sink + Accumulator;
+			Operations += BatchSize;
+		}
+		RoundNanoseconds.push_back(Nanoseconds / Operations);
+		Result.Operations += Operations;
+	}
+	std::sort(RoundNanoseconds.begin(), RoundNanoseconds.end());
+	Result.MedianNanoseconds = RoundNanoseconds[RoundNanoseconds.size() / 2];
+	Result.BestNanoseconds = RoundNanoseconds[0];
+	Result.AllocationsPerOperation = (double)Allocations / Result.Operations;
+	printf("%-20s %-18s %14.2f %14.2f %12.3f %14lld\n", Result.Name.c_str(), Result.Values.c_str(), Result.MedianNanoseconds,
+		Result.BestNanoseconds, Result.AllocationsPerOperation, Result.Operations);
+	Results.push_back(Result);
+}
+
+const int OperandCount = 4096;
+
+struct FractionDistribution {
+	const char* Name;
+	int MaxNumerator;
+	int MaxDenominator;
+};
+
+// Operands are normalized as the solver keeps them
+static std::vector<Fraction> MakeFractions(const FractionDistribution& Distribution, unsigned Seed) {
+	std::mt19937 Random(Seed);
+	std::uniform_int_distribution<int> Numerator(-Distribution.MaxNumerator, Distribution.MaxNumerator);
+	std::uniform_int_distribution<int> Denominator(1, Distribution.MaxDenominator);
+	std::vector<Fraction> Fractions(OperandCount);
+	for (Fraction& Value : Fractions) {
+		Value = Fraction(Numerator(Random), Denominator(Random));
+		Value.NormalizeFraction();
+	}
+	return Fractions;
+}
+
+static void MeasureFractions(const BenchmarkOptions& Options, std::vector<MicroResult>& Results) {
+	const FractionDistribution Distributions[] = {
+		{ "integer", 50, 1 },
+		{ "small", 50, 12 },
+		{ "large", 2000, 2000 },
+		{ "near-overflow", 30000, 30000 },
+	};
+	auto NoPreparation = [](int) {};
+	const int Mask = OperandCount - 1;
+	for (const FractionDistribution& Distribution : Distributions) {
+		std::vector<Fraction> A = MakeFractions(Distribution, 1);
+		std::vector<Fraction> B = MakeFractions(Distribution, 2);
+		// Divisor is never zero, as in pivots
+		for (Fraction& Value : B) {
+			if (Value.numerator == 0) {
+				Value = Fraction(1, 1);
+			}
+		}
+		// Products before the normalization, the solver normalizes such values after every operator
+		std::vector<Fraction> Unnormalized(OperandCount);
+		for (int i = 0; i < OperandCount; i++) {
+			Unnormalized[i] = Fraction(A[i].numerator * B[i].denominator, A[i].denominator * B[i].denominator);
+		}
+		const int BatchSize = 1 << 16;
+		const char* Values = Distribution.Name;
+
+		Measure(Options, "fraction +", Values, BatchSize, NoPreparation, [&](int i) { return (A[i & Mask] + B[i & Mask]).numerator; }, Results);
+		Measure(Options, "fraction -", Values, BatchSize, NoPreparation, [&](int i) { return (A[i & Mask] - B[i & Mask]).numerator; }, Results);
+		Measure(Options, "fraction *", Values, BatchSize, NoPreparation, [&](int i) { return (A[i & Mask] * B[i & Mask]).numerator; }, Results);
+		Measure(Options, "fraction /", Values, BatchSize, NoPreparation, [&](int i) { return (A[i & Mask] / B[i & Mask]).numerator; }, Results);
+		Measure(Options, "fraction +=", Values, BatchSize, NoPreparation, [&](int i) {
+			Fraction Value = A[i & Mask];
+			Value += B[i & Mask];
+			return Value.numerator;
+		}, Results);
+		Measure(Options, "fraction <", Values, BatchSize, NoPreparation, [&](int i) { return (int)(A[i & Mask] < B[i & Mask]); }, Results);
+		Measure(Options, "fraction ==", Values, BatchSize, NoPreparation, [&](int i) {
+			Fraction Value = A[i & Mask];
+			return (int)(Value == B[i & Mask]);
+		}, Results);
+		Measure(Options, "gcd", Values, BatchSize, NoPreparation, [&](int i) {
+			return gcd(Unnormalized[i & Mask].numerator, Unnormalized[i & Mask].denominator);
+		}, Results);
+		Measure(Options, "NormalizeFraction", Values, BatchSize, NoPreparation, [&](int i) {
+			Fraction Value = Unnormalized[i & Mask];
+			Value.NormalizeFraction();
+			return Value.numerator;
+		}, Results);
+	}
+}
+
+static void FillMatrix(Matrix& matrix, std::mt19937& Random) {
+	std::uniform_int_distribution<int> Value(-50, 50);
+	for (int i = 0; i < matrix.RowNumber * matrix.ColNumber; i++) {
+		matrix.matrix[i] = (float)Value(Random);
+	}
+}
+
+static void FillMatrix(FractionalMatrix& matrix, std::mt19937& Random) {
+	std::vector<Fraction> Values = MakeFractions({ "small", 50, 12 }, Random());
+	for (int i = 0; i < matrix.RowNumber * matrix.ColNumber; i++) {
+		matrix.matrix[i] = Values[i % OperandCount];
+	}
+}
+
+// Table of the simplex method of a problem with M limitations and N variables
+template<typename MatrixType> void MeasureMatrix(const BenchmarkOptions& Options, const char* TypeName, int M, int N, std::vector<MicroResult>& Results) {
+	std::mt19937 Random(3);
+	MatrixType Original(M + 1, N + 1);
+	FillMatrix(Original, Random);
+	char Values[32];
+	snprintf(Values, sizeof(Values), "%s %dx%d", TypeName, M, N);
+	auto NoPreparation = [](int) {};
+
+	// Pairs of rows and columns without the last ones, the operations don't swap them
+	std::vector<std::pair<int, int>> Rows(OperandCount);
+	std::vector<std::pair<int, int>> Columns(OperandCount);
+	std::uniform_int_distribution<int> Row(0, M - 1);
+	std::uniform_int_distribution<int> Column(0, N - 1);
+	for (int i = 0; i < OperandCount; i++) {
+		Rows[i] = std::make_pair(Row(Random), Row(Random));
+		Columns[i] = std::make_pair(Column(Random), Column(Random));
+	}
+	const int Mask = OperandCount - 1;
+	MatrixType matrix = Original;
+	Measure(Options, "SwapRows", Values, 256, NoPreparation, [&](int i) {
+		matrix.SwapRows(Rows[i & Mask].first, Rows[i & Mask].second);
+		return 0;
+	}, Results);
+	Measure(Options, "SwapColumns", Values, 256, NoPreparation, [&](int i) {
+		matrix.SwapColumns(Columns[i & Mask].first, Columns[i & Mask].second);
+		return 0;
+	}, Results);
+
+	// Operations that change the size or the order work on copies made before a batch
+	const int CopiesInBatch = 16;
+	std::vector<MatrixType> Copies(CopiesInBatch);
+	auto MakeCopies = [&](int Count) {
+		for (int i = 0; i < Count; i++) {
+			Copies[i] = Original;
+		}
+	};
+	Measure(Options, "DeleteColumn", Values, CopiesInBatch, MakeCopies, [&](int i) {
+		Copies[i].DeleteColumn(Columns[i].first);
+		return Copies[i].ColNumber;
+	}, Results);
+
+	// Basis variables of the last step in random order, as after pivots
+	std::vector<std::vector<int>> Bases(CopiesInBatch);
+	std::vector<int> Basis(M);
+	for (int i = 0; i < M; i++) {
+		Basis[i] = N + 1 + i;
+	}
+	Measure(Options, "BubbleSort", Values, CopiesInBatch, [&](int Count) {
+		MakeCopies(Count);
+		for (int i = 0; i < Count; i++) {
+			std::shuffle(Basis.begin(), Basis.end(), Random);
+			Bases[i] = Basis;
+		}
+	}, [&](int i) {
+		BubbleSort(Copies[i], Bases[i], true);
+		return Bases[i][0];
+	}, Results);
+}
+
+static const char* WriteJson(const char* FileName, const BenchmarkOptions& Options, const std::vector<MicroResult>& Results) {
+	FILE* File = fopen(FileName, "wb");
+	if (!File) {
+		return strerror(errno);
+	}
+	fprintf(File, "{\n  \"label\": ");
+	WriteJsonString(File, Options.Label);
+	fprintf(File, ",\n  \"rounds\": %d,\n  \"min_time_ms\": ", Options.Rounds);
+	WriteJsonNumber(File, Options.MinimalMilliseconds);
+	fprintf(File, ",\n  \"results\": [");
+	for (size_t i = 0; i < Results.size(); i++) {
+		const MicroResult& Result = Results[i];
+		fprintf(File, "%s\n    {\"name\": ", i == 0 ? "" : ",");
+		WriteJsonString(File, Result.Name.c_str());
+		fprintf(File, ", \"values\": ");
+		WriteJsonString(File, Result.Values.c_str());
+		fprintf(File, ", \"operations\": %lld, \"median_ns_per_op\": ", Result.Operations);
+		WriteJsonNumber(File, Result.MedianNanoseconds);
+		fprintf(File, ", \"best_ns_per_op\": ");
+		WriteJsonNumber(File, Result.BestNanoseconds);
+		fprintf(File, ", \"allocations_per_op\": ");
+		WriteJsonNumber(File, Result.AllocationsPerOperation);
+		fprintf(File, "}");
+	}
+	fprintf(File, "\n  ]\n}\n");
+	bool IsWritten = !ferror(File);
+	return fclose(File) == 0 && IsWritten ? NULL : "Failed to write the file";
+}
+
+static bool ParseMatrices(const char* Text, std::vector<std::pair<int, int>>& Matrices) {
+	Matrices.clear();
+	while (*Text) {
+		int M, N, Length = 0;
+		if (sscanf(Text, "%dx%d%n", &M, &N, &Length) != 2 || M < 2 || N < 2 || M > 5000 || N > 5000) {
+			return false;
+		}
+		Text += Length;
+		if (*Text != ',' && *Text != '\0') {
+			return false;
+		}
+		Matrices.push_back(std::make_pair(M, N));
+		Text += *Text ? 1 : 0;
+	}
+	return !Matrices.empty();
+}
+
+int main(int argc, char** argv) {
+	BenchmarkOptions Options;
+	Options.Matrices = { { 50, 100 }, { 200, 400 } };
+	for (int i = 1; i < argc; i++) {
+		bool HasValue = i + 1 < argc;
+		bool IsCorrect = HasValue;
+		if (strcmp(argv[i], "--filter") == 0 && HasValue) {
+			Options.Filter = argv[++i];
+		} else if (strcmp(argv[i], "--rounds") == 0 && HasValue) {
+			Options.Rounds = std::max(1, atoi(argv[++i]));
+		} else if (strcmp(argv[i], "--min-time") == 0 && HasValue) {
+			Options.MinimalMilliseconds = std::max(0.0, atof(argv[++i]));
+		} else if (strcmp(argv[i], "--matrices") == 0 && HasValue) {
+			IsCorrect = ParseMatrices(argv[++i], Options.Matrices);
+		} else if (strcmp(argv[i], "--label") == 0 && HasValue) {
+			Options.Label = argv[++i];
+		} else if (strcmp(argv[i], "--json") == 0 && HasValue) {
+			Options.JsonFileName = argv[++i];
+		} else {
+			IsCorrect = false;
+		}
+		if (!IsCorrect) {
+			printf("Usage: PrimitivesBenchmark [--filter text] [--rounds N] [--min-time MS] [--matrices list] [--label text] [--json file]\n");
+			return 1;
+		}
+	}
+
+	printf("%-20s %-18s %14s %14s %12s %14s\n", "benchmark", "values", "median, ns/op", "best, ns/op", "allocs/op", "operations");
+	std::vector<MicroResult> Results;
+	MeasureFractions(Options, Results);
+	for (std::pair<int, int> Size : Options.Matrices) {
+		MeasureMatrix<Matrix>(Options, "float", Size.first, Size.second, Results);
+		MeasureMatrix<FractionalMatrix>(Options, "fraction", Size.first, Size.second, Results);
+	}
+
+	if (Options.JsonFileName) {
+		if (const char* Error = WriteJson(Options.JsonFileName, Options, Results)) {
+			printf("Failed to write %s: %s\n", Options.JsonFileName, Error);
+			return 1;
+		}
+	}
+	return 0;
+}
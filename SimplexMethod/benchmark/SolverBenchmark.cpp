@@ -0,0 +1,407 @@
+// Benchmark of the solver without the interface.
+// Families of generated problems are solved automatically by every engine for growing sizes. Every problem is solved
+// several times, the best and the mean times are printed with pivots per second, peak memory of the heap during
+// a solution and how far the objective is from the one of exact fractions (or of real numbers if fractions failed).
+// Results can be written as JSON to compare them between versions.
+//
+// Usage: SolverBenchmark [options]
+//   --families list  families separated by commas (default all):
+//                    dense, sparse       N limitations and 2N variables with a known admissible point
+//                    klee-minty          Klee-Minty cube of dimension N
+//                    assignment          assignment of N workers to N jobs, 2N-1 limitations and N^2 variables
+//                    transportation      balanced transportation from N suppliers to N consumers
+//                    scaled              dense problem with rows and columns scaled by 10^-3..10^3
+//                    separable           four independent dense blocks, N limitations in all
+//   --engines list   float, fraction, blocks (float solved block by block on all cores), default all
+//   --sizes list     values of N (default 4,8,16,32,64)
+//   --repeat N       solutions of every problem (default 3)
+//   --seed N         seed of the generated problems (default 1)
+//   --max-pivots N   limit of pivots of every method (default 100000)
+//   --time-limit MS  bigger problems of a family aren't solved by an engine after a solution slower than this (default 5000)
+//   --label text     name of the version that is written into JSON
+//   --json file      write results as JSON
+// Fractions overflow int on big problems. Outside of Windows every engine solves in its own process,
+// so such a crash becomes a result too
+#include <stdio.h>
+
+#include <vector>
+#include <string>
+#include <type_traits>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <new>
+#include <thread>
+#include <functional>
+#include <random>
+#include <cstdint>
+#include <cerrno>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include "windows.h" // For mapped files
+#else
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+#include "Common.h"
+#include "Profiler.h"
+#include "Simplex.h"
+#include "Decomposition.h"
+#include "NumberParser.h"
+#include "MpsFile.h"
+#include "LpFile.h"
+#include "ProblemFile.h"
+#include "CsvFile.h"
+#include "Snapshot.h"
+#include "StepTrace.h"
+#include "GeneratedProblems.h"
+#include "AllocationCounter.h"
+#include "BenchmarkJson.h"
+
+const char* FamilyNames[] = { "dense", "sparse", "klee-minty", "assignment", "transportation", "scaled", "separable" };
+const int NumberOfFamilies = sizeof(FamilyNames) / sizeof(FamilyNames[0]);
+
+enum Engine {
+	ENGINE_FLOAT,
+	ENGINE_FRACTION,
+	ENGINE_BLOCKS,
+	NUMBER_OF_ENGINES,
+};
+
+const char* EngineNames[NUMBER_OF_ENGINES] = { "float", "fraction", "blocks" };
+
+struct BenchmarkOptions {
+	std::vector<int> Families;
+	std::vector<int> Engines;
+	std::vector<int> Sizes;
+	int Repeat = 3;
+	unsigned Seed = 1;
+	int MaxPivots = 100000;
+	double TimeLimit = 5000.0;
+	const char* Label = "";
+	const char* JsonFileName = NULL;
+};
+
+// Result of one engine on one problem. It's plain data, so a solving process sends it as it is
+struct EngineResult {
+	int Family;
+	int Size;
+	int NumberOfLimitations;
+	int NumberOfVariables;
+	int Engine;
+	bool IsSkipped;
+	AlgorithmState State;
+	int ArtificialPivots;
+	int SimplexPivots;
+	int Runs;
+	double BestMilliseconds;
+	double MeanMilliseconds;
+	long long PeakBytes;
+	long long Allocations;
+	double Objective;
+	// Relative difference from the reference objective, negative if there's nothing to compare with
+	double ObjectiveDifference;
+	char Error[64];
+};
+
+static void GenerateFamilyProblem(int Family, int N, unsigned Seed, Problem& problem) {
+	switch (Family) {
+	case 0: GenerateProblem(N, 2 * N, Seed, problem); break;
+	case 1: GenerateSparseProblem(N, 2 * N, Seed, problem); break;
+	case 2: GenerateKleeMintyProblem(N, problem); break;
+	case 3: GenerateAssignmentProblem(N, Seed, problem); break;
+	case 4: GenerateTransportationProblem(N, Seed, problem); break;
+	case 5: GenerateScaledProblem(N, 2 * N, Seed, problem); break;
+	default: GenerateSeparableProblem(4, std::max(1, N / 4), std::max(1, N / 2), Seed, problem); break;
+	}
+}
+
+// Solves the problem Repeat times or until a solution is slower than the time limit
+static void SolveWithEngine(Problem& problem, const BenchmarkOptions& Options, EngineResult& Result) {
+	problem.IsFractionalCoefficients = Result.Engine == ENGINE_FRACTION;
+	int Threads = std::max(1, (int)std::thread::hardware_concurrency());
+	double Sum = 0.0;
+	Result.BestMilliseconds = DBL_MAX;
+	for (Result.Runs = 0; Result.Runs < Options.Repeat;) {
+		ResetPeakBytes();
+		long long PeakBefore = Allocated.PeakBytes.load();
+		long long AllocationsBefore = Allocated.Allocations.load();
+		auto Start = std::chrono::steady_clock::now();
+		Solution solution = Result.Engine == ENGINE_BLOCKS ? SolveSeparable(problem, Options.MaxPivots, Threads) : SolveProblem(problem, Options.MaxPivots);
+		double Milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+
+		Result.PeakBytes = Allocated.PeakBytes.load() - PeakBefore;
+		Result.Allocations = Allocated.Allocations.load() - AllocationsBefore;
+		Result.State = solution.State;
+		Result.ArtificialPivots = solution.ArtificialPivots;
+		Result.SimplexPivots = solution.SimplexPivots;
+		Result.Objective = solution.Objective;
+		Result.BestMilliseconds = std::min(Result.BestMilliseconds, Milliseconds);
+		Sum += Milliseconds;
+		Result.Runs += 1;
+		if (Milliseconds > Options.TimeLimit) {
+			break;
+		}
+	}
+	Result.MeanMilliseconds = Sum / Result.Runs;
+}
+
+#ifndef _WIN32
+// Solves in a child process, so overflow of fractions that kills it doesn't end the benchmark
+static void SolveInProcess(Problem& problem, const BenchmarkOptions& Options, EngineResult& Result) {
+	int Pipe[2];
+	if (pipe(Pipe) != 0) {
+		SolveWithEngine(problem, Options, Result);
+		return;
+	}
+	fflush(stdout);
+	pid_t Pid = fork();
+	if (Pid == 0) {
+		close(Pipe[0]);
+		SolveWithEngine(problem, Options, Result);
+		ssize_t Written = write(Pipe[1], &Result, sizeof(Result));
+		_exit(Written == sizeof(Result) ? 0 : 1);
+	}
+	close(Pipe[1]);
+	EngineResult Received;
+	size_t Size = 0;
+	while (Pid > 0 && Size < sizeof(Received)) {
+		ssize_t Read = read(Pipe[0], (char*)&Received + Size, sizeof(Received) - Size);
+		if (Read < 0 && errno == EINTR) {
+			continue;
+		}
+		if (Read <= 0) {
+			break;
+		}
+		Size += Read;
+	}
+	close(Pipe[0]);
+
+	int WaitStatus = 0;
+	if (Pid > 0) {
+		waitpid(Pid, &WaitStatus, 0);
+	}
+	if (Pid > 0 && Size == sizeof(Received)) {
+		Result = Received;
+	} else {
+		const char* Error = Pid < 0 ? "Process wasn't created" : WIFSIGNALED(WaitStatus) ? strsignal(WTERMSIG(WaitStatus)) : "Process exited";
+		snprintf(Result.Error, sizeof(Result.Error), "%s", Error);
+	}
+}
+#endif
+
+// Exact fractions are the reference, real numbers are when fractions failed
+static void CompareObjectives(EngineResult* Results, int Count) {
+	const EngineResult* Reference = NULL;
+	for (int i = 0; i < Count; i++) {
+		bool IsUsable = !Results[i].IsSkipped && !Results[i].Error[0] && Results[i].State == COMPLETED;
+		if (IsUsable && (!Reference || Results[i].Engine == ENGINE_FRACTION)) {
+			Reference = &Results[i];
+		}
+	}
+	for (int i = 0; i < Count; i++) {
+		EngineResult& Result = Results[i];
+		Result.ObjectiveDifference = -1.0;
+		if (Reference && !Result.IsSkipped && !Result.Error[0] && Result.State == COMPLETED) {
+			Result.ObjectiveDifference = fabs(Result.Objective - Reference->Objective) / std::max(1.0, fabs(Reference->Objective));
+		}
+	}
+}
+
+static const char* ResultState(const EngineResult& Result) {
+	const char* StateNames[] = { "undefined", "completed", "unlimited", "stopped", "no solution" };
+	if (Result.IsSkipped) {
+		return "skipped";
+	}
+	return Result.Error[0] ? "failed" : StateNames[Result.State];
+}
+
+static double PivotsPerSecond(const EngineResult& Result) {
+	int Pivots = Result.ArtificialPivots + Result.SimplexPivots;
+	return Result.BestMilliseconds > 0.0 ? Pivots / (Result.BestMilliseconds / 1000.0) : 0.0;
+}
+
+static void PrintResult(const EngineResult& Result) {
+	char Dimensions[32];
+	snprintf(Dimensions, sizeof(Dimensions), "%dx%d", Result.NumberOfLimitations, Result.NumberOfVariables);
+	printf("%-15s %5d %-10s %-9s %-12s", FamilyNames[Result.Family], Result.Size, Dimensions, EngineNames[Result.Engine], ResultState(Result));
+	if (Result.IsSkipped || Result.Error[0]) {
+		printf(" %s\n", Result.Error);
+		return;
+	}
+	printf(" %8d %12.3f %12.3f %12.0f %10lld %10lld %16g", Result.ArtificialPivots + Result.SimplexPivots, Result.BestMilliseconds,
+		Result.MeanMilliseconds, PivotsPerSecond(Result), Result.PeakBytes / 1024, Result.Allocations, Result.Objective);
+	if (Result.ObjectiveDifference >= 0.0) {
+		printf(" %12.3g\n", Result.ObjectiveDifference);
+	} else {
+		printf(" %12s\n", "-");
+	}
+}
+
+static const char* WriteJson(const char* FileName, const BenchmarkOptions& Options, const std::vector<EngineResult>& Results) {
+	FILE* File = fopen(FileName, "wb");
+	if (!File) {
+		return strerror(errno);
+	}
+	fprintf(File, "{\n  \"label\": ");
+	WriteJsonString(File, Options.Label);
+	fprintf(File, ",\n  \"seed\": %u,\n  \"repeat\": %d,\n  \"max_pivots\": %d,\n  \"time_limit_ms\": ", Options.Seed, Options.Repeat, Options.MaxPivots);
+	WriteJsonNumber(File, Options.TimeLimit);
+	fprintf(File, ",\n  \"results\": [");
+	for (size_t i = 0; i < Results.size(); i++) {
+		const EngineResult& Result = Results[i];
+		fprintf(File, "%s\n    {\"family\": \"%s\", \"size\": %d, \"limitations\": %d, \"variables\": %d, \"engine\": \"%s\", \"state\": \"%s\"",
+			i == 0 ? "" : ",", FamilyNames[Result.Family], Result.Size, Result.NumberOfLimitations, Result.NumberOfVariables,
+			EngineNames[Result.Engine], ResultState(Result));
+		if (Result.IsSkipped || Result.Error[0]) {
+			fprintf(File, ", \"error\": ");
+			WriteJsonString(File, Result.Error);
+			fprintf(File, "}");
+			continue;
+		}
+		fprintf(File, ", \"artificial_pivots\": %d, \"simplex_pivots\": %d, \"runs\": %d, \"best_ms\": ", Result.ArtificialPivots, Result.SimplexPivots, Result.Runs);
+		WriteJsonNumber(File, Result.BestMilliseconds);
+		fprintf(File, ", \"mean_ms\": ");
+		WriteJsonNumber(File, Result.MeanMilliseconds);
+		fprintf(File, ", \"pivots_per_second\": ");
+		WriteJsonNumber(File, PivotsPerSecond(Result));
+		fprintf(File, ", \"peak_bytes\": %lld, \"allocations\": %lld, \"objective\": ", Result.PeakBytes, Result.Allocations);
+		WriteJsonNumber(File, Result.Objective);
+		fprintf(File, ", \"objective_difference\": ");
+		WriteJsonNumber(File, Result.ObjectiveDifference >= 0.0 ? Result.ObjectiveDifference : NAN);
+		fprintf(File, "}");
+	}
+	fprintf(File, "\n  ]\n}\n");
+	bool IsWritten = !ferror(File);
+	return fclose(File) == 0 && IsWritten ? NULL : "Failed to write the file";
+}
+
+// Reads a list separated by commas. Returns false if a name is unknown
+static bool ParseNames(const char* Text, const char** Names, int NumberOfNames, std::vector<int>& Indices) {
+	Indices.clear();
+	while (*Text) {
+		const char* End = strchr(Text, ',');
+		size_t Length = End ? End - Text : strlen(Text);
+		int Index = 0;
+		while (Index < NumberOfNames && (strlen(Names[Index]) != Length || strncmp(Names[Index], Text, Length) != 0)) {
+			Index++;
+		}
+		if (Index == NumberOfNames) {
+			return false;
+		}
+		Indices.push_back(Index);
+		Text += Length + (End ? 1 : 0);
+	}
+	return !Indices.empty();
+}
+
+static bool ParseSizes(const char* Text, std::vector<int>& Sizes) {
+	Sizes.clear();
+	while (*Text) {
+		char* End;
+		long Size = strtol(Text, &End, 10);
+		if (End == Text || Size < 1 || Size > 10000 || (*End != ',' && *End != '\0')) {
+			return false;
+		}
+		Sizes.push_back(Size);
+		Text = *End ? End + 1 : End;
+	}
+	return !Sizes.empty();
+}
+
+int main(int argc, char** argv) {
+	BenchmarkOptions Options;
+	for (int i = 0; i < NumberOfFamilies; i++) {
+		Options.Families.push_back(i);
+	}
+	for (int i = 0; i < NUMBER_OF_ENGINES; i++) {
+		Options.Engines.push_back(i);
+	}
+	Options.Sizes = { 4, 8, 16, 32, 64 };
+	for (int i = 1; i < argc; i++) {
+		bool HasValue = i + 1 < argc;
+		bool IsCorrect = HasValue;
+		if (strcmp(argv[i], "--families") == 0 && HasValue) {
+			IsCorrect = ParseNames(argv[++i], FamilyNames, NumberOfFamilies, Options.Families);
+		} else if (strcmp(argv[i], "--engines") == 0 && HasValue) {
+			IsCorrect = ParseNames(argv[++i], EngineNames, NUMBER_OF_ENGINES, Options.Engines);
+		} else if (strcmp(argv[i], "--sizes") == 0 && HasValue) {
+			IsCorrect = ParseSizes(argv[++i], Options.Sizes);
+		} else if (strcmp(argv[i], "--repeat") == 0 && HasValue) {
+			Options.Repeat = std::max(1, atoi(argv[++i]));
+		} else if (strcmp(argv[i], "--seed") == 0 && HasValue) {
+			Options.Seed = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--max-pivots") == 0 && HasValue) {
+			Options.MaxPivots = std::max(0, atoi(argv[++i]));
+		} else if (strcmp(argv[i], "--time-limit") == 0 && HasValue) {
+			Options.TimeLimit = atof(argv[++i]);
+		} else if (strcmp(argv[i], "--label") == 0 && HasValue) {
+			Options.Label = argv[++i];
+		} else if (strcmp(argv[i], "--json") == 0 && HasValue) {
+			Options.JsonFileName = argv[++i];
+		} else {
+			IsCorrect = false;
+		}
+		if (!IsCorrect) {
+			printf("Usage: SolverBenchmark [--families list] [--engines list] [--sizes list] [--repeat N] [--seed N]\n"
+				"                       [--max-pivots N] [--time-limit MS] [--label text] [--json file]\n");
+			return 1;
+		}
+	}
+	std::sort(Options.Sizes.begin(), Options.Sizes.end());
+
+	printf("%-15s %5s %-10s %-9s %-12s %8s %12s %12s %12s %10s %10s %16s %12s\n", "family", "N", "problem", "engine", "state",
+		"pivots", "best, ms", "mean, ms", "pivots/s", "peak, KB", "allocs", "objective", "difference");
+	std::vector<EngineResult> AllResults;
+	for (int Family : Options.Families) {
+		// Engines that were slower than the time limit on a smaller problem of the family
+		std::vector<bool> IsTooSlow(NUMBER_OF_ENGINES, false);
+		for (int Size : Options.Sizes) {
+			Problem problem;
+			GenerateFamilyProblem(Family, Size, Options.Seed, problem);
+
+			std::vector<EngineResult> Results;
+			for (int Engine : Options.Engines) {
+				EngineResult Result;
+				memset(&Result, 0, sizeof(Result));
+				Result.Family = Family;
+				Result.Size = Size;
+				Result.NumberOfLimitations = problem.NumberOfLimitations;
+				Result.NumberOfVariables = problem.NumberOfVariables;
+				Result.Engine = Engine;
+				if (IsTooSlow[Engine]) {
+					Result.IsSkipped = true;
+					snprintf(Result.Error, sizeof(Result.Error), "slower than %g ms on a smaller problem", Options.TimeLimit);
+				} else {
+#ifdef _WIN32
+					SolveWithEngine(problem, Options, Result);
+#else
+					SolveInProcess(problem, Options, Result);
+#endif
+					IsTooSlow[Engine] = !Result.Error[0] && Result.BestMilliseconds > Options.TimeLimit;
+				}
+				Results.push_back(Result);
+			}
+			CompareObjectives(Results.data(), Results.size());
+			for (EngineResult& Result : Results) {
+				PrintResult(Result);
+				AllResults.push_back(Result);
+			}
+		}
+	}
+
+	if (Options.JsonFileName) {
+		if (const char* Error = WriteJson(Options.JsonFileName, Options, AllResults)) {
+			printf("Failed to write %s: %s\n", Options.JsonFileName, Error);
+			return 1;
+		}
+	}
+	return 0;
+}
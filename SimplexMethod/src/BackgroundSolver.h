@@ -0,0 +1,155 @@
+#pragma once
+
+// Automatic solving on a worker thread.
+// Worker publishes every calculated step through a lock-free queue and GUI takes them
+// at the beginning of a frame, so the window keeps responding while a big problem is solved
+
+// Queue with one producer (worker) and one consumer (GUI thread)
+struct StepQueue {
+	static const size_t Capacity = 256;
+
+	Step* Slots[Capacity];
+	alignas(64) std::atomic<size_t> Head{ 0 };
+	alignas(64) std::atomic<size_t> Tail{ 0 };
+
+	bool Push(Step* step) {
+		size_t CurrentTail = Tail.load(std::memory_order_relaxed);
+		if (CurrentTail - Head.load(std::memory_order_acquire) == Capacity) {
+			return false;
+		}
+		Slots[CurrentTail % Capacity] = step;
+		Tail.store(CurrentTail + 1, std::memory_order_release);
+		return true;
+	}
+
+	Step* Pop() {
+		size_t CurrentHead = Head.load(std::memory_order_relaxed);
+		if (CurrentHead == Tail.load(std::memory_order_acquire)) {
+			return NULL;
+		}
+		Step* step = Slots[CurrentHead % Capacity];
+		Head.store(CurrentHead + 1, std::memory_order_release);
+		return step;
+	}
+};
+
+struct BackgroundSolver {
+	StepQueue Queue;
+	std::thread Worker;
+	std::atomic<bool> IsRunning{ false };
+	std::atomic<bool> IsCancelRequested{ false };
+	bool IsStarted = false;
+	bool IsArtificialPhase = false;
+
+	// Progress of the worker
+	std::atomic<int> Iteration{ 0 };
+	std::atomic<double> Objective{ 0.0 };
+
+	// Called by the worker when a step is published into the empty queue and when it stops, so GUI can wake up
+	void (*OnPublish)() = NULL;
+
+	~BackgroundSolver() {
+		Reset();
+	}
+
+	// Starts solving from a step. OriginalColNumber is used by the artificial basis method
+	// to find out which variables are artificial. Worker writes the steps into Trace if it's given
+	// and nobody else touches the trace until the worker stops
+	template<typename MatrixType, typename ElementType> void Start(Step step, int OriginalColNumber, StepTrace* Trace = NULL) {
+		Reset();
+		IsStarted = true;
+		IsArtificialPhase = step.IsArtificialStep;
+		IsRunning.store(true);
+
+		Worker = std::thread([this, step, OriginalColNumber, Trace]() mutable {
+			if (Trace) {
+				Trace->AddTable(step);
+			}
+			while (!IsCancelRequested.load(std::memory_order_relaxed)) {
+				ProfileClock::time_point PivotStart = ProfileClock::now();
+				Step NewStep = SimplexStep<MatrixType, ElementType>(step);
+				if (NewStep.IsCompleted) {
+					// There's no step after this one, but GUI has to know that the problem has no solution
+					if (step.IsArtificialStep && CheckAlgorithmState(StepMatrix<MatrixType>(step), false, true) == SOLUTION_DOESNT_EXIST) {
+						step.IsCompleted = true;
+						Publish(new Step(step));
+					}
+					break;
+				}
+
+				if (NewStep.IsArtificialStep) {
+					CompleteArtificialStep<MatrixType>(NewStep, OriginalColNumber);
+				} else {
+					CompleteSimplexStep<MatrixType>(NewStep);
+				}
+
+				if (Trace) {
+					Trace->AddPivot(step, NewStep, SolverProfile::Elapsed(PivotStart, ProfileClock::now()));
+				}
+
+				MatrixType& matrix = StepMatrix<MatrixType>(NewStep);
+				Iteration.fetch_add(1, std::memory_order_relaxed);
+				Objective.store(-ToDouble(matrix[matrix.RowNumber - 1][matrix.ColNumber - 1]), std::memory_order_relaxed);
+
+				if (!Publish(new Step(NewStep))) {
+					break;
+				}
+				step = NewStep;
+			}
+			if (Trace) {
+				Trace->Flush();
+			}
+			IsRunning.store(false, std::memory_order_release);
+			if (OnPublish) {
+				OnPublish();
+			}
+		});
+	}
+
+	// Waits while GUI takes steps out of the queue. Returns false if solving was cancelled
+	bool Publish(Step* step) {
+		while (!Queue.Push(step)) {
+			if (IsCancelRequested.load(std::memory_order_relaxed)) {
+				delete step;
+				return false;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		// GUI takes all published steps at once, so it has to be woken only for the first one
+		if (OnPublish && Queue.Tail.load() - Queue.Head.load() == 1) {
+			OnPublish();
+		}
+		return true;
+	}
+
+	// Moves all published steps to the end of Steps. Returns number of moved steps
+	int Drain(std::vector<Step>& Steps) {
+		int Count = 0;
+		while (Step* step = Queue.Pop()) {
+			Steps.push_back(*step);
+			delete step;
+			Count += 1;
+		}
+		return Count;
+	}
+
+	void Cancel() {
+		IsCancelRequested.store(true);
+		if (Worker.joinable()) {
+			Worker.join();
+		}
+	}
+
+	// Stops worker and forgets everything it has calculated
+	void Reset() {
+		Cancel();
+		while (Step* step = Queue.Pop()) {
+			delete step;
+		}
+		IsCancelRequested.store(false);
+		IsRunning.store(false);
+		IsStarted = false;
+		Iteration.store(0);
+		Objective.store(0.0);
+	}
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+// Basis files for warm start.
+// Text form is the numbers of basis variables separated by spaces, numbers start from 1.
+// Snapshot of a solution (".spxs") gives the basis of its last table
+
+static void TakeSnapshotBasis(Step& step, int NumberOfVariables, std::vector<int>& Basis) {
+	int NumberOfLimitations = step.RealMatrix.RowNumber - 1;
+	for (int i = 0; i < NumberOfLimitations; i++) {
+		// Artificial variables have numbers after the variables of the problem
+		if (step.NumbersOfVariables[i] <= NumberOfVariables) {
+			Basis.push_back(step.NumbersOfVariables[i]);
+		}
+	}
+}
+
+// Returns NULL on success and error message otherwise
+const char* ReadBasis(const char* FileName, std::vector<int>& Basis) {
+	Basis.clear();
+	if (HasExtension(FileName, ".spxs")) {
+		SolutionSnapshot Snapshot;
+		ReadStatistics Statistics;
+		if (const char* Error = ReadSnapshot(FileName, Snapshot, Statistics)) {
+			return Error;
+		}
+		std::vector<Step>& Steps = Snapshot.SimplexAlgorithmSteps.empty() ? Snapshot.ArtificialBasisSteps : Snapshot.SimplexAlgorithmSteps;
+		if (Steps.empty()) {
+			return "Snapshot has no steps";
+		}
+		TakeSnapshotBasis(Steps.back(), Snapshot.problem.NumberOfVariables, Basis);
+		return NULL;
+	}
+
+	MappedFile File;
+	if (const char* Error = File.Open(FileName)) {
+		return Error;
+	}
+	ProblemText Text(File.Data, File.Size);
+	while (!Text.IsAtEnd()) {
+		int Variable;
+		if (const char* Error = Text.ReadInteger(Variable, "Can't read basis")) {
+			return Error;
+		}
+		if (Variable < 1) {
+			return "Wrong number of variable";
+		}
+		Basis.push_back(Variable);
+	}
+	return NULL;
+}
+
+const char* WriteBasis(const char* FileName, const std::vector<int>& Basis) {
+	FILE* File = fopen(FileName, "w");
+	if (!File) {
+		return "Can't open file";
+	}
+	for (int i = 0; i < Basis.size(); i++) {
+		fprintf(File, i + 1 < Basis.size() ? "%d " : "%d", Basis[i]);
+	}
+	fprintf(File, "\n");
+	return fclose(File) == 0 ? NULL : "Can't write file";
+}
@@ -0,0 +1,424 @@
+#pragma once
+
+// Batch solving of problem files.
+// Coordinator forks worker processes and hands problems out through rings of job indices placed in shared memory,
+// one ring for every worker. Workers write results back into the same memory. Worker that crashes (Fraction overflow, failed assert)
+// or exceeds time limit is replaced with a new one and its job is dispatched again.
+// On Windows or with zero workers problems are solved one after another in this process
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+enum BatchJobStatus {
+	JOB_PENDING,
+	JOB_DONE,
+	JOB_FAILED,
+	JOB_CRASHED,
+	JOB_TIMEOUT,
+};
+
+struct BatchOptions {
+	int Workers = 4;
+	bool IsFractionalCoefficients = false;
+	// Seconds one job may run before its worker is killed, 0 means no limit
+	double Timeout = 0.0;
+	// How many times a job is dispatched before it's considered to be crashing
+	int MaxAttempts = 2;
+	int MaxPivots = 0;
+	// Threads that solve independent blocks of one problem
+	int BlockThreads = 1;
+	// Basis of the last solution of a problem is kept next to its file and the next solution starts from it
+	bool IsWarmStart = false;
+	bool IsBasisSaved = false;
+	// Pivots of a problem are traced into a file next to it, tables are written every TraceInterval steps.
+	// Negative means no trace
+	int TraceInterval = -1;
+	// Report of the solution (SolutionReport.h) is written next to the problem file
+	bool IsReportWritten = false;
+};
+
+struct BatchResult {
+	std::atomic<int> Status;
+	int Attempts;
+	AlgorithmState State;
+	int ArtificialPivots;
+	int SimplexPivots;
+	double Objective;
+	double Milliseconds;
+	// Points to a string literal, so it stays valid in forked processes
+	const char* Error;
+};
+
+static double MillisecondsSince(std::chrono::steady_clock::time_point Start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+}
+
+static void SolveBatchJob(const char* FileName, const BatchOptions& Options, BatchResult& Result) {
+	auto Start = std::chrono::steady_clock::now();
+
+	Problem problem;
+	Result.Error = LoadProblem(FileName, Options.IsFractionalCoefficients, problem);
+	if (Result.Error) {
+		Result.Milliseconds = MillisecondsSince(Start);
+		Result.Status.store(JOB_FAILED, std::memory_order_release);
+		return;
+	}
+
+	// Solver gets the problem without rows "0 = 0", the report keeps rows of the file
+	Problem Reduced;
+	Problem& Solved = RemoveRedundantRows(problem, Reduced) ? Reduced : problem;
+
+	// Trace is the audit of the job, so a trace that can't be written fails it
+	StepTrace Trace;
+	if (Options.TraceInterval >= 0) {
+		std::string TraceFileName = std::string(FileName) + ".spxt";
+		Result.Error = Trace.Open(TraceFileName.c_str(), Solved.NumberOfLimitations, Solved.NumberOfVariables, Solved.IsFractionalCoefficients, Options.TraceInterval);
+		if (Result.Error) {
+			Result.Milliseconds = MillisecondsSince(Start);
+			Result.Status.store(JOB_FAILED, std::memory_order_release);
+			return;
+		}
+	}
+
+	// Warm start and trace take the whole problem, blocks of the basis aren't found and blocks aren't traced
+	std::vector<int> Basis;
+	std::string BasisFileName = std::string(FileName) + ".basis";
+	std::string SnapshotFileName = std::string(FileName) + ".spxs";
+	bool HasBasis = Options.IsWarmStart && (ReadBasis(BasisFileName.c_str(), Basis) == NULL || ReadBasis(SnapshotFileName.c_str(), Basis) == NULL);
+	Solution solution;
+	if (HasBasis) {
+		solution = SolveFromBasis(Solved, Basis, Options.MaxPivots, Trace.IsOpen() ? &Trace : NULL);
+	} else if (Trace.IsOpen()) {
+		solution = SolveProblem(Solved, Options.MaxPivots, &Trace);
+	} else {
+		solution = SolveSeparable(Solved, Options.MaxPivots, Options.BlockThreads);
+	}
+	Result.Error = Trace.Close();
+	if (Result.Error) {
+		Result.Milliseconds = MillisecondsSince(Start);
+		Result.Status.store(JOB_FAILED, std::memory_order_release);
+		return;
+	}
+	// Basis is only a hint for the next solution, so a file that can't be written doesn't fail the job
+	if (Options.IsBasisSaved && solution.State == COMPLETED) {
+		WriteBasis(BasisFileName.c_str(), solution.Basis);
+	}
+	if (Options.IsReportWritten) {
+		SolutionReport Report;
+		MakeSolutionReport(problem, solution, Report);
+		std::string ReportFileName = std::string(FileName) + ".spxr";
+		Result.Error = WriteSolutionReport(ReportFileName.c_str(), Report);
+		if (Result.Error) {
+			Result.Milliseconds = MillisecondsSince(Start);
+			Result.Status.store(JOB_FAILED, std::memory_order_release);
+			return;
+		}
+	}
+	Result.State = solution.State;
+	Result.ArtificialPivots = solution.ArtificialPivots;
+	Result.SimplexPivots = solution.SimplexPivots;
+	Result.Objective = solution.Objective;
+	Result.Milliseconds = MillisecondsSince(Start);
+	// Status is the last thing coordinator looks at
+	Result.Status.store(JOB_DONE, std::memory_order_release);
+}
+
+// Returns exit code of the batch: 1 if any job hasn't finished as done
+int PrintBatchResults(std::vector<std::string>& Files, BatchResult* Results) {
+	const char* StatusNames[] = { "pending", "done", "failed", "crashed", "timeout" };
+	const char* StateNames[] = { "undefined", "completed", "unlimited", "stopped", "no solution" };
+
+	printf("%-40s %-8s %-12s %16s %8s %12s\n", "file", "status", "state", "objective", "pivots", "time, ms");
+	int ExitCode = 0;
+	for (int i = 0; i < Files.size(); i++) {
+		BatchResult& Result = Results[i];
+		int Status = Result.Status.load();
+		if (Status == JOB_DONE) {
+			printf("%-40s %-8s %-12s %16g %8d %12.3f\n", Files[i].c_str(), StatusNames[Status], StateNames[Result.State],
+				Result.Objective, Result.ArtificialPivots + Result.SimplexPivots, Result.Milliseconds);
+		} else {
+			printf("%-40s %-8s %s\n", Files[i].c_str(), StatusNames[Status], Result.Error ? Result.Error : "");
+			ExitCode = 1;
+		}
+	}
+	return ExitCode;
+}
+
+static int RunBatchInProcess(std::vector<std::string>& Files, const BatchOptions& Options) {
+	std::vector<BatchResult> Results(Files.size());
+	for (int i = 0; i < Files.size(); i++) {
+		Results[i].Status.store(JOB_PENDING);
+		Results[i].Attempts = 1;
+		Results[i].Error = NULL;
+		SolveBatchJob(Files[i].c_str(), Options, Results[i]);
+	}
+
+	return PrintBatchResults(Files, Results.data());
+}
+
+#ifndef _WIN32
+// Ring of job indices of one worker: only coordinator pushes and only the worker takes jobs out.
+// Worker leaves a job in the ring while solving it and removes it with one store when the job is done,
+// so the jobs of a killed worker are exactly the ones between Tail and Head
+struct JobRing {
+	static const unsigned Capacity = 16;
+
+	int Jobs[Capacity];
+	// Jobs pushed, written by coordinator
+	alignas(64) std::atomic<unsigned> Head;
+	// Jobs finished, written by worker
+	alignas(64) std::atomic<unsigned> Tail;
+
+	void Init() {
+		Head.store(0, std::memory_order_relaxed);
+		Tail.store(0, std::memory_order_relaxed);
+	}
+
+	unsigned Size() const {
+		return Head.load(std::memory_order_acquire) - Tail.load(std::memory_order_acquire);
+	}
+
+	bool Push(int Job) {
+		unsigned Position = Head.load(std::memory_order_relaxed);
+		if (Position - Tail.load(std::memory_order_acquire) == Capacity) {
+			return false;
+		}
+		Jobs[Position & (Capacity - 1)] = Job;
+		Head.store(Position + 1, std::memory_order_release);
+		return true;
+	}
+
+	// The oldest job that isn't finished
+	bool Front(unsigned& Position, int& Job) const {
+		Position = Tail.load(std::memory_order_relaxed);
+		if (Position == Head.load(std::memory_order_acquire)) {
+			return false;
+		}
+		Job = Jobs[Position & (Capacity - 1)];
+		return true;
+	}
+
+	void PopFront() {
+		Tail.store(Tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+};
+
+struct BatchWorkerSlot {
+	JobRing Ring;
+	// Position of the job being solved plus one, 0 before the first job.
+	// Stamp and time of the start are read together, so a job that has been finished is never taken for a hanging one
+	std::atomic<unsigned> StartedPosition;
+	std::atomic<long long> JobStartTime;
+	// -1 if worker couldn't be started
+	pid_t Pid;
+};
+
+static const int MAX_BATCH_WORKERS = 256;
+// Jobs given to a worker at once: one that is solved and one that waits, so a worker never waits for coordinator
+static const unsigned BATCH_WORKER_QUEUE = 2;
+
+struct BatchSharedMemory {
+	std::atomic<int> Shutdown;
+	BatchWorkerSlot Workers[MAX_BATCH_WORKERS];
+	// Results of all jobs are placed right after this structure
+	BatchResult* Results() { return (BatchResult*)(this + 1); }
+};
+
+static long long MonotonicMilliseconds() {
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void BatchWorker(BatchSharedMemory* Shared, int WorkerIndex, std::vector<std::string>& Files, const BatchOptions& Options) {
+	BatchWorkerSlot& Slot = Shared->Workers[WorkerIndex];
+	for (;;) {
+		unsigned Position;
+		int Job;
+		if (!Slot.Ring.Front(Position, Job)) {
+			if (Shared->Shutdown.load(std::memory_order_acquire)) {
+				break;
+			}
+			usleep(500);
+			continue;
+		}
+
+		Slot.JobStartTime.store(MonotonicMilliseconds(), std::memory_order_relaxed);
+		Slot.StartedPosition.store(Position + 1, std::memory_order_release);
+		SolveBatchJob(Files[Job].c_str(), Options, Shared->Results()[Job]);
+		Slot.Ring.PopFront();
+	}
+	_exit(0);
+}
+
+static pid_t SpawnBatchWorker(BatchSharedMemory* Shared, int WorkerIndex, std::vector<std::string>& Files, const BatchOptions& Options) {
+	BatchWorkerSlot& Slot = Shared->Workers[WorkerIndex];
+	Slot.Ring.Init();
+	Slot.StartedPosition.store(0);
+	Slot.JobStartTime.store(0);
+	fflush(stdout);
+	pid_t Pid = fork();
+	if (Pid == 0) {
+		BatchWorker(Shared, WorkerIndex, Files, Options);
+	}
+	Slot.Pid = Pid;
+	return Pid;
+}
+
+// Position of the job a worker has been solving for longer than the time limit, -1 if there's no such job
+static long long FindHangingJob(BatchWorkerSlot& Slot, double Timeout) {
+	unsigned Started = Slot.StartedPosition.load(std::memory_order_acquire);
+	long long StartTime = Slot.JobStartTime.load(std::memory_order_relaxed);
+	if (Started == 0 || Slot.StartedPosition.load(std::memory_order_acquire) != Started) {
+		return -1;
+	}
+	unsigned Position = Started - 1;
+	// Job is finished when the tail has passed it
+	if (Slot.Ring.Tail.load(std::memory_order_acquire) != Position) {
+		return -1;
+	}
+	return MonotonicMilliseconds() - StartTime > Timeout * 1000.0 ? (long long)Position : -1;
+}
+
+int RunBatch(std::vector<std::string>& Files, BatchOptions Options) {
+	if (Options.Workers <= 0 || Files.empty()) {
+		return RunBatchInProcess(Files, Options);
+	}
+	Options.Workers = Clamp(Options.Workers, 1, std::min(MAX_BATCH_WORKERS, (int)Files.size()));
+
+	size_t SharedSize = sizeof(BatchSharedMemory) + sizeof(BatchResult) * Files.size();
+	void* Memory = mmap(NULL, SharedSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (Memory == MAP_FAILED) {
+		printf("Failed to allocate shared memory, solving in this process\n");
+		return RunBatchInProcess(Files, Options);
+	}
+
+	BatchSharedMemory* Shared = new (Memory) BatchSharedMemory;
+	Shared->Shutdown.store(0);
+	BatchResult* Results = Shared->Results();
+	for (int i = 0; i < Files.size(); i++) {
+		new (&Results[i]) BatchResult;
+		Results[i].Status.store(JOB_PENDING);
+		Results[i].Attempts = 0;
+		Results[i].Error = NULL;
+	}
+
+	std::deque<int> PendingJobs;
+	for (int i = 0; i < Files.size(); i++) {
+		PendingJobs.push_back(i);
+	}
+
+	for (int i = 0; i < Options.Workers; i++) {
+		if (SpawnBatchWorker(Shared, i, Files, Options) < 0) {
+			printf("Failed to start worker process\n");
+			Options.Workers = i;
+			break;
+		}
+	}
+	if (Options.Workers == 0) {
+		munmap(Memory, SharedSize);
+		return RunBatchInProcess(Files, Options);
+	}
+
+	// Position of the job a worker was killed for, -1 if it wasn't killed
+	std::vector<long long> KilledPositions(Options.Workers, -1);
+	int LiveWorkers = Options.Workers;
+	int FinishedJobs = 0;
+	while (FinishedJobs < Files.size()) {
+		// Hand out jobs to the workers that have room for them
+		for (int i = 0; i < Options.Workers && !PendingJobs.empty(); i++) {
+			BatchWorkerSlot& Slot = Shared->Workers[i];
+			while (Slot.Pid > 0 && KilledPositions[i] < 0 && !PendingJobs.empty() && Slot.Ring.Size() < BATCH_WORKER_QUEUE && Slot.Ring.Push(PendingJobs.front())) {
+				Results[PendingJobs.front()].Attempts += 1;
+				PendingJobs.pop_front();
+			}
+		}
+
+		// Health check of workers
+		for (int i = 0; i < Options.Workers; i++) {
+			BatchWorkerSlot& Slot = Shared->Workers[i];
+			if (Slot.Pid <= 0) {
+				continue;
+			}
+
+			// Hanging job. Worker is killed once, the job is found again when it's dead
+			if (Options.Timeout > 0.0 && KilledPositions[i] < 0) {
+				KilledPositions[i] = FindHangingJob(Slot, Options.Timeout);
+				if (KilledPositions[i] >= 0) {
+					kill(Slot.Pid, SIGKILL);
+				}
+			}
+
+			int WaitStatus;
+			if (waitpid(Slot.Pid, &WaitStatus, WNOHANG) != Slot.Pid) {
+				continue;
+			}
+
+			// Worker is dead, nothing changes in its ring anymore. Unfinished jobs are taken back,
+			// only the job that was being solved has used an attempt
+			unsigned Started = Slot.StartedPosition.load();
+			unsigned Head = Slot.Ring.Head.load();
+			for (unsigned Position = Slot.Ring.Tail.load(); Position != Head; Position++) {
+				int Job = Slot.Ring.Jobs[Position & (JobRing::Capacity - 1)];
+				if (Results[Job].Status.load() != JOB_PENDING) {
+					continue;
+				}
+				bool IsTimedOut = KilledPositions[i] == Position;
+				if (Started != Position + 1) {
+					Results[Job].Attempts -= 1;
+					PendingJobs.push_front(Job);
+				} else if (Results[Job].Attempts >= Options.MaxAttempts) {
+					Results[Job].Error = IsTimedOut ? "Time limit exceeded" : WIFSIGNALED(WaitStatus) ? strsignal(WTERMSIG(WaitStatus)) : "Worker exited";
+					Results[Job].Status.store(IsTimedOut ? JOB_TIMEOUT : JOB_CRASHED);
+				} else {
+					Results[Job].Error = NULL;
+					PendingJobs.push_front(Job);
+				}
+			}
+			KilledPositions[i] = -1;
+
+			if (SpawnBatchWorker(Shared, i, Files, Options) < 0) {
+				printf("Failed to restart worker process\n");
+				LiveWorkers -= 1;
+			}
+		}
+
+		FinishedJobs = 0;
+		for (int i = 0; i < Files.size(); i++) {
+			if (Results[i].Status.load(std::memory_order_acquire) != JOB_PENDING) {
+				FinishedJobs += 1;
+			}
+		}
+
+		// Jobs that are left can't be solved without workers
+		if (LiveWorkers == 0) {
+			for (int i = 0; i < Files.size(); i++) {
+				if (Results[i].Status.load() == JOB_PENDING) {
+					Results[i].Error = "No worker processes left";
+					Results[i].Status.store(JOB_FAILED);
+				}
+			}
+			break;
+		}
+
+		usleep(500);
+	}
+
+	Shared->Shutdown.store(1, std::memory_order_release);
+	for (int i = 0; i < Options.Workers; i++) {
+		if (Shared->Workers[i].Pid > 0) {
+			waitpid(Shared->Workers[i].Pid, NULL, 0);
+		}
+	}
+
+	int ExitCode = PrintBatchResults(Files, Results);
+	munmap(Memory, SharedSize);
+	return ExitCode;
+}
+#else
+int RunBatch(std::vector<std::string>& Files, BatchOptions Options) {
+	return RunBatchInProcess(Files, Options);
+}
+#endif
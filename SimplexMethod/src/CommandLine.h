@@ -0,0 +1,213 @@
+#pragma once
+
+// Modes that work without any window
+// --------------------
+static void PrintUsage() {
+	printf("Usage:\n");
+	printf("  SimplexMethod                        start graphical interface\n");
+	printf("  SimplexMethod --batch [options] files...\n");
+	printf("      --workers N     number of worker processes, 0 solves in this process (default 4)\n");
+	printf("      --fractions     files contain fractions a/b instead of real numbers\n");
+	printf("      --timeout S     kill worker if one problem takes more than S seconds\n");
+	printf("      --attempts N    times a problem is dispatched before it is reported as crashed (default 2)\n");
+	printf("      --max-pivots N  limit of pivots for each phase\n");
+	printf("      --block-threads N  threads that solve independent blocks of one problem (default 1)\n");
+	printf("      --warm-start    start from the basis in file.basis or file.spxs next to the problem file\n");
+	printf("      --save-basis    write the final basis of a solved problem to file.basis\n");
+	printf("      --trace K       write every pivot to file.spxt and the whole table every K steps (0 only the first tables)\n");
+	printf("      --report        write the solution with reduced costs, dual values and pivots to file.spxr\n");
+	printf("      exits with 1 if any problem has failed, crashed or run out of time\n");
+	printf("  SimplexMethod --daemon socket [--threads N]\n");
+	printf("      serve problems sent to the Unix domain socket (default 4 threads)\n");
+	printf("  SimplexMethod --parse [--fractions] files...\n");
+	printf("      read problems without solving them and print how fast they are read\n");
+	printf("  SimplexMethod --convert [--fractions] input output.lp\n");
+	printf("      write the problem the solver gets from the input file in LP format\n");
+	printf("  SimplexMethod --trace file.spxt [artificial|simplex step]\n");
+	printf("      print pivots of a trace as CSV, or the table of a step made again from the trace\n");
+	printf("  SimplexMethod --report file.spxr\n");
+	printf("      print columns of a solution report, a line for each\n");
+	printf("  Files with extension .mps are read as MPS (fixed or free), .lp as CPLEX LP, .csv and .tsv as tables of numbers,\n");
+	printf("  the rest as the text format\n");
+	printf("  Text that starts with a key (NV:, NL:, ...) is a configuration file and gives its own type of elements\n");
+}
+
+// Reads every file without making the table of the simplex method and prints speed of reading
+static int RunParse(std::vector<std::string>& Files, bool IsFractionalCoefficients) {
+	printf("%-40s %-8s %12s %12s %12s %10s %10s %10s\n", "file", "status", "rows", "columns", "elements", "MB", "ms", "MB/s");
+	int Failures = 0;
+	for (std::string& FileName : Files) {
+		ReadStatistics Statistics;
+		const char* Error;
+		int Rows = 0;
+		int Columns = 0;
+		bool IsMps = HasExtension(FileName.c_str(), ".mps");
+		if (IsMps || HasExtension(FileName.c_str(), ".lp")) {
+			SparseProblem Sparse;
+			Error = IsMps ? ReadMps(FileName.c_str(), Sparse, Statistics) : ReadLp(FileName.c_str(), Sparse, Statistics);
+			Rows = Sparse.RowNames.size();
+			Columns = Sparse.ColumnNames.size();
+		} else {
+			Problem problem;
+			Error = LoadProblem(FileName.c_str(), IsFractionalCoefficients, problem, Statistics);
+			Rows = problem.NumberOfLimitations;
+			Columns = problem.NumberOfVariables + 1;
+		}
+
+		if (Error) {
+			Failures += 1;
+			if (Statistics.ErrorColumn != 0) {
+				printf("%-40s %-8s line %d, column %d: %s\n", FileName.c_str(), "failed", Statistics.ErrorLine, Statistics.ErrorColumn, Error);
+			} else if (Statistics.ErrorLine != 0) {
+				printf("%-40s %-8s line %d: %s\n", FileName.c_str(), "failed", Statistics.ErrorLine, Error);
+			} else {
+				printf("%-40s %-8s %s\n", FileName.c_str(), "failed", Error);
+			}
+			continue;
+		}
+
+		double Megabytes = Statistics.Bytes / (1024.0 * 1024.0);
+		printf("%-40s %-8s %12d %12d %12lld %10.2f %10.1f %10.1f\n", FileName.c_str(), "read", Rows, Columns, Statistics.Elements,
+			Megabytes, Statistics.Milliseconds, Statistics.Milliseconds > 0.0 ? Megabytes * 1000.0 / Statistics.Milliseconds : 0.0);
+	}
+	return Failures == 0 ? 0 : 1;
+}
+
+// Table of a step with basis variables on the left and variables outside of the basis on the top
+static void PrintStep(Step& step, bool IsFractionalCoefficients) {
+	int RowNumber = IsFractionalCoefficients ? step.FracMatrix.RowNumber : step.RealMatrix.RowNumber;
+	int ColNumber = IsFractionalCoefficients ? step.FracMatrix.ColNumber : step.RealMatrix.ColNumber;
+	printf("%s step %d\n%8s", step.IsArtificialStep ? "artificial" : "simplex", step.StepID, "");
+	for (int j = 0; j < ColNumber - 1; j++) {
+		printf(" %12s", ("x" + std::to_string(step.NumbersOfVariables[RowNumber - 1 + j])).c_str());
+	}
+	printf(" %12s\n", "B");
+	for (int i = 0; i < RowNumber; i++) {
+		printf("%8s", i < RowNumber - 1 ? ("x" + std::to_string(step.NumbersOfVariables[i])).c_str() : "");
+		for (int j = 0; j < ColNumber; j++) {
+			if (IsFractionalCoefficients) {
+				printf(" %12s", (std::to_string(step.FracMatrix[i][j].numerator) + "/" + std::to_string(step.FracMatrix[i][j].denominator)).c_str());
+			} else {
+				printf(" %12g", step.RealMatrix[i][j]);
+			}
+		}
+		printf("\n");
+	}
+}
+
+int RunCommandLine(int argc, char** argv) {
+	if (strcmp(argv[1], "--batch") == 0) {
+		BatchOptions Options;
+		std::vector<std::string> Files;
+		for (int i = 2; i < argc; i++) {
+			bool HasValue = i + 1 < argc;
+			if (strcmp(argv[i], "--workers") == 0 && HasValue) {
+				Options.Workers = atoi(argv[++i]);
+			} else if (strcmp(argv[i], "--fractions") == 0) {
+				Options.IsFractionalCoefficients = true;
+			} else if (strcmp(argv[i], "--timeout") == 0 && HasValue) {
+				Options.Timeout = atof(argv[++i]);
+			} else if (strcmp(argv[i], "--attempts") == 0 && HasValue) {
+				Options.MaxAttempts = std::max(1, atoi(argv[++i]));
+			} else if (strcmp(argv[i], "--max-pivots") == 0 && HasValue) {
+				Options.MaxPivots = atoi(argv[++i]);
+			} else if (strcmp(argv[i], "--block-threads") == 0 && HasValue) {
+				Options.BlockThreads = std::max(1, atoi(argv[++i]));
+			} else if (strcmp(argv[i], "--warm-start") == 0) {
+				Options.IsWarmStart = true;
+			} else if (strcmp(argv[i], "--save-basis") == 0) {
+				Options.IsBasisSaved = true;
+			} else if (strcmp(argv[i], "--trace") == 0 && HasValue) {
+				Options.TraceInterval = std::max(0, atoi(argv[++i]));
+			} else if (strcmp(argv[i], "--report") == 0) {
+				Options.IsReportWritten = true;
+			} else {
+				Files.push_back(argv[i]);
+			}
+		}
+
+		if (Files.empty()) {
+			PrintUsage();
+			return 1;
+		}
+		return RunBatch(Files, Options);
+	}
+
+	if (strcmp(argv[1], "--parse") == 0) {
+		bool IsFractionalCoefficients = false;
+		std::vector<std::string> Files;
+		for (int i = 2; i < argc; i++) {
+			if (strcmp(argv[i], "--fractions") == 0) {
+				IsFractionalCoefficients = true;
+			} else {
+				Files.push_back(argv[i]);
+			}
+		}
+
+		if (Files.empty()) {
+			PrintUsage();
+			return 1;
+		}
+		return RunParse(Files, IsFractionalCoefficients);
+	}
+
+	if (strcmp(argv[1], "--convert") == 0) {
+		bool IsFractionalCoefficients = argc > 2 && strcmp(argv[2], "--fractions") == 0;
+		int First = IsFractionalCoefficients ? 3 : 2;
+		if (argc != First + 2) {
+			PrintUsage();
+			return 1;
+		}
+
+		Problem problem;
+		const char* Error = LoadProblem(argv[First], IsFractionalCoefficients, problem);
+		if (!Error) {
+			Error = problem.IsFractionalCoefficients ? WriteLp(argv[First + 1], problem.FracMatrix, problem.FractionalTargetFunction)
+				: WriteLp(argv[First + 1], problem.RealMatrix, problem.RealTargetFunction);
+		}
+		if (Error) {
+			fprintf(stderr, "%s\n", Error);
+			return 1;
+		}
+		return 0;
+	}
+
+	if (strcmp(argv[1], "--trace") == 0 && (argc == 3 || argc == 5)) {
+		const char* Error;
+		if (argc == 3) {
+			Error = PrintTrace(argv[2], stdout);
+		} else {
+			Step step;
+			bool IsFractionalCoefficients;
+			Error = ReplayTrace(argv[2], strcmp(argv[3], "artificial") == 0, atoi(argv[4]), step, IsFractionalCoefficients);
+			if (!Error) {
+				PrintStep(step, IsFractionalCoefficients);
+			}
+		}
+		if (Error) {
+			fprintf(stderr, "%s\n", Error);
+			return 1;
+		}
+		return 0;
+	}
+
+	if (strcmp(argv[1], "--report") == 0 && argc == 3) {
+		if (const char* Error = PrintSolutionReport(argv[2], stdout)) {
+			fprintf(stderr, "%s\n", Error);
+			return 1;
+		}
+		return 0;
+	}
+
+	if (strcmp(argv[1], "--daemon") == 0 && argc > 2) {
+		int Threads = 4;
+		if (argc > 4 && strcmp(argv[3], "--threads") == 0) {
+			Threads = std::max(1, atoi(argv[4]));
+		}
+		return RunDaemon(argv[2], Threads);
+	}
+
+	PrintUsage();
+	return 1;
+}
+//--------------------
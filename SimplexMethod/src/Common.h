@@ -451,6 +451,46 @@ enum AlgorithmState {
 	SOLUTION_DOESNT_EXIST,
 };
 
+// Text of the cells of a step, every label is made the first time its cell is displayed.
+// Labels are kept one after another in one buffer, so a step has two allocations for all of them
+struct CellLabels {
+	std::vector<char> Arena;
+	// Offset of every label in Arena, -1 if it isn't made yet
+	std::vector<int> Offsets;
+	// Digits the labels are made with, -1 if there are no labels
+	int SignificantDigits = -1;
+
+	bool IsBuilt(int Digits) {
+		return SignificantDigits == Digits;
+	}
+
+	void Clear() {
+		Arena.clear();
+		Offsets.clear();
+		SignificantDigits = -1;
+	}
+
+	// Forgets labels and makes room for Count labels made with Digits
+	void Reset(int Count, int Digits) {
+		Arena.clear();
+		Offsets.assign(Count, -1);
+		SignificantDigits = Digits;
+	}
+
+	bool Has(int Index) {
+		return Offsets[Index] >= 0;
+	}
+
+	void Set(int Index, const char* Label) {
+		Offsets[Index] = Arena.size();
+		Arena.insert(Arena.end(), Label, Label + strlen(Label) + 1);
+	}
+
+	const char* operator[](int Index) {
+		return &Arena[Offsets[Index]];
+	}
+};
+
 struct Step {
 	int StepID;
 	RowAndColumn StepChosenRC;
@@ -463,6 +503,8 @@ struct Step {
 	// First m variables are basis variables
 	std::vector<int> NumbersOfVariables;
 	bool IsArtificialStep;
+	// Labels aren't copied, every step makes its own when it's displayed
+	CellLabels Labels;
 
 	Step() = default;
 
@@ -496,6 +538,21 @@ struct Step {
 		FracMatrix = step.FracMatrix;
 		NumbersOfVariables = step.NumbersOfVariables;
 		IsArtificialStep = step.IsArtificialStep;
+		Labels.Clear();
 		return *this;
 	}
+};
+
+// Short record of a step whose table isn't kept
+struct StepSummary {
+	int StepID;
+	int EnteringVariable;
+	int LeavingVariable;
+	double Objective;
+};
+
+struct StepSummaries {
+	std::vector<StepSummary> Rows;
+	// Variables of the last summarized step, the next step takes its leaving variable from them
+	std::vector<int> LastVariables;
 };
\ No newline at end of file
@@ -0,0 +1,299 @@
+#pragma once
+
+// Tables of numbers copied from spreadsheets: files ".csv" and ".tsv" and text of the clipboard.
+// Cells are separated by tabs, semicolons or commas, the separator is the first of them found in the first row.
+// Comma inside of a cell is a decimal comma, in files separated by commas such cells are quoted.
+// Empty cell is zero, a cell may be a/b. The first row is skipped if it starts with a name of a column.
+//
+// Problem is the matrix of limitations with vector B in the last column. It may be followed by an empty line
+// and one more row of the same length with the target function and constant C
+
+// Cells row by row, only the vector of the type that has been read is filled
+struct CsvGrid {
+	int Rows = 0;
+	int Columns = 0;
+	// Rows before the first empty line, -1 if there's no such line
+	int RowsBeforeGap = -1;
+	std::vector<float> RealCells;
+	std::vector<Fraction> FracCells;
+
+	int MatrixRows() const {
+		return RowsBeforeGap < 0 ? Rows : RowsBeforeGap;
+	}
+};
+
+struct CsvText {
+	const char* Begin;
+	const char* Position;
+	const char* End;
+	// Beginning of the cell that is read, error is reported at it
+	const char* Token;
+	char Separator;
+
+	CsvText(const char* Text, size_t Size) : Begin(Text), Position(Text), End(Text + Size), Token(Text) {
+		// Separator is looked for in the first row only, numbers can't have any of them
+		const char* LineEnd = (const char*)memchr(Text, '\n', Size);
+		size_t LineSize = LineEnd ? LineEnd - Text : Size;
+		if (memchr(Text, '\t', LineSize)) {
+			Separator = '\t';
+		} else if (memchr(Text, ';', LineSize)) {
+			Separator = ';';
+		} else {
+			Separator = ',';
+		}
+	}
+
+	bool IsSpace(char Character) const {
+		return Character == ' ' || Character == '\r' || (Character == '\t' && Separator != '\t');
+	}
+
+	bool IsCellEnd(char Character) const {
+		return Character == Separator || Character == '\n';
+	}
+
+	void SkipSpaces() {
+		while (Position < End && IsSpace(*Position)) {
+			Position++;
+		}
+	}
+
+	void SkipLine() {
+		const char* LineEnd = (const char*)memchr(Position, '\n', End - Position);
+		Position = LineEnd ? LineEnd + 1 : End;
+	}
+
+	// Line with nothing but spaces
+	bool IsEmptyLine() {
+		const char* Current = Position;
+		while (Current < End && IsSpace(*Current)) {
+			Current++;
+		}
+		return Current == End || *Current == '\n';
+	}
+
+	static bool IsSmallInteger(const DecimalNumber& Number) {
+		return Number.IsExact && Number.Exponent == 0 && Number.Mantissa <= INT32_MAX;
+	}
+
+	static int SignedInteger(const DecimalNumber& Number) {
+		return Number.IsNegative ? -(int)Number.Mantissa : (int)Number.Mantissa;
+	}
+
+	// Number that takes the whole text of the cell
+	static const char* ParseNumber(const char* NumberBegin, const char* NumberEnd, bool IsFractional, float& Real, Fraction& Frac) {
+		if (NumberBegin == NumberEnd) {
+			Real = 0.0f;
+			Frac = Fraction(0, 1);
+			return NULL;
+		}
+		DecimalNumber Numerator;
+		DecimalNumber Denominator;
+		const char* Position = ScanDecimal(NumberBegin, NumberEnd, Numerator);
+		if (!Position) {
+			return "Wrong number";
+		}
+		bool HasDenominator = Position < NumberEnd && *Position == '/';
+		if (HasDenominator) {
+			Position = ScanDecimal(Position + 1, NumberEnd, Denominator);
+			if (!Position) {
+				return "Wrong number";
+			}
+			if (Denominator.Mantissa == 0) {
+				return "Denominator is zero";
+			}
+		}
+		if (Position != NumberEnd) {
+			return "Wrong number";
+		}
+
+		if (!IsFractional) {
+			Real = HasDenominator ? (float)(DecimalToDouble(Numerator) / DecimalToDouble(Denominator)) : DecimalToFloat(Numerator);
+			return NULL;
+		}
+		// Integers and their fractions are kept as they are written, decimal numbers become the nearest small fraction
+		if (IsSmallInteger(Numerator) && (!HasDenominator || IsSmallInteger(Denominator))) {
+			Frac = Fraction(SignedInteger(Numerator), HasDenominator ? SignedInteger(Denominator) : 1);
+			if (Frac.denominator < 0) {
+				Frac.numerator = -Frac.numerator;
+				Frac.denominator = -Frac.denominator;
+			}
+			return NULL;
+		}
+		double Value = HasDenominator ? DecimalToDouble(Numerator) / DecimalToDouble(Denominator) : DecimalToDouble(Numerator);
+		return ToFraction(Value, Frac) ? NULL : "Number can't be written as a fraction";
+	}
+
+	const char* ReadCell(bool IsFractional, float& Real, Fraction& Frac) {
+		SkipSpaces();
+		Token = Position;
+		const char* CellBegin = Position;
+		const char* CellEnd;
+		if (Position < End && *Position == '"') {
+			CellBegin = Position + 1;
+			CellEnd = CellBegin;
+			while (CellEnd < End && *CellEnd != '"' && *CellEnd != '\n') {
+				CellEnd++;
+			}
+			if (CellEnd == End || *CellEnd != '"') {
+				return "Quote isn't closed";
+			}
+			Position = CellEnd + 1;
+			SkipSpaces();
+			if (Position < End && !IsCellEnd(*Position)) {
+				return "Wrong number";
+			}
+		} else {
+			while (Position < End && !IsCellEnd(*Position)) {
+				Position++;
+			}
+			CellEnd = Position;
+		}
+		while (CellBegin < CellEnd && IsSpace(CellBegin[0])) {
+			CellBegin++;
+		}
+		while (CellEnd > CellBegin && IsSpace(CellEnd[-1])) {
+			CellEnd--;
+		}
+
+		// Decimal comma is read from a copy of the cell
+		if (!memchr(CellBegin, ',', CellEnd - CellBegin)) {
+			return ParseNumber(CellBegin, CellEnd, IsFractional, Real, Frac);
+		}
+		char Cell[64];
+		size_t CellSize = CellEnd - CellBegin;
+		if (CellSize > sizeof(Cell)) {
+			return "Wrong number";
+		}
+		for (size_t i = 0; i < CellSize; i++) {
+			Cell[i] = CellBegin[i] == ',' ? '.' : CellBegin[i];
+		}
+		return ParseNumber(Cell, Cell + CellSize, IsFractional, Real, Frac);
+	}
+
+	// Reads all rows in one pass, every row has to have the same number of cells
+	const char* Read(bool IsFractional, CsvGrid& Grid) {
+		Grid = CsvGrid();
+		bool IsFirstRow = true;
+		while (Position < End) {
+			if (IsEmptyLine()) {
+				if (Grid.Rows > 0 && Grid.RowsBeforeGap < 0) {
+					Grid.RowsBeforeGap = Grid.Rows;
+				}
+				SkipLine();
+				continue;
+			}
+
+			const char* LineStart = Position;
+			int Cells = 0;
+			while (true) {
+				float Real = 0.0f;
+				Fraction Frac(0, 1);
+				if (const char* Error = ReadCell(IsFractional, Real, Frac)) {
+					// Names of columns
+					bool IsName = Token < End && (ProblemText::IsKeyCharacter(*Token) || (*Token == '"' && Token + 1 < End && ProblemText::IsKeyCharacter(Token[1])));
+					if (IsFirstRow && IsName) {
+						Grid.RealCells.clear();
+						Grid.FracCells.clear();
+						Cells = -1;
+						Position = LineStart;
+						SkipLine();
+						break;
+					}
+					return Error;
+				}
+				if (IsFractional) {
+					Grid.FracCells.push_back(Frac);
+				} else {
+					Grid.RealCells.push_back(Real);
+				}
+				Cells++;
+				if (Position < End && *Position == Separator) {
+					Position++;
+					continue;
+				}
+				SkipLine();
+				break;
+			}
+			IsFirstRow = false;
+			if (Cells < 0) {
+				continue;
+			}
+
+			if (Grid.Rows == 0) {
+				Grid.Columns = Cells;
+			} else if (Cells != Grid.Columns) {
+				Token = LineStart;
+				return "Rows have different numbers of cells";
+			}
+			Grid.Rows += 1;
+		}
+		return Grid.Rows > 0 ? NULL : "Text has no numbers";
+	}
+
+	void FindErrorPosition(ReadStatistics& Statistics) const {
+		ProblemText Text(Begin, End - Begin);
+		Text.Token = Token;
+		Text.FindErrorPosition(Statistics);
+	}
+};
+
+// Reads cells of text in memory. Returns NULL on success and error message otherwise
+const char* ParseCsvGrid(const char* Text, size_t Size, bool IsFractionalCoefficients, CsvGrid& Grid, ReadStatistics& Statistics) {
+	CsvText Reader(Text, Size);
+	const char* Error = Reader.Read(IsFractionalCoefficients, Grid);
+	if (Error) {
+		Reader.FindErrorPosition(Statistics);
+	}
+	Statistics.Bytes = Size;
+	Statistics.Elements = (long long)Grid.Rows * Grid.Columns;
+	return Error;
+}
+
+// Reads problem from a table of text in memory. Returns NULL on success and error message otherwise
+const char* ParseCsvProblem(const char* Text, size_t Size, bool IsFractionalCoefficients, Problem& problem, ReadStatistics& Statistics) {
+	CsvGrid Grid;
+	if (const char* Error = ParseCsvGrid(Text, Size, IsFractionalCoefficients, Grid, Statistics)) {
+		return Error;
+	}
+	int NumberOfLimitations = Grid.MatrixRows();
+	int NumberOfColumns = Grid.Columns;
+	if (Grid.Rows - NumberOfLimitations > 1) {
+		return "Only the target function may go after the empty line";
+	}
+	if (NumberOfColumns < 2 || NumberOfLimitations < 1 || NumberOfLimitations >= NumberOfColumns) {
+		return "Wrong dimensions of the problem";
+	}
+	if ((long long)(NumberOfLimitations + 1) * NumberOfColumns > MaxDenseElements) {
+		return "Problem is too big for the table of the simplex method";
+	}
+
+	problem.IsFractionalCoefficients = IsFractionalCoefficients;
+	problem.Resize(NumberOfLimitations, NumberOfColumns - 1);
+	for (int i = 0; i < Grid.Rows; i++) {
+		bool IsTargetFunction = i == NumberOfLimitations;
+		float* RealRow = IsTargetFunction ? problem.RealTargetFunction.data() : problem.RealMatrix[i];
+		Fraction* FracRow = IsTargetFunction ? problem.FractionalTargetFunction.data() : problem.FracMatrix[i];
+		if (IsFractionalCoefficients) {
+			const Fraction* Cells = &Grid.FracCells[(size_t)i * NumberOfColumns];
+			for (int j = 0; j < NumberOfColumns; j++) {
+				FracRow[j] = Cells[j];
+				RealRow[j] = (float)ToDouble(Cells[j]);
+			}
+		} else {
+			memcpy(RealRow, &Grid.RealCells[(size_t)i * NumberOfColumns], NumberOfColumns * sizeof(float));
+		}
+	}
+	return NULL;
+}
+
+// Reads a problem from a file with a table of numbers
+const char* LoadCsvProblem(const char* FileName, bool IsFractionalCoefficients, Problem& problem, ReadStatistics& Statistics) {
+	auto Start = std::chrono::steady_clock::now();
+	MappedFile File;
+	const char* Error = File.Open(FileName);
+	if (!Error) {
+		Error = ParseCsvProblem(File.Data, File.Size, IsFractionalCoefficients, problem, Statistics);
+	}
+	Statistics.Milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+	return Error;
+}
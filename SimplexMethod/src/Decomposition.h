@@ -0,0 +1,249 @@
+#pragma once
+
+// Separable problems.
+// A problem is often made of several sub-problems that have no variables in common.
+// Rows and variables are split into connected components of the graph where a row is connected
+// to every variable with non-zero coefficient in it, then every component is solved as its own problem.
+// A pivot of a block costs (rows of block) x (variables of block) instead of the whole table
+
+struct ProblemBlock {
+	std::vector<int> Rows;
+	// Numbers of variables starting from 0
+	std::vector<int> Variables;
+};
+
+static int FindRoot(std::vector<int>& Parents, int Element) {
+	while (Parents[Element] != Element) {
+		Parents[Element] = Parents[Parents[Element]];
+		Element = Parents[Element];
+	}
+	return Element;
+}
+
+static bool IsZeroCoefficient(Problem& problem, int Row, int Column) {
+	if (problem.IsFractionalCoefficients) {
+		return problem.FracMatrix[Row][Column].numerator == 0;
+	} else {
+		return fabs(problem.RealMatrix[Row][Column]) <= EPSILON;
+	}
+}
+
+// Splits problem into independent blocks. Rows without any variables and variables
+// that aren't in any row make blocks of their own
+std::vector<ProblemBlock> FindIndependentBlocks(Problem& problem) {
+	int NumberOfLimitations = problem.NumberOfLimitations;
+	int NumberOfVariables = problem.NumberOfVariables;
+
+	// Variables are joined through the first variable of every row
+	std::vector<int> Parents(NumberOfVariables);
+	for (int j = 0; j < NumberOfVariables; j++) {
+		Parents[j] = j;
+	}
+
+	std::vector<int> FirstVariables(NumberOfLimitations, -1);
+	for (int i = 0; i < NumberOfLimitations; i++) {
+		for (int j = 0; j < NumberOfVariables; j++) {
+			if (IsZeroCoefficient(problem, i, j)) {
+				continue;
+			}
+
+			if (FirstVariables[i] == -1) {
+				FirstVariables[i] = j;
+			} else {
+				int Root = FindRoot(Parents, j);
+				int FirstRoot = FindRoot(Parents, FirstVariables[i]);
+				if (Root != FirstRoot) {
+					Parents[Root] = FirstRoot;
+				}
+			}
+		}
+	}
+
+	// Blocks are numbered in order of their first variable, so the order doesn't depend on the union order
+	std::vector<ProblemBlock> Blocks;
+	std::vector<int> BlockOfRoot(NumberOfVariables, -1);
+	for (int j = 0; j < NumberOfVariables; j++) {
+		int Root = FindRoot(Parents, j);
+		if (BlockOfRoot[Root] == -1) {
+			BlockOfRoot[Root] = Blocks.size();
+			Blocks.emplace_back();
+		}
+		Blocks[BlockOfRoot[Root]].Variables.push_back(j);
+	}
+
+	for (int i = 0; i < NumberOfLimitations; i++) {
+		if (FirstVariables[i] == -1) {
+			ProblemBlock EmptyRow;
+			EmptyRow.Rows.push_back(i);
+			Blocks.push_back(EmptyRow);
+		} else {
+			Blocks[BlockOfRoot[FindRoot(Parents, FirstVariables[i])]].Rows.push_back(i);
+		}
+	}
+
+	return Blocks;
+}
+
+// Copies rows and variables of a block into a separate problem. Constant C stays in the original problem
+void MakeBlockProblem(Problem& problem, ProblemBlock& Block, Problem& BlockProblem) {
+	int LastColumn = problem.NumberOfVariables;
+	BlockProblem.IsFractionalCoefficients = problem.IsFractionalCoefficients;
+	BlockProblem.Resize(Block.Rows.size(), Block.Variables.size());
+
+	for (int i = 0; i < Block.Rows.size(); i++) {
+		for (int j = 0; j < Block.Variables.size(); j++) {
+			BlockProblem.RealMatrix[i][j] = problem.RealMatrix[Block.Rows[i]][Block.Variables[j]];
+			BlockProblem.FracMatrix[i][j] = problem.FracMatrix[Block.Rows[i]][Block.Variables[j]];
+		}
+		BlockProblem.RealMatrix[i][Block.Variables.size()] = problem.RealMatrix[Block.Rows[i]][LastColumn];
+		BlockProblem.FracMatrix[i][Block.Variables.size()] = problem.FracMatrix[Block.Rows[i]][LastColumn];
+	}
+
+	for (int j = 0; j < Block.Variables.size(); j++) {
+		BlockProblem.RealTargetFunction[j] = problem.RealTargetFunction[Block.Variables[j]];
+		BlockProblem.FractionalTargetFunction[j] = problem.FractionalTargetFunction[Block.Variables[j]];
+	}
+}
+
+// Rows "0 = 0" don't limit anything, but the simplex method takes a table with such a row for a system
+// without solutions, while the separable solution makes it a trivial block. Such rows are removed before
+// a problem is solved, so every way of solving gets the same answer. Row "0 = b" with non-zero b stays,
+// there's no solution with it either way. Returns false if there's nothing to remove and Reduced isn't filled
+bool RemoveRedundantRows(Problem& problem, Problem& Reduced) {
+	ProblemBlock Kept;
+	for (int i = 0; i < problem.NumberOfLimitations; i++) {
+		for (int j = 0; j <= problem.NumberOfVariables; j++) {
+			if (!IsZeroCoefficient(problem, i, j)) {
+				Kept.Rows.push_back(i);
+				break;
+			}
+		}
+	}
+	if (Kept.Rows.size() == problem.NumberOfLimitations) {
+		return false;
+	}
+
+	for (int j = 0; j < problem.NumberOfVariables; j++) {
+		Kept.Variables.push_back(j);
+	}
+	MakeBlockProblem(problem, Kept, Reduced);
+	Reduced.RealTargetFunction.back() = problem.RealTargetFunction.back();
+	Reduced.FractionalTargetFunction.back() = problem.FractionalTargetFunction.back();
+	Reduced.HasSolveModes = problem.HasSolveModes;
+	Reduced.IsArtificialBasis = problem.IsArtificialBasis;
+	Reduced.IsAutomatic = problem.IsAutomatic;
+	Reduced.IsMaximization = problem.IsMaximization;
+	return true;
+}
+
+// Solves a block that has no rows or no variables without any pivots
+static Solution SolveTrivialBlock(Problem& problem, ProblemBlock& Block) {
+	Solution solution;
+	solution.State = COMPLETED;
+
+	// Row with zero coefficients is either always true or never
+	for (int Row : Block.Rows) {
+		if (!IsZeroCoefficient(problem, Row, problem.NumberOfVariables)) {
+			solution.State = SOLUTION_DOESNT_EXIST;
+			return solution;
+		}
+	}
+
+	// Free variable is zero unless it decreases the function without any limit
+	for (int Variable : Block.Variables) {
+		double Coefficient = problem.IsFractionalCoefficients ? ToDouble(problem.FractionalTargetFunction[Variable]) : problem.RealTargetFunction[Variable];
+		if (Coefficient < -EPSILON) {
+			solution.State = UNLIMITED_SOLUTION;
+			return solution;
+		}
+	}
+
+	solution.X.assign(Block.Variables.size(), 0.0);
+	return solution;
+}
+
+// State of the whole problem is the worst state of its blocks
+static int StatePriority(AlgorithmState State) {
+	switch (State) {
+	case SOLUTION_DOESNT_EXIST: return 3;
+	case UNLIMITED_SOLUTION: return 2;
+	case CONTINUE: return 1;
+	default: return 0;
+	}
+}
+
+// Solves every independent block of a problem on its own and merges the answers.
+// Pivots of blocks are added up, MaxPivots limits every phase of every block.
+// A problem made of one block is solved as is
+Solution SolveSeparable(Problem& problem, int MaxPivots = 0, int Threads = 1) {
+	std::vector<ProblemBlock> Blocks = FindIndependentBlocks(problem);
+	if (Blocks.size() == 1) {
+		return SolveProblem(problem, MaxPivots);
+	}
+
+	std::vector<Solution> BlockSolutions(Blocks.size());
+	std::atomic<int> NextBlock{ 0 };
+	auto SolveBlocks = [&]() {
+		Problem BlockProblem;
+		for (int Index = NextBlock.fetch_add(1); Index < Blocks.size(); Index = NextBlock.fetch_add(1)) {
+			ProblemBlock& Block = Blocks[Index];
+			if (Block.Rows.empty() || Block.Variables.empty()) {
+				BlockSolutions[Index] = SolveTrivialBlock(problem, Block);
+			} else {
+				MakeBlockProblem(problem, Block, BlockProblem);
+				BlockSolutions[Index] = SolveProblem(BlockProblem, MaxPivots);
+			}
+		}
+	};
+
+	std::vector<std::thread> Pool;
+	for (int i = 1; i < std::min(Threads, (int)Blocks.size()); i++) {
+		Pool.emplace_back(SolveBlocks);
+	}
+	SolveBlocks();
+	for (std::thread& Thread : Pool) {
+		Thread.join();
+	}
+
+	// Merge. Pivots of blocks go one block after another with numbers of variables of the whole problem,
+	// artificial variable of a row of a block becomes the artificial variable of the row of the problem
+	Solution solution;
+	solution.State = COMPLETED;
+	for (int i = 0; i < Blocks.size(); i++) {
+		solution.ArtificialPivots += BlockSolutions[i].ArtificialPivots;
+		solution.SimplexPivots += BlockSolutions[i].SimplexPivots;
+		if (StatePriority(BlockSolutions[i].State) > StatePriority(solution.State)) {
+			solution.State = BlockSolutions[i].State;
+		}
+
+		int BlockVariables = Blocks[i].Variables.size();
+		auto ProblemVariable = [&](int Variable) {
+			return Variable <= BlockVariables ? Blocks[i].Variables[Variable - 1] + 1 : problem.NumberOfVariables + 1 + Blocks[i].Rows[Variable - BlockVariables - 1];
+		};
+		for (PivotStatistics Pivot : BlockSolutions[i].Pivots) {
+			Pivot.EnteringVariable = ProblemVariable(Pivot.EnteringVariable);
+			Pivot.LeavingVariable = ProblemVariable(Pivot.LeavingVariable);
+			solution.Pivots.push_back(Pivot);
+		}
+	}
+	if (solution.State != COMPLETED) {
+		return solution;
+	}
+
+	solution.X.assign(problem.NumberOfVariables, 0.0);
+	solution.Objective = problem.IsFractionalCoefficients ? ToDouble(problem.FractionalTargetFunction.back()) : problem.RealTargetFunction.back();
+	for (int i = 0; i < Blocks.size(); i++) {
+		for (int j = 0; j < Blocks[i].Variables.size(); j++) {
+			solution.X[Blocks[i].Variables[j]] = BlockSolutions[i].X[j];
+		}
+		for (int Variable : BlockSolutions[i].Basis) {
+			solution.Basis.push_back(Blocks[i].Variables[Variable - 1] + 1);
+		}
+		solution.Objective += BlockSolutions[i].Objective;
+	}
+	// Blocks don't know the sense of the problem, their objectives are the ones of minimization
+	if (problem.IsMaximization) {
+		solution.Objective = -solution.Objective;
+	}
+	return solution;
+}
@@ -2,8 +2,8 @@
 
 namespace GUILayer {
 
-const char* ComboBoxVariablesLabel = u8"  ";
-const char* ComboBoxLimitationsLabel = u8" ";
+const char* DimensionVariablesLabel = u8"  ";
+const char* DimensionLimitationsLabel = u8" ";
 
 static void HelpMarker(const char* desc) {
 	ImGui::PushID(desc);
@@ -18,14 +18,16 @@ static void HelpMarker(const char* desc) {
 	ImGui::PopID();
 }
 
-int ComboBox(const char *label, int FileVariables, int FileLimitations, bool FileReadHasHappened) {
-	const char* values[] = { "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12", "13", "14", "15", "16" };
+// Biggest number of variables or limitations that can be chosen
+const int MaxDimension = 1000;
+
+int DimensionInput(const char *label, int FileVariables, int FileLimitations, bool FileReadHasHappened) {
 	static int CallNumber = 0;
 	CallNumber = CallNumber == 0 ? 1 : 0;
 
-	// Align labels of comboboxes
+	// Align labels of inputs
 	ImGui::Text(label); ImGui::SameLine();
-	ImGui::SetNextItemWidth(75);
+	ImGui::SetNextItemWidth(100);
 
 	static int CallOneCurrentItem = 0;
 	static int CallTwoCurrentItem = 0;
@@ -43,7 +45,9 @@ int ComboBox(const char *label, int FileVariables, int FileLimitations, bool Fil
 	}
 	
 	ImGui::PushID(CallNumber);
-	ImGui::Combo("", CurrentItem, values, IM_ARRAYSIZE(values));
+	int Value = *CurrentItem + 1;
+	ImGui::InputInt("", &Value);
+	*CurrentItem = Clamp(Value, 1, MaxDimension) - 1;
 	ImGui::PopID();
 	return *CurrentItem + 1;
 }
@@ -68,18 +72,31 @@ Fraction FractionInput(Fraction& InputFraction) {
 	return InputFraction;
 }
 
+const float VectorCellWidth = 170.0f;
+
+// Vector input is a row of fixed width cells, only the visible cells are drawn.
+// PrintFunction(Index, Size) prints the name of one element
 template<typename VectorType, typename Proc> void InputVector(std::vector<VectorType> &Vector, std::vector<bool> *BasisActive, int Size, Proc PrintFunction) {
-	ImGui::SetNextWindowContentSize(ImVec2(ImGui::GetCursorPos().x + Size * 170.0f, 0.0f));
+	ImGui::SetNextWindowContentSize(ImVec2(ImGui::GetCursorPos().x + Size * VectorCellWidth, 0.0f));
 	ImGui::BeginChild(Vector.size(), ImVec2(0, ImGui::GetFontSize() * 4), false, ImGuiWindowFlags_HorizontalScrollbar);
-	
-	ImGui::Columns(Size);
-	
+
+	ImVec2 Origin = ImGui::GetCursorPos();
+	float ScrollX = ImGui::GetScrollX();
+	int First = std::max(0, (int)((ScrollX - Origin.x) / VectorCellWidth));
+	int Last = std::min(Size, (int)((ScrollX + ImGui::GetWindowWidth() - Origin.x) / VectorCellWidth) + 1);
+
 	// Names of variables
-	PrintFunction(Size);
+	for (int i = First; i < Last; i++) {
+		ImGui::SetCursorPos(ImVec2(Origin.x + i * VectorCellWidth, Origin.y));
+		PrintFunction(i, Size);
+	}
+	ImGui::SetCursorPos(ImVec2(Origin.x + ScrollX, Origin.y + ImGui::GetTextLineHeightWithSpacing()));
 	ImGui::Separator();
+	float InputY = ImGui::GetCursorPosY();
 
-	for (int i = 0; i < Size; i++) {
+	for (int i = First; i < Last; i++) {
 		ImGui::PushID(i);
+		ImGui::SetCursorPos(ImVec2(Origin.x + i * VectorCellWidth, InputY));
 		ImGui::SetNextItemWidth(75);
 
 		// Depeding on type of vector's element we decide how to handle input
@@ -99,101 +116,332 @@ template<typename VectorType, typename Proc> void InputVector(std::vector<Vector
 			(*BasisActive)[i] = temp;
 		}
 
-		if (i < Size - 1) { ImGui::SameLine(); }
 		ImGui::PopID();
-
-		ImGui::NextColumn();
 	}
 
-	ImGui::Columns(1);
+	// Borders between elements
+	ImDrawList* DrawList = ImGui::GetWindowDrawList();
+	ImU32 SeparatorColor = ImGui::GetColorU32(ImGuiCol_Separator);
+	ImVec2 WindowPosition = ImGui::GetWindowPos();
+	for (int i = std::max(First, 1); i < Last; i++) {
+		float x = WindowPosition.x + Origin.x + i * VectorCellWidth - ScrollX - ImGui::GetStyle().ItemSpacing.x;
+		DrawList->AddLine(ImVec2(x, WindowPosition.y + Origin.y), ImVec2(x, WindowPosition.y + InputY + ImGui::GetFrameHeight()), SeparatorColor);
+	}
 	ImGui::EndChild();
 }
 
-template<typename MatrixType>void MatrixInput(MatrixType& matrix) {
-	ImGui::Columns(matrix.ColNumber);
-	// Names of variables
-	for (int i = 0; i < matrix.ColNumber - 1; i++) {
-		ImGui::Text((std::string("x") + std::to_string(i + 1)).c_str());
-		ImGui::NextColumn();
+// Number of significant digits of real numbers, 0 shows them as they are
+int SignificantDigits = 0;
+
+static void FormatElement(char* Buffer, size_t Size, float Element) {
+	if (SignificantDigits == 0) {
+		snprintf(Buffer, Size, "%f", Element);
+	} else {
+		snprintf(Buffer, Size, "%.*g", SignificantDigits, Element);
 	}
-	ImGui::Text("B");
-	ImGui::NextColumn();
-	ImGui::Separator();
+}
 
-	// Matrix itself
-	for (int i = 0; i < matrix.RowNumber - 1; i++) {
-		for (int j = 0; j < matrix.ColNumber; j++) {
-			ImGui::PushID(i * matrix.ColNumber + j);
+static void FormatElement(char* Buffer, size_t Size, Fraction Element) {
+	if (Element.denominator != 1) {
+		// We display denominator if it doesn't equal to 1
+		snprintf(Buffer, Size, "%d/%d", Element.numerator, Element.denominator);
+	} else {
+		// We don't display denominator if it equals to 1
+		snprintf(Buffer, Size, "%d", Element.numerator);
+	}
+}
+
+// Matrix input is a grid where only the chosen cell is an input field and the rest is text.
+// Only the visible cells are drawn, so the size of the problem doesn't slow down the window.
+// Arrows, Enter and Tab move the chosen cell, Shift or mouse dragging select a range of cells,
+// Ctrl+C copies the range, Ctrl+V pastes a table of numbers from a spreadsheet (CsvFile.h).
+// Table pasted into the first cell that doesn't fit into the matrix becomes the whole problem
+struct GridSelection {
+	RowAndColumn Cursor = { 0, 0 };
+	RowAndColumn Anchor = { 0, 0 };
+	bool IsFocusRequested = false;
+};
+
+GridSelection MatrixGrid;
+const float GridCellWidth = 125.0f;
+const float GridLabelWidth = 50.0f;
+
+static float GridCellHeight() {
+	return ImGui::GetFrameHeightWithSpacing();
+}
 
-			ImGui::SetNextItemWidth(75);
-			// Depending on type of matrix we choose two different ways to handle input
-			if constexpr (std::is_same<MatrixType, Matrix>::value) {
-				// Real case
-				ImGui::InputScalar("", ImGuiDataType_Float, &matrix[i][j]);
+template<typename MatrixType> ImVec2 MatrixInputContentSize(MatrixType& matrix) {
+	ImVec2 Padding = ImGui::GetStyle().WindowPadding;
+	return ImVec2(Padding.x * 2 + GridLabelWidth + matrix.ColNumber * GridCellWidth, Padding.y * 2 + matrix.RowNumber * GridCellHeight());
+}
+
+// Clipboard is imported as a problem by the main menu, which can change the size of the problem
+bool IsClipboardImportRequested = false;
+const char* PasteError = NULL;
+
+// Copies cells of the table into the matrix starting from a cell, cells that don't fit into the matrix are skipped
+template<typename MatrixType> void PasteIntoMatrix(MatrixType& matrix, const CsvGrid& Grid, RowAndColumn Start) {
+	int Rows = std::min(Grid.Rows, matrix.RowNumber - 1 - Start.Row);
+	int Columns = std::min(Grid.Columns, matrix.ColNumber - Start.Column);
+	for (int i = 0; i < Rows; i++) {
+		for (int j = 0; j < Columns; j++) {
+			if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
+				matrix[Start.Row + i][Start.Column + j] = Grid.RealCells[(size_t)i * Grid.Columns + j];
 			} else {
-				// Fractional case
-				matrix[i][j] = FractionInput(matrix[i][j]);
+				matrix[Start.Row + i][Start.Column + j] = Grid.FracCells[(size_t)i * Grid.Columns + j];
 			}
-			if (j < matrix.ColNumber - 1) { ImGui::SameLine(); }
-
-			ImGui::PopID();
-			
-			ImGui::NextColumn();
 		}
-		ImGui::Separator();
 	}
+}
 
-	ImGui::Columns(1);
+// Copies range of cells as rows separated by tabs
+template<typename MatrixType> void CopyFromMatrix(MatrixType& matrix, RowAndColumn First, RowAndColumn Last) {
+	ImGuiTextBuffer Text;
+	for (int i = First.Row; i <= Last.Row; i++) {
+		for (int j = First.Column; j <= Last.Column; j++) {
+			if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
+				Text.appendf("%.9g", matrix[i][j]);
+			} else {
+				Text.appendf(matrix[i][j].denominator != 1 ? "%d/%d" : "%d", matrix[i][j].numerator, matrix[i][j].denominator);
+			}
+			Text.append(j < Last.Column ? "\t" : "\n");
+		}
+	}
+	ImGui::SetClipboardText(Text.c_str());
 }
 
-template<typename MatrixType> void DisplaySolutionVector(MatrixType &matrix, std::vector<int> &BaseVariables, int TotalSize, bool IsCompleteSolution) {
-	ImGui::Columns(TotalSize);
-	for (int i = 0; i < TotalSize; i++) {
-		ImGui::Text((std::string("x") + std::to_string(i + 1)).c_str());
-		ImGui::NextColumn();
+template<typename MatrixType>void MatrixInput(MatrixType& matrix) {
+	ImGuiIO& io = ImGui::GetIO();
+	GridSelection& Grid = MatrixGrid;
+	int Rows = matrix.RowNumber - 1;
+	int Columns = matrix.ColNumber;
+	float CellHeight = GridCellHeight();
+
+	// Size of the matrix could have been changed
+	Grid.Cursor.Row = Clamp(Grid.Cursor.Row, 0, Rows - 1);
+	Grid.Cursor.Column = Clamp(Grid.Cursor.Column, 0, Columns - 1);
+	Grid.Anchor.Row = Clamp(Grid.Anchor.Row, 0, Rows - 1);
+	Grid.Anchor.Column = Clamp(Grid.Anchor.Column, 0, Columns - 1);
+
+	RowAndColumn First = { std::min(Grid.Cursor.Row, Grid.Anchor.Row), std::min(Grid.Cursor.Column, Grid.Anchor.Column) };
+	RowAndColumn Last = { std::max(Grid.Cursor.Row, Grid.Anchor.Row), std::max(Grid.Cursor.Column, Grid.Anchor.Column) };
+	bool IsRangeSelected = First.Row != Last.Row || First.Column != Last.Column;
+
+	// Keys that change the matrix or the chosen cell
+	bool IsInputHidden = false;
+	if (ImGui::IsWindowFocused()) {
+		if (io.KeyCtrl && ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_V))) {
+			// Text without separators is pasted into the input field itself
+			const char* Text = ImGui::GetClipboardText();
+			if (Text && strpbrk(Text, "\t,;\n")) {
+				CsvGrid Grid;
+				ReadStatistics Statistics;
+				if (const char* Error = ParseCsvGrid(Text, strlen(Text), IS_SAME_TYPE(MatrixType, FractionalMatrix), Grid, Statistics)) {
+					PasteError = Error;
+				} else if (!IsRangeSelected && First.Row == 0 && First.Column == 0 && (Grid.MatrixRows() > Rows || Grid.Columns > Columns)) {
+					IsClipboardImportRequested = true;
+				} else {
+					PasteIntoMatrix(matrix, Grid, First);
+				}
+				IsInputHidden = true;
+			}
+		}
+
+		if (IsRangeSelected && ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_Delete))) {
+			for (int i = First.Row; i <= Last.Row; i++) {
+				for (int j = First.Column; j <= Last.Column; j++) {
+					if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
+						matrix[i][j] = 0.0f;
+					} else {
+						matrix[i][j] = Fraction(0, 1);
+					}
+				}
+			}
+			IsInputHidden = true;
+		}
+
+		// Left and right move the text cursor while a cell is edited
+		RowAndColumn Move = { 0, 0 };
+		bool IsEditing = ImGui::IsAnyItemActive();
+		if (ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_UpArrow))) { Move.Row = -1; }
+		if (ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_DownArrow)) || ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_Enter))) { Move.Row = 1; }
+		if ((!IsEditing || io.KeyShift) && ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_LeftArrow))) { Move.Column = -1; }
+		if ((!IsEditing || io.KeyShift) && ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_RightArrow))) { Move.Column = 1; }
+		if (ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_Tab))) { Move.Column = io.KeyShift ? -1 : 1; }
+
+		if (Move.Row != 0 || Move.Column != 0) {
+			Grid.Cursor.Row = Clamp(Grid.Cursor.Row + Move.Row, 0, Rows - 1);
+			Grid.Cursor.Column = Clamp(Grid.Cursor.Column + Move.Column, 0, Columns - 1);
+			if (!io.KeyShift || ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_Tab))) {
+				Grid.Anchor = Grid.Cursor;
+			}
+			Grid.IsFocusRequested = true;
+			IsInputHidden = true;
+
+			// Keep the chosen cell visible
+			float CellX = GridLabelWidth + Grid.Cursor.Column * GridCellWidth;
+			float CellY = (Grid.Cursor.Row + 1) * CellHeight;
+			if (CellX < ImGui::GetScrollX()) {
+				ImGui::SetScrollX(CellX);
+			} else if (CellX + GridCellWidth > ImGui::GetScrollX() + ImGui::GetWindowWidth()) {
+				ImGui::SetScrollX(CellX + GridCellWidth - ImGui::GetWindowWidth());
+			}
+			if (CellY < ImGui::GetScrollY() + CellHeight) {
+				ImGui::SetScrollY(CellY - CellHeight);
+			} else if (CellY + CellHeight > ImGui::GetScrollY() + ImGui::GetWindowHeight()) {
+				ImGui::SetScrollY(CellY + CellHeight - ImGui::GetWindowHeight());
+			}
+		}
 	}
-	ImGui::Separator();
 
-	// Display resulting vector
-	int LastColumnIndex = matrix.ColNumber - 1;
-	for (int i = 0, BVCounter = 0; i < TotalSize; i++) {
-		if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
-			if (BVCounter < BaseVariables.size() && i + 1 == BaseVariables[BVCounter]) {
-				ImGui::Text(std::to_string(matrix[BVCounter][LastColumnIndex]).c_str());
-				BVCounter += 1;
-			} else {
-				ImGui::Text(std::to_string(0.0f).c_str());
+	// Visible part of the grid, row 0 and column 0 are names
+	ImVec2 Origin = ImGui::GetCursorPos();
+	float ScrollX = ImGui::GetScrollX();
+	float ScrollY = ImGui::GetScrollY();
+	int FirstRow = std::max(0, (int)((ScrollY - Origin.y) / CellHeight));
+	int LastRow = std::min(Rows + 1, (int)((ScrollY + ImGui::GetWindowHeight() - Origin.y) / CellHeight) + 1);
+	int FirstColumn = std::max(0, (int)((ScrollX - Origin.x - GridLabelWidth) / GridCellWidth));
+	int LastColumn = std::min(Columns, (int)((ScrollX + ImGui::GetWindowWidth() - Origin.x - GridLabelWidth) / GridCellWidth) + 1);
+
+	char Label[64];
+	for (int Row = FirstRow; Row < LastRow; Row++) {
+		int i = Row - 1;
+
+		// Number of limitation
+		if (Row > 0 && ScrollX < Origin.x + GridLabelWidth) {
+			ImGui::SetCursorPos(ImVec2(Origin.x, Origin.y + Row * CellHeight));
+			ImGui::Text("%d", Row);
+		}
+
+		for (int j = FirstColumn; j < LastColumn; j++) {
+			ImGui::SetCursorPos(ImVec2(Origin.x + GridLabelWidth + j * GridCellWidth, Origin.y + Row * CellHeight));
+
+			// Names of variables
+			if (Row == 0) {
+				if (j < Columns - 1) {
+					ImGui::Text("x%d", j + 1);
+				} else {
+					ImGui::Text("B");
+				}
+				continue;
 			}
-		} else {
-			if (BVCounter < BaseVariables.size() && i + 1 == BaseVariables[BVCounter]) {
-				if (matrix[BVCounter][LastColumnIndex].denominator != 1) {
-					// We display denominator if it doesn't equal to 1
-					ImGui::Text((std::to_string(matrix[BVCounter][LastColumnIndex].numerator) + std::string("/") + std::to_string(matrix[BVCounter][LastColumnIndex].denominator)).c_str());
+
+			ImGui::PushID(i * Columns + j);
+			if (i == Grid.Cursor.Row && j == Grid.Cursor.Column && !IsInputHidden) {
+				if (Grid.IsFocusRequested) {
+					ImGui::SetKeyboardFocusHere();
+					Grid.IsFocusRequested = false;
+				}
+
+				// Depending on type of matrix we choose two different ways to handle input
+				if constexpr (std::is_same<MatrixType, Matrix>::value) {
+					// Real case
+					ImGui::SetNextItemWidth(GridCellWidth - ImGui::GetStyle().ItemSpacing.x);
+					ImGui::InputScalar("", ImGuiDataType_Float, &matrix[i][j]);
 				} else {
-					// We don't display denominator if it equals to 1
-					ImGui::Text((std::to_string(matrix[BVCounter][LastColumnIndex].numerator)).c_str());
+					// Fractional case
+					matrix[i][j] = FractionInput(matrix[i][j]);
 				}
-				BVCounter += 1;
 			} else {
-				ImGui::Text("0");
+				bool IsSelected = i >= First.Row && i <= Last.Row && j >= First.Column && j <= Last.Column;
+				FormatElement(Label, sizeof(Label), matrix[i][j]);
+				if (ImGui::Selectable(Label, IsSelected, 0, ImVec2(GridCellWidth - ImGui::GetStyle().ItemSpacing.x, ImGui::GetFrameHeight()))) {
+					Grid.Cursor = { i, j };
+					if (!io.KeyShift) {
+						Grid.Anchor = Grid.Cursor;
+					}
+					Grid.IsFocusRequested = true;
+				} else if (ImGui::IsMouseDragging(0) && ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenBlockedByActiveItem)) {
+					Grid.Cursor = { i, j };
+				}
 			}
+			ImGui::PopID();
 		}
-		ImGui::NextColumn();
 	}
 
+	// Range is copied after the input field, which copies its own text on Ctrl+C
+	if (IsRangeSelected && ImGui::IsWindowFocused() && io.KeyCtrl && ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_C))) {
+		CopyFromMatrix(matrix, First, Last);
+	}
+
+	// Grid of the visible part
+	ImDrawList* DrawList = ImGui::GetWindowDrawList();
+	ImU32 SeparatorColor = ImGui::GetColorU32(ImGuiCol_Separator);
+	ImVec2 ScreenOrigin = ImVec2(ImGui::GetWindowPos().x + Origin.x + GridLabelWidth - ScrollX, ImGui::GetWindowPos().y + Origin.y - ScrollY);
+	float Left = ScreenOrigin.x - GridLabelWidth;
+	float Right = ScreenOrigin.x + LastColumn * GridCellWidth;
+	for (int Row = std::max(FirstRow, 1); Row <= LastRow; Row++) {
+		float y = ScreenOrigin.y + Row * CellHeight - ImGui::GetStyle().ItemSpacing.y * 0.5f;
+		DrawList->AddLine(ImVec2(Left, y), ImVec2(Right, y), SeparatorColor);
+	}
+
+	// Whole grid is the content of the window
+	ImGui::SetCursorPos(ImVec2(Origin.x, Origin.y + (Rows + 1) * CellHeight));
+}
+
+const float SolutionCellWidth = 110.0f;
+
+// Solution vector is a row of fixed width cells in its own scrolled region, only the visible cells are drawn.
+// Rows of the matrix are in order of BaseVariables, which are sorted.
+// Table of a maximization problem minimizes -f, so its corner holds the maximum itself
+template<typename MatrixType> void DisplaySolutionVector(MatrixType &matrix, std::vector<int> &BaseVariables, int TotalSize, bool IsCompleteSolution, bool IsMaximization = false) {
+	char Label[64];
+	ImGuiStyle& Style = ImGui::GetStyle();
+	float LineHeight = ImGui::GetTextLineHeightWithSpacing();
+	ImGui::SetNextWindowContentSize(ImVec2(TotalSize * SolutionCellWidth, 0.0f));
+	ImGui::BeginChild("Solution Vector", ImVec2(0.0f, LineHeight * 2 + Style.ItemSpacing.y * 2 + Style.ScrollbarSize), false, ImGuiWindowFlags_HorizontalScrollbar);
+
+	ImVec2 Origin = ImGui::GetCursorPos();
+	float ScrollX = ImGui::GetScrollX();
+	int First = std::max(0, (int)((ScrollX - Origin.x) / SolutionCellWidth));
+	int Last = std::min(TotalSize, (int)((ScrollX + ImGui::GetWindowWidth() - Origin.x) / SolutionCellWidth) + 1);
+
+	for (int i = First; i < Last; i++) {
+		snprintf(Label, sizeof(Label), "x%d", i + 1);
+		ImGui::SetCursorPos(ImVec2(Origin.x + i * SolutionCellWidth, Origin.y));
+		ImGui::TextUnformatted(Label);
+	}
+	ImGui::SetCursorPos(ImVec2(Origin.x + ScrollX, Origin.y + LineHeight));
 	ImGui::Separator();
-	ImGui::Columns(1);
+	float ValueY = ImGui::GetCursorPosY();
+
+	// Variables that aren't in basis are zero
+	std::remove_reference_t<decltype(matrix[0][0])> ZeroElement;
+	if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
+		ZeroElement = 0.0f;
+	} else {
+		ZeroElement = Fraction(0, 1);
+	}
+
+	// Display resulting vector
+	int LastColumnIndex = matrix.ColNumber - 1;
+	int BVCounter = std::lower_bound(BaseVariables.begin(), BaseVariables.end(), First + 1) - BaseVariables.begin();
+	for (int i = First; i < Last; i++) {
+		if (BVCounter < BaseVariables.size() && i + 1 == BaseVariables[BVCounter]) {
+			FormatElement(Label, sizeof(Label), matrix[BVCounter][LastColumnIndex]);
+			BVCounter += 1;
+		} else {
+			FormatElement(Label, sizeof(Label), ZeroElement);
+		}
+		ImGui::SetCursorPos(ImVec2(Origin.x + i * SolutionCellWidth, ValueY));
+		ImGui::TextUnformatted(Label);
+	}
+	ImGui::SetCursorPos(ImVec2(Origin.x + ScrollX, ValueY + LineHeight));
+	ImGui::Separator();
+	ImGui::EndChild();
 
 	if (IsCompleteSolution) {
+		const char* ValueLabel = IsMaximization ? u8"  " : u8"  ";
+		int Sign = IsMaximization ? 1 : -1;
 		if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
 			// Real case
-			ImGui::Text(u8"  : F(x)= %f", -matrix[matrix.RowNumber - 1][matrix.ColNumber - 1]);
+			ImGui::Text(u8"%s: F(x)= %f", ValueLabel, Sign * matrix[matrix.RowNumber - 1][matrix.ColNumber - 1]);
 		} else {
 			// Fractional case
 			if (matrix[matrix.RowNumber - 1][matrix.ColNumber - 1].denominator != 1) {
-				ImGui::Text(u8"  : F(x)= %d/%d", -matrix[matrix.RowNumber - 1][matrix.ColNumber - 1].numerator, matrix[matrix.RowNumber - 1][matrix.ColNumber - 1].denominator);
+				ImGui::Text(u8"%s: F(x)= %d/%d", ValueLabel, Sign * matrix[matrix.RowNumber - 1][matrix.ColNumber - 1].numerator, matrix[matrix.RowNumber - 1][matrix.ColNumber - 1].denominator);
 			} else {
-				ImGui::Text(u8"  : F(x)= %d", -matrix[matrix.RowNumber - 1][matrix.ColNumber - 1].numerator);
+				ImGui::Text(u8"%s: F(x)= %d", ValueLabel, Sign * matrix[matrix.RowNumber - 1][matrix.ColNumber - 1].numerator);
 			}
 		}
 	}
@@ -201,115 +449,539 @@ template<typename MatrixType> void DisplaySolutionVector(MatrixType &matrix, std
 
 RowAndColumn CurrentLeadPos;
 std::vector<RowAndColumn> PotentialLeads;
-template<typename MatrixType> void DisplayStepOnScreen(MatrixType& matrix, int StepID, bool IsLastIteration, std::vector<int> NumbersOfVariables) {
-	ImDrawList* DrawList = ImGui::GetWindowDrawList();
 
-	ImGui::NewLine();
-	ImGui::Separator();
-	ImGui::NewLine();
+// Tables of steps have cells of one size, so only the cells inside the visible part of the window are drawn
+const float StepCellWidth = 110.0f;
 
-	ImGui::Columns(matrix.ColNumber + 1);
+static float StepCellHeight() {
+	return ImGui::GetTextLineHeight() * 1.3f + ImGui::GetStyle().ItemSpacing.y;
+}
 
-	ImGui::Text((std::string("#") + std::to_string(StepID)).c_str());
-	ImGui::NextColumn();
+// Height of a step with the gap above it
+static float StepHeight(int RowNumber) {
+	return ImGui::GetTextLineHeightWithSpacing() * 2 + (RowNumber + 1) * StepCellHeight();
+}
 
-	// Display free variables
-	// Only suitable for simplex algorithm's steps
-	for (int i = 0; i < matrix.ColNumber - 1; i++) {
-		ImGui::Text((std::string("x") + std::to_string(NumbersOfVariables[(matrix.RowNumber - 1) + i])).c_str());
-		ImGui::NextColumn();
+// Overview of big tables: the last step is shown as a heatmap where an element is a square of OverviewZoom pixels.
+// Zooming in with Ctrl and mouse wheel up to CellZoom turns it into the usual table and zooming out turns it back
+bool IsOverviewEnabled = true;
+const int OverviewMinColumns = 40;
+const float CellZoom = 24.0f;
+float OverviewZoom = 4.0f;
+Heatmap Overview;
+// Element of the last step that was under the mouse when the overview turned into the table.
+// Table is scrolled to its cell in the next frame, when the size of the table is known
+bool IsZoomedCellPending = false;
+RowAndColumn ZoomedCell;
+ImVec2 ZoomedCellMouse;
+
+static bool IsOverviewShown(std::vector<Step>& Steps, int StartIndex, bool IsFractionalCoefficients) {
+	if (!IsOverviewEnabled || Steps.size() <= StartIndex) {
+		return false;
 	}
-	ImGui::NextColumn();
-	ImGui::Separator();
-	for (int i = 0; i < matrix.RowNumber; i++) {
-		// Do not display variable name for the last row
-		if (i < matrix.RowNumber - 1) {
-			ImGui::Text((std::string("x") + std::to_string(NumbersOfVariables[i])).c_str());
-			ImGui::NextColumn();
-		}
-		for (int j = 0; j < matrix.ColNumber; j++) {
-			if (j == 0 && i == matrix.RowNumber - 1) {
-				ImGui::NextColumn();
-			}
+	Step& LastStep = Steps.back();
+	int ColNumber = IsFractionalCoefficients ? LastStep.FracMatrix.ColNumber : LastStep.RealMatrix.ColNumber;
+	return ColNumber >= OverviewMinColumns && OverviewZoom < CellZoom;
+}
 
-			// Checking algorithm state
-			AlgorithmState state = CheckAlgorithmState(matrix, false, false);
-			
-			std::string CellLabel;
-			// Labels
-			if constexpr (std::is_same<MatrixType, Matrix>::value) {
-				// Real case
-				CellLabel = std::to_string(matrix[i][j]);
-			} else {
-				// Fractional case
-				if (matrix[i][j].denominator != 1) {
-					// We display denominator if it doesn't equal to 1
-					CellLabel = (std::to_string(matrix[i][j].numerator) + std::string("/") + std::to_string(matrix[i][j].denominator));
-				} else {
-					// We don't display denominator if it equals to 1
-					CellLabel = (std::to_string(matrix[i][j].numerator));
+// Width of the widest step, to be set as width of the window content
+float StepsContentWidth(std::vector<Step>& Steps, bool IsFractionalCoefficients) {
+	if (IsOverviewShown(Steps, 0, IsFractionalCoefficients)) {
+		Step& LastStep = Steps.back();
+		return ImGui::GetStyle().WindowPadding.x * 2 + (IsFractionalCoefficients ? LastStep.FracMatrix.ColNumber : LastStep.RealMatrix.ColNumber) * OverviewZoom;
+	}
+
+	int MaxColNumber = 0;
+	for (Step& step : Steps) {
+		MaxColNumber = std::max(MaxColNumber, IsFractionalCoefficients ? step.FracMatrix.ColNumber : step.RealMatrix.ColNumber);
+	}
+	return ImGui::GetStyle().WindowPadding.x * 2 + (MaxColNumber + 1) * StepCellWidth;
+}
+
+// Label of a step: cells of the matrix row by row, then names of variables and number of the step.
+// Only cells on the screen are formatted, so the first frame of a big step doesn't format the whole table.
+// Pointer is valid until the next label of the step is made
+template<typename MatrixType> const char* StepLabel(Step& step, MatrixType& matrix, int Index) {
+	if (!step.Labels.Has(Index)) {
+		char Label[64];
+		int VariablesLabels = matrix.RowNumber * matrix.ColNumber;
+		if (Index < VariablesLabels) {
+			FormatElement(Label, sizeof(Label), matrix[Index / matrix.ColNumber][Index % matrix.ColNumber]);
+		} else if (Index < VariablesLabels + step.NumbersOfVariables.size()) {
+			snprintf(Label, sizeof(Label), "x%d", step.NumbersOfVariables[Index - VariablesLabels]);
+		} else {
+			snprintf(Label, sizeof(Label), "#%d", step.StepID);
+		}
+		step.Labels.Set(Index, Label);
+	}
+	return step.Labels[Index];
+}
+
+// Draws the table of a step starting from the cursor position.
+// Column 0 and row 0 of the table are names of variables, the rest is the matrix
+template<typename MatrixType> void DisplayStepOnScreen(Step& step, MatrixType& matrix, bool IsLastIteration) {
+	int VariablesLabels = matrix.RowNumber * matrix.ColNumber;
+	if (!step.Labels.IsBuilt(SignificantDigits)) {
+		step.Labels.Reset(VariablesLabels + step.NumbersOfVariables.size() + 1, SignificantDigits);
+	}
+
+	ImDrawList* DrawList = ImGui::GetWindowDrawList();
+	ImU32 SeparatorColor = ImGui::GetColorU32(ImGuiCol_Separator);
+	float CellHeight = StepCellHeight();
+
+	ImVec2 Origin = ImGui::GetCursorPos();
+	Origin.y += ImGui::GetTextLineHeightWithSpacing() * 2;
+	int TableRows = matrix.RowNumber + 1;
+	int TableColumns = matrix.ColNumber + 1;
+
+	// Visible part of the table
+	float ScrollX = ImGui::GetScrollX();
+	float ScrollY = ImGui::GetScrollY();
+	int FirstRow = std::max(0, (int)((ScrollY - Origin.y) / CellHeight));
+	int LastRow = std::min(TableRows, (int)((ScrollY + ImGui::GetWindowHeight() - Origin.y) / CellHeight) + 1);
+	int FirstColumn = std::max(0, (int)((ScrollX - Origin.x) / StepCellWidth));
+	int LastColumn = std::min(TableColumns, (int)((ScrollX + ImGui::GetWindowWidth() - Origin.x) / StepCellWidth) + 1);
+
+	// State is the same for every cell, buttons are shown only for the last step
+	bool IsWaitingForLead = IsLastIteration && CheckAlgorithmState(matrix, false, false) == CONTINUE;
+
+	for (int Row = FirstRow; Row < LastRow; Row++) {
+		for (int Column = FirstColumn; Column < LastColumn; Column++) {
+			// Matrix element of the cell, if there's one
+			int i = Row - 1;
+			int j = Column - 1;
+
+			const char* CellLabel = "";
+			if (Row == 0 && Column == 0) {
+				CellLabel = StepLabel(step, matrix, VariablesLabels + step.NumbersOfVariables.size());
+			} else if (Row == 0) {
+				// Free variables, there's no name for vector B
+				if (j < matrix.ColNumber - 1) {
+					CellLabel = StepLabel(step, matrix, VariablesLabels + (matrix.RowNumber - 1) + j);
+				}
+			} else if (Column == 0) {
+				// Do not display variable name for the last row
+				if (i < matrix.RowNumber - 1) {
+					CellLabel = StepLabel(step, matrix, VariablesLabels + i);
 				}
+			} else {
+				CellLabel = StepLabel(step, matrix, i * matrix.ColNumber + j);
 			}
 
+			ImGui::SetCursorPos(ImVec2(Origin.x + Column * StepCellWidth + ImGui::GetStyle().ItemSpacing.x, Origin.y + Row * CellHeight));
+
 			// Fill with a color chosen cell
 			bool IsThisCellShouldBeButton = false;
-			if (state == CONTINUE) {
-				float width = ImGui::GetColumnWidth();
-				
+			if (IsWaitingForLead && Row > 0 && Column > 0) {
 				for (RowAndColumn ElementRC : PotentialLeads) {
-					if (ElementRC.Row == i && ElementRC.Column == j && IsLastIteration) {
-						ImGui::PushID(j + i * matrix.ColNumber);
-						if ((ElementRC.Row == CurrentLeadPos.Row && ElementRC.Column == CurrentLeadPos.Column)) {
-							ImGui::PushStyleColor(ImGuiCol_Button, ImVec4((float)249 / 255, (float)105 / 255, (float)14 / 255, 1.0f));
-							ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4((float)249 / 255, (float)105 / 255, (float)14 / 255, 1.0f));
-							ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4((float)211 / 255, (float)84 / 255, (float)0 / 255, 1.0f));
-							if (ImGui::Button(CellLabel.c_str(), ImVec2(width - 15.0f, ImGui::GetTextLineHeight() * 1.3f))) {
-								CurrentLeadPos = ElementRC;
-							}
-							ImGui::PopStyleColor(); ImGui::PopStyleColor(); ImGui::PopStyleColor();
-						} else {
-							ImGui::PushStyleColor(ImGuiCol_Button, ImVec4((float)249 / 255, (float)191 / 255, (float)59 / 255, 1.0f));
-							ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4((float)249 / 255, (float)105 / 255, (float)14 / 255, 1.0f));
-							ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4((float)211 / 255, (float)84 / 255, (float)0 / 255, 1.0f));
-							if (ImGui::Button(CellLabel.c_str(), ImVec2(width - 15.0f, ImGui::GetTextLineHeight() * 1.3f))) {
-								CurrentLeadPos = ElementRC;
-							}
-							ImGui::PopStyleColor(); ImGui::PopStyleColor(); ImGui::PopStyleColor();
-						}
-						ImGui::PopID();
+					if (ElementRC.Row != i || ElementRC.Column != j) {
+						continue;
+					}
 
-						IsThisCellShouldBeButton = true;
+					ImGui::PushID(j + i * matrix.ColNumber);
+					if ((ElementRC.Row == CurrentLeadPos.Row && ElementRC.Column == CurrentLeadPos.Column)) {
+						ImGui::PushStyleColor(ImGuiCol_Button, ImVec4((float)249 / 255, (float)105 / 255, (float)14 / 255, 1.0f));
+					} else {
+						ImGui::PushStyleColor(ImGuiCol_Button, ImVec4((float)249 / 255, (float)191 / 255, (float)59 / 255, 1.0f));
+					}
+					ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4((float)249 / 255, (float)105 / 255, (float)14 / 255, 1.0f));
+					ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4((float)211 / 255, (float)84 / 255, (float)0 / 255, 1.0f));
+					if (ImGui::Button(CellLabel, ImVec2(StepCellWidth - 15.0f, ImGui::GetTextLineHeight() * 1.3f))) {
+						CurrentLeadPos = ElementRC;
 					}
+					ImGui::PopStyleColor(); ImGui::PopStyleColor(); ImGui::PopStyleColor();
+					ImGui::PopID();
+
+					IsThisCellShouldBeButton = true;
+					break;
 				}
 			}
 
 			// We already have text for this cell
 			if (!IsThisCellShouldBeButton) {
-				ImGui::Text(CellLabel.c_str());
+				ImGui::TextUnformatted(CellLabel);
 			}
+		}
+	}
+
+	// Grid of the visible part
+	ImVec2 ScreenOrigin = ImVec2(ImGui::GetWindowPos().x + Origin.x - ScrollX, ImGui::GetWindowPos().y + Origin.y - ScrollY);
+	float Left = ScreenOrigin.x + FirstColumn * StepCellWidth;
+	float Right = ScreenOrigin.x + LastColumn * StepCellWidth;
+	float Top = ScreenOrigin.y + FirstRow * CellHeight;
+	float Bottom = ScreenOrigin.y + LastRow * CellHeight;
+
+	// Separator between steps
+	float SeparatorY = ScreenOrigin.y - ImGui::GetTextLineHeightWithSpacing();
+	DrawList->AddLine(ImVec2(ImGui::GetWindowPos().x, SeparatorY), ImVec2(ImGui::GetWindowPos().x + ImGui::GetWindowWidth(), SeparatorY), SeparatorColor);
+	for (int Row = std::max(FirstRow, 1); Row < std::min(LastRow + 1, TableRows); Row++) {
+		float y = ScreenOrigin.y + Row * CellHeight - ImGui::GetStyle().ItemSpacing.y * 0.5f;
+		DrawList->AddLine(ImVec2(Left, y), ImVec2(Right, y), SeparatorColor);
+	}
+	for (int Column = std::max(FirstColumn, 1); Column < std::min(LastColumn + 1, TableColumns); Column++) {
+		float x = ScreenOrigin.x + Column * StepCellWidth;
+		DrawList->AddLine(ImVec2(x, Top), ImVec2(x, Bottom), SeparatorColor);
+	}
+}
+
+// Changes zoom with Ctrl and mouse wheel keeping the point under the mouse in place.
+// Called before the overview of a table of RowNumber x ColNumber elements is drawn
+static void ZoomOverview(int RowNumber, int ColNumber) {
+	ImGuiIO& io = ImGui::GetIO();
+	if (!io.KeyCtrl || io.MouseWheel == 0.0f || !ImGui::IsWindowHovered()) {
+		return;
+	}
+
+	float OldZoom = OverviewZoom;
+	OverviewZoom = std::max(0.25f, OverviewZoom * powf(1.2f, io.MouseWheel));
+	ImVec2 Mouse = ImVec2(io.MousePos.x - ImGui::GetWindowPos().x, io.MousePos.y - ImGui::GetWindowPos().y);
+	if (OldZoom < CellZoom && OverviewZoom >= CellZoom) {
+		// Heatmap starts under the number of the step
+		ImVec2 Image = ImGui::GetCursorScreenPos();
+		Image.y += ImGui::GetTextLineHeightWithSpacing();
+		ZoomedCell.Row = Clamp((int)((io.MousePos.y - Image.y) / OldZoom), 0, RowNumber - 1);
+		ZoomedCell.Column = Clamp((int)((io.MousePos.x - Image.x) / OldZoom), 0, ColNumber - 1);
+		ZoomedCellMouse = Mouse;
+		IsZoomedCellPending = true;
+		return;
+	}
+
+	float Ratio = OverviewZoom / OldZoom;
+	ImGui::SetScrollX((ImGui::GetScrollX() + Mouse.x) * Ratio - Mouse.x);
+	ImGui::SetScrollY((ImGui::GetScrollY() + Mouse.y) * Ratio - Mouse.y);
+}
+
+// Heatmap of the last step with its lead row and column
+template<typename MatrixType> void DisplayOverview(Step& step, MatrixType& matrix, bool IsLeadShown) {
+	Overview.Update(matrix);
+
+	char Label[64];
+	snprintf(Label, sizeof(Label), "#%d", step.StepID);
+	ImGui::TextUnformatted(Label);
+
+	ImVec2 Position = ImGui::GetCursorScreenPos();
+	ImGui::Image((ImTextureID)(intptr_t)Overview.Texture, ImVec2(matrix.ColNumber * OverviewZoom, matrix.RowNumber * OverviewZoom), ImVec2(0.0f, 0.0f), ImVec2(Overview.MaxU, Overview.MaxV));
 
-			ImGui::NextColumn();
+	ImDrawList* DrawList = ImGui::GetWindowDrawList();
+	if (IsLeadShown) {
+		ImU32 LeadColor = IM_COL32(249, 105, 14, 90);
+		float Row = Position.y + CurrentLeadPos.Row * OverviewZoom;
+		float Column = Position.x + CurrentLeadPos.Column * OverviewZoom;
+		DrawList->AddRectFilled(ImVec2(Position.x, Row), ImVec2(Position.x + matrix.ColNumber * OverviewZoom, Row + OverviewZoom), LeadColor);
+		DrawList->AddRectFilled(ImVec2(Column, Position.y), ImVec2(Column + OverviewZoom, Position.y + matrix.RowNumber * OverviewZoom), LeadColor);
+	}
+
+	// Element under the mouse, click on a potential lead element chooses it
+	if (ImGui::IsItemHovered()) {
+		ImVec2 Mouse = ImGui::GetIO().MousePos;
+		int i = Clamp((int)((Mouse.y - Position.y) / OverviewZoom), 0, matrix.RowNumber - 1);
+		int j = Clamp((int)((Mouse.x - Position.x) / OverviewZoom), 0, matrix.ColNumber - 1);
+		if (IsLeadShown && ImGui::IsMouseClicked(0)) {
+			for (RowAndColumn ElementRC : PotentialLeads) {
+				if (ElementRC.Row == i && ElementRC.Column == j) {
+					CurrentLeadPos = ElementRC;
+				}
+			}
 		}
-		if (i != matrix.RowNumber - 1) {
-			ImGui::Separator();
+		FormatElement(Label, sizeof(Label), matrix[i][j]);
+		ImGui::BeginTooltip();
+		ImGui::Text(u8" %d,  %d: %s", i + 1, j + 1, Label);
+		ImGui::EndTooltip();
+	}
+}
+
+// Number of tables kept in automatic mode after the first one, older steps are kept as summaries.
+// 0 keeps all tables
+int KeptTables = 0;
+
+// File the automatic solution is traced into (StepTrace.h), empty if the solution isn't traced.
+// Whole table goes into the trace every TraceTableInterval steps
+std::string TraceFileName;
+int TraceTableInterval = 100;
+const char* TraceError = NULL;
+
+// Summaries that don't continue into the steps are left from a solution that has been reset
+void ForgetStaleSummaries(std::vector<Step>& Steps, int StartIndex, StepSummaries& Summaries) {
+	std::vector<StepSummary>& Rows = Summaries.Rows;
+	if (!Rows.empty() && (Steps.size() <= StartIndex + 1 || Steps[StartIndex + 1].StepID != Rows.back().StepID + 1)) {
+		Rows.clear();
+	}
+}
+
+// Adds summaries of steps after StartIndex and before End, the steps themselves stay
+void SummarizeSteps(std::vector<Step>& Steps, int StartIndex, int End, StepSummaries& Summaries, bool IsFractionalCoefficients) {
+	std::vector<StepSummary>& Rows = Summaries.Rows;
+	if (End <= StartIndex + 1) {
+		return;
+	}
+	bool IsFirstStepKept = Rows.empty();
+	for (int i = StartIndex + 1; i < End; i++) {
+		// Step before the first one after StartIndex has been summarized already
+		std::vector<int>& PreviousVariables = (i == StartIndex + 1 && !IsFirstStepKept) ? Summaries.LastVariables : Steps[i - 1].NumbersOfVariables;
+		int Row = Steps[i].StepChosenRC.Row;
+		StepSummary Summary;
+		Summary.StepID = Steps[i].StepID;
+		Summary.EnteringVariable = Steps[i].NumbersOfVariables[Row];
+		Summary.LeavingVariable = PreviousVariables[Row];
+		if (IsFractionalCoefficients) {
+			FractionalMatrix& matrix = Steps[i].FracMatrix;
+			Summary.Objective = -ToDouble(matrix[matrix.RowNumber - 1][matrix.ColNumber - 1]);
+		} else {
+			Matrix& matrix = Steps[i].RealMatrix;
+			Summary.Objective = -ToDouble(matrix[matrix.RowNumber - 1][matrix.ColNumber - 1]);
 		}
+		Rows.push_back(Summary);
 	}
+	Summaries.LastVariables = Steps[End - 1].NumbersOfVariables;
+}
+
+// Turns the oldest steps after StartIndex into summaries when there are more than KeptTables of them.
+// Steps are taken away in batches of half of KeptTables, so every kept step is moved only a few times
+void SummarizeOldSteps(std::vector<Step>& Steps, int StartIndex, StepSummaries& Summaries, bool IsFractionalCoefficients) {
+	ForgetStaleSummaries(Steps, StartIndex, Summaries);
 
+	int Count = (int)Steps.size() - (StartIndex + 1);
+	if (KeptTables == 0 || Count <= KeptTables + KeptTables / 2) {
+		return;
+	}
+
+	int End = Steps.size() - KeptTables;
+	SummarizeSteps(Steps, StartIndex, End, Summaries, IsFractionalCoefficients);
+	Steps.erase(Steps.begin() + StartIndex + 1, Steps.begin() + End);
+}
+
+// Collapsible list of summaries, only the visible rows are drawn
+void DisplayStepSummaries(StepSummaries& Summaries) {
+	std::vector<StepSummary>& Rows = Summaries.Rows;
+	if (Rows.empty()) {
+		return;
+	}
+
+	char Header[64];
+	snprintf(Header, sizeof(Header), u8"  (%d)###Step Summaries", (int)Rows.size());
+	if (!ImGui::CollapsingHeader(Header)) {
+		return;
+	}
+
+	ImGui::BeginChild("Step Summaries", ImVec2(ImGui::GetWindowWidth() - ImGui::GetCursorPos().x - 25.0f, ImGui::GetTextLineHeightWithSpacing() * 8), true);
+	ImGui::Columns(4);
+	ImGui::TextUnformatted(u8""); ImGui::NextColumn();
+	ImGui::TextUnformatted(u8"  "); ImGui::NextColumn();
+	ImGui::TextUnformatted(u8"  "); ImGui::NextColumn();
+	ImGui::TextUnformatted("F(x)"); ImGui::NextColumn();
+	ImGui::Separator();
+
+	ImGuiListClipper Clipper(Rows.size());
+	while (Clipper.Step()) {
+		for (int i = Clipper.DisplayStart; i < Clipper.DisplayEnd; i++) {
+			StepSummary& Summary = Rows[i];
+			ImGui::Text("%d", Summary.StepID); ImGui::NextColumn();
+			ImGui::Text("x%d", Summary.EnteringVariable); ImGui::NextColumn();
+			ImGui::Text("x%d", Summary.LeavingVariable); ImGui::NextColumn();
+			ImGui::Text("%f", Summary.Objective); ImGui::NextColumn();
+		}
+	}
 	ImGui::Columns(1);
+	ImGui::EndChild();
 }
 
-void DisplaySteps(std::vector<Step> Steps, int StartIndex, bool IsFractionalCoefficients) {
-	if (Steps.size() != 0) {
-		for (int i = StartIndex; i < Steps.size(); i++) {
+// Steps are clipped by the list clipper, so the cost of a frame depends on the size of the window
+// and not on the number of steps. All steps of one phase have the same number of rows
+void DisplaySteps(std::vector<Step>& Steps, int StartIndex, bool IsFractionalCoefficients) {
+	if (Steps.size() <= StartIndex) {
+		return;
+	}
+
+	if (IsOverviewShown(Steps, StartIndex, IsFractionalCoefficients)) {
+		Step& LastStep = Steps.back();
+		if (IsFractionalCoefficients) {
+			ZoomOverview(LastStep.FracMatrix.RowNumber, LastStep.FracMatrix.ColNumber);
+		} else {
+			ZoomOverview(LastStep.RealMatrix.RowNumber, LastStep.RealMatrix.ColNumber);
+		}
+		bool IsLeadShown = !LastStep.IsAutomatic && !PotentialLeads.empty();
+		if (IsFractionalCoefficients) {
+			DisplayOverview(LastStep, LastStep.FracMatrix, IsLeadShown);
+		} else {
+			DisplayOverview(LastStep, LastStep.RealMatrix, IsLeadShown);
+		}
+		return;
+	}
+
+	// Zooming out of the table turns overview back on
+	if (ImGui::GetIO().KeyCtrl && ImGui::GetIO().MouseWheel < 0.0f && ImGui::IsWindowHovered() && OverviewZoom >= CellZoom) {
+		OverviewZoom = CellZoom / 1.2f;
+	}
+
+	Step& LastStep = Steps.back();
+	float Height = StepHeight(IsFractionalCoefficients ? LastStep.FracMatrix.RowNumber : LastStep.RealMatrix.RowNumber);
+	float Left = ImGui::GetCursorPosX();
+	float ListTop = ImGui::GetCursorPosY();
+	if (IsZoomedCellPending) {
+		// Cell of the element zoomed into stays under the mouse, row 0 and column 0 of the table are names of variables
+		IsZoomedCellPending = false;
+		float CellX = Left + (ZoomedCell.Column + 1.5f) * StepCellWidth;
+		float CellY = ListTop + (Steps.size() - 1 - StartIndex) * Height + ImGui::GetTextLineHeightWithSpacing() * 2 + (ZoomedCell.Row + 1.5f) * StepCellHeight();
+		ImGui::SetScrollX(CellX - ZoomedCellMouse.x);
+		ImGui::SetScrollY(CellY - ZoomedCellMouse.y);
+	}
+	ImGuiListClipper Clipper(Steps.size() - StartIndex, Height);
+	while (Clipper.Step()) {
+		for (int i = StartIndex + Clipper.DisplayStart; i < StartIndex + Clipper.DisplayEnd; i++) {
+			float Top = ImGui::GetCursorPosY();
 			bool IsLastIteration = (i == Steps.size() - 1);
 			if (IsFractionalCoefficients) {
-				DisplayStepOnScreen(Steps[i].FracMatrix, Steps[i].StepID, IsLastIteration, Steps[i].NumbersOfVariables);
+				DisplayStepOnScreen(Steps[i], Steps[i].FracMatrix, IsLastIteration);
 			} else {
-				DisplayStepOnScreen(Steps[i].RealMatrix, Steps[i].StepID, IsLastIteration, Steps[i].NumbersOfVariables);
+				DisplayStepOnScreen(Steps[i], Steps[i].RealMatrix, IsLastIteration);
 			}
-			ImGui::Separator();
+			ImGui::SetCursorPos(ImVec2(Left, Top + Height));
+		}
+	}
+}
+
+// Progress of automatic solution and button to stop it
+void SolverProgress(BackgroundSolver& Solver) {
+	if (!Solver.IsStarted) {
+		return;
+	}
+
+	const char* Phase = Solver.IsArtificialPhase ? u8" " : u8" ";
+	ImGui::Text(u8": %s   : %d   F(x) = %f", Phase, Solver.Iteration.load(), Solver.Objective.load());
+	if (Solver.IsRunning.load()) {
+		ImGui::SameLine();
+		if (ImGui::Button(u8"")) {
+			Solver.Cancel();
+		}
+	} else if (Solver.IsCancelRequested.load()) {
+		ImGui::SameLine();
+		ImGui::TextColored(ImColor(255, 0, 0), u8" ");
+	}
+}
+
+// Values of the last samples for PlotLines, the oldest value is at Offset
+struct PlotHistory {
+	static const int Capacity = 200;
+	float Values[Capacity] = {};
+	int Offset = 0;
+
+	void Push(float Value) {
+		Values[Offset] = Value;
+		Offset = (Offset + 1) % Capacity;
+	}
+
+	float Last() {
+		return Values[(Offset + Capacity - 1) % Capacity];
+	}
+
+	void Plot(const char* Label, const char* Format) {
+		char Overlay[64];
+		snprintf(Overlay, sizeof(Overlay), Format, Last());
+		ImGui::PlotLines(Label, Values, Capacity, Offset, Overlay, 0.0f, FLT_MAX, ImVec2(0.0f, ImGui::GetFrameHeight() * 2));
+	}
+};
+
+// Memory held by steps: tables, numbers of variables and labels of cells
+size_t StepsMemory(std::vector<Step>& Steps) {
+	size_t Size = Steps.capacity() * sizeof(Step);
+	for (Step& step : Steps) {
+		Size += step.RealMatrix.RowNumber * step.RealMatrix.ColNumber * sizeof(float);
+		Size += step.FracMatrix.RowNumber * step.FracMatrix.ColNumber * sizeof(Fraction);
+		Size += step.NumbersOfVariables.capacity() * sizeof(int);
+		Size += step.Labels.Arena.capacity() + step.Labels.Offsets.capacity() * sizeof(int);
+	}
+	return Size;
+}
+
+// Panel with frame time, speed of the solver and memory of the steps
+struct PerformancePanel {
+	// Solver is sampled not more often than this, so a rate has enough pivots to be steady
+	static constexpr double SolverSampleSeconds = 0.25;
+
+	bool IsShown = false;
+
+	// Milliseconds of CPU time of a frame
+	PlotHistory FrameTime;
+	PlotHistory PivotsPerSecond;
+	// Microseconds of one pivot and of its parts, Gauss elimination is in milliseconds
+	PlotHistory PivotTime;
+	PlotHistory SectionTime[PROFILE_SECTION_COUNT];
+	// Megabytes
+	PlotHistory Memory;
+
+	// Counters of the profiler at the last sample
+	ProfileClock::time_point LastSample = ProfileClock::now();
+	long long LastNanoseconds[PROFILE_SECTION_COUNT] = {};
+	long long LastPivots = 0;
+	long long LastPivotNanoseconds = 0;
+
+	void Sample(float FrameMilliseconds, size_t MemoryBytes) {
+		FrameTime.Push(FrameMilliseconds);
+		Memory.Push(MemoryBytes / (1024.0f * 1024.0f));
+
+		ProfileClock::time_point Now = ProfileClock::now();
+		double Seconds = std::chrono::duration<double>(Now - LastSample).count();
+		if (Seconds < SolverSampleSeconds) {
+			return;
+		}
+
+		long long Pivots = Profiler.Pivots[0].load() + Profiler.Pivots[1].load();
+		long long PivotNanoseconds = Profiler.PivotNanoseconds[0].load() + Profiler.PivotNanoseconds[1].load();
+		long long NewPivots = Pivots - LastPivots;
+		PivotsPerSecond.Push(NewPivots / Seconds);
+		PivotTime.Push(NewPivots != 0 ? (PivotNanoseconds - LastPivotNanoseconds) / 1000.0f / NewPivots : 0.0f);
+		for (int Section = 0; Section < PROFILE_SECTION_COUNT; Section++) {
+			long long Nanoseconds = Profiler.Nanoseconds[Section].load();
+			long long NewNanoseconds = Nanoseconds - LastNanoseconds[Section];
+			if (Section == PROFILE_GAUSS_ELIMINATION) {
+				SectionTime[Section].Push(NewNanoseconds / 1000000.0f);
+			} else {
+				SectionTime[Section].Push(NewPivots != 0 ? NewNanoseconds / 1000.0f / NewPivots : 0.0f);
+			}
+			LastNanoseconds[Section] = Nanoseconds;
 		}
+
+		LastSample = Now;
+		LastPivots = Pivots;
+		LastPivotNanoseconds = PivotNanoseconds;
 	}
+};
+
+PerformancePanel Performance;
+
+// Takes a sample every frame, the window is drawn only when it is shown
+void PerformanceWindow(float FrameMilliseconds, size_t MemoryBytes) {
+	PerformancePanel& Panel = Performance;
+	Panel.Sample(FrameMilliseconds, MemoryBytes);
+	if (!Panel.IsShown) {
+		return;
+	}
+
+	ImGui::SetNextWindowSize(ImVec2(480, 0), ImGuiCond_FirstUseEver);
+	if (ImGui::Begin(u8"", &Panel.IsShown)) {
+		Panel.FrameTime.Plot(u8"", u8"%.2f ");
+		Panel.PivotsPerSecond.Plot(u8"  ", "%.0f");
+		Panel.PivotTime.Plot(u8"", u8"%.1f ");
+		Panel.SectionTime[PROFILE_PRICING].Plot(u8" ", u8"%.1f ");
+		Panel.SectionTime[PROFILE_RATIO_TEST].Plot(u8" ", u8"%.1f ");
+		Panel.SectionTime[PROFILE_UPDATE].Plot(u8" ", u8"%.1f ");
+		Panel.SectionTime[PROFILE_GAUSS_ELIMINATION].Plot(u8" ", u8"%.2f ");
+		Panel.Memory.Plot(u8" ", u8"%.1f ");
+		ImGui::Separator();
+
+		// Totals since the start of the program
+		const char* Phases[2] = { u8" ", u8" " };
+		for (int Phase = 1; Phase >= 0; Phase--) {
+			ImGui::Text(u8"%s: %lld , %.1f ", Phases[Phase], Profiler.Pivots[Phase].load(), Profiler.PivotNanoseconds[Phase].load() / 1000000.0);
+		}
+		double Pricing = Profiler.Nanoseconds[PROFILE_PRICING].load();
+		double RatioTest = Profiler.Nanoseconds[PROFILE_RATIO_TEST].load();
+		double Update = Profiler.Nanoseconds[PROFILE_UPDATE].load();
+		double Total = std::max(1.0, Pricing + RatioTest + Update);
+		ImGui::Text(u8"  %.0f%%,   %.0f%%,  %.0f%%", Pricing * 100 / Total, RatioTest * 100 / Total, Update * 100 / Total);
+		ImGui::Text(u8" : %.1f ", Profiler.Nanoseconds[PROFILE_GAUSS_ELIMINATION].load() / 1000000.0);
+	}
+	ImGui::End();
 }
 
 bool MessageWindow(const char *Message) {
@@ -377,9 +1049,18 @@ void ReferencePopup(bool &OpenReferencePopup) {
 			if (ImGui::BeginTabItem(u8"  ")) {
 				if (ImGui::BeginTabBar("Files")) {
 					if (ImGui::BeginTabItem(u8"")) {
-						ImGui::BeginChild("File Work", ImVec2(0, 165), true);
+						ImGui::BeginChild("File Work", ImVec2(0, 300), true);
 						ImGui::TextWrapped(u8"   -  .\n  -  ,  -    .");
-						ImGui::TextWrapped(u8"      .\n      '/'    .     .");
+						ImGui::TextWrapped(u8"      .\n      '/'    ,       .");
+						ImGui::TextWrapped(u8"      ,    .");
+						ImGui::TextWrapped(u8"   .lp  .mps      CPLEX LP  MPS.");
+						ImGui::TextWrapped(u8" .csv  .tsv   :   ,  B   , "
+							"       .  - ,     , "
+							"   - ,   - .        "
+							"( -     )   Ctrl+V    ,      .");
+						ImGui::TextWrapped(u8"    : 'NV:' -  , 'NL:' -  , "
+							" 'R' -  , 'F' -  , 'A' -  , "
+							"'ML:' -  , 'TF:' -   .        .");
 						ImGui::EndChild();
 						ImGui::TextWrapped(u8":");
 						ImGui::Text(u8" ");
@@ -398,9 +1079,16 @@ void ReferencePopup(bool &OpenReferencePopup) {
 							"       ,    .\n");
 						ImGui::EndChild();
 						ImGui::TextWrapped(u8"        \n:");
-						ImGui::BeginChild("Txt Example", ImVec2(0, 70), true);
+						ImGui::BeginChild("Txt Example", ImVec2(0, 140), true);
 						ImGui::TextWrapped(u8".txt");
+						ImGui::TextWrapped(u8".lp -    CPLEX LP");
+						ImGui::TextWrapped(u8".spxs -  : ,     .        ");
+						ImGui::TextWrapped(u8".spxr -   :  , ,  ,       ");
 						ImGui::EndChild();
+						ImGui::TextWrapped(u8"  ( -  ...)    .spxt    , "
+							"   -    .      ( -  ) "
+							"      .  'SimplexMethod --trace .spxt'   , "
+							"'SimplexMethod --trace .spxt simplex N'    N.");
 						ImGui::EndTabItem();
 					}
 					ImGui::EndTabBar();
@@ -419,15 +1107,25 @@ void ReferencePopup(bool &OpenReferencePopup) {
 	}
 }
 
-void MainMenuBar(Matrix& RealMatrix, FractionalMatrix& FracMatrix, std::vector<bool> &BasisActive, int& OutNumberOfVariables, int& OutNumberOfLimitations, bool& IsReadHasHappened, int& IsFractionalCoeffs) {
+void MainMenuBar(Matrix& RealMatrix, FractionalMatrix& FracMatrix, std::vector<float>& RealTargetFunction, std::vector<Fraction>& FractionalTargetFunction,
+	std::vector<bool> &BasisActive, int& OutNumberOfVariables, int& OutNumberOfLimitations, bool& IsReadHasHappened, int& IsFractionalCoeffs,
+	int& OutIsArtificialBasis, int& OutIsAutomatic, bool& OutIsMaximization, SolutionSnapshot& Snapshot, bool& IsSnapshotLoaded,
+	const std::function<const char*(const char* FileName, bool IsJournalSaved)>& SaveSnapshot, const std::function<const char*(const char* FileName)>& SaveReport) {
 	// Default path initialization
+#ifdef _WIN32
 	static WCHAR DEFAULT_PATH[256];
 	GetModuleFileName(NULL, (WCHAR*)DEFAULT_PATH, 256);
-	static std::regex target(u8"SimplexMethod.exe");
 	static std::wstring STR_DEFAULT_PATH(DEFAULT_PATH);
-	static std::string StrDEFULAT_PATH = std::regex_replace(std::string(STR_DEFAULT_PATH.begin(), STR_DEFAULT_PATH.end()), target, " ");
+	// Directory of the executable
+	static std::string StrDEFULAT_PATH(STR_DEFAULT_PATH.begin(), STR_DEFAULT_PATH.begin() + (STR_DEFAULT_PATH.find_last_of(L"\\/") + 1));
+#else
+	// File dialogs start in the current directory
+	static std::string StrDEFULAT_PATH = "./";
+#endif
 	// Patterns
-	char const* lFilterPatterns[2] = { "*.txt", "*.text" };
+	char const* lFilterPatterns[6] = { "*.txt", "*.text", "*.lp", "*.mps", "*.spxs", "*.spxr" };
+	// Tables of numbers can only be opened, reports of solutions can only be saved
+	char const* lOpenFilterPatterns[7] = { "*.txt", "*.text", "*.lp", "*.mps", "*.spxs", "*.csv", "*.tsv" };
 
 
 	static bool OpenAboutPopup = false;
@@ -435,14 +1133,71 @@ void MainMenuBar(Matrix& RealMatrix, FractionalMatrix& FracMatrix, std::vector<b
 	static bool OpenFileSavePopup = false;
 	static bool OpenReferencePopup = false;
 	static int IsFractionalCoefficients = 0;
+	static bool IsJournalSaved = true;
 	static bool ErrorOccured = false;
 	const static char* ErrorMessage;
+	static std::string ErrorText;
 
 	if (ErrorOccured) {
 		// If window is closed
 		if (MessageWindow(ErrorMessage)) {
 			ErrorOccured = false;
 		}
+	} else if (TraceError) {
+		if (MessageWindow(TraceError)) {
+			TraceError = NULL;
+		}
+	} else if (PasteError) {
+		if (MessageWindow(PasteError)) {
+			PasteError = NULL;
+		}
+	}
+
+	// Problem that has been read from a file or the clipboard replaces the current one
+	auto ApplyReadProblem = [&](Problem& problem, const char* Error, ReadStatistics& Statistics, bool IsSnapshot, const char* ErrorPlace) {
+		if (!Error && problem.NumberOfLimitations > problem.NumberOfVariables) {
+			Error = "Wrong dimensions of the problem";
+		}
+
+		if (Error) {
+			ErrorOccured = true;
+			ErrorText = ErrorPlace;
+			if (Statistics.ErrorLine != 0) {
+				ErrorText += u8"   " + std::to_string(Statistics.ErrorLine);
+			}
+			if (Statistics.ErrorColumn != 0) {
+				ErrorText += u8",  " + std::to_string(Statistics.ErrorColumn);
+			}
+			ErrorText += std::string(": ") + Error;
+			ErrorMessage = ErrorText.c_str();
+		} else {
+			IsReadHasHappened = true;
+			IsSnapshotLoaded = IsSnapshot;
+			IsFractionalCoeffs = problem.IsFractionalCoefficients;
+			OutIsMaximization = problem.IsMaximization;
+			// Configuration file chooses the solve modes too
+			if (problem.HasSolveModes) {
+				OutIsArtificialBasis = problem.IsArtificialBasis;
+				OutIsAutomatic = problem.IsAutomatic;
+			}
+			OutNumberOfLimitations = problem.NumberOfLimitations;
+			OutNumberOfVariables = problem.NumberOfVariables + 1;
+			RealMatrix = problem.RealMatrix;
+			FracMatrix = problem.FracMatrix;
+			RealTargetFunction = problem.RealTargetFunction;
+			FractionalTargetFunction = problem.FractionalTargetFunction;
+			BasisActive.resize(problem.NumberOfVariables);
+		}
+	};
+
+	// Table of numbers from the clipboard is read into the current type of elements
+	if (IsClipboardImportRequested) {
+		IsClipboardImportRequested = false;
+		const char* Text = ImGui::GetClipboardText();
+		Problem ImportedProblem;
+		ReadStatistics Statistics;
+		const char* Error = Text ? ParseCsvProblem(Text, strlen(Text), IsFractionalCoeffs, ImportedProblem, Statistics) : "Clipboard is empty";
+		ApplyReadProblem(ImportedProblem, Error, Statistics, false, u8"     ");
 	}
 
 	if (ImGui::BeginMainMenuBar()) {
@@ -453,6 +1208,34 @@ void MainMenuBar(Matrix& RealMatrix, FractionalMatrix& FracMatrix, std::vector<b
 			if (ImGui::MenuItem(u8"")) {
 				OpenFileSavePopup = true;
 			}
+			if (ImGui::MenuItem(u8"    ")) {
+				IsClipboardImportRequested = true;
+			}
+			ImGui::Separator();
+			// Trace is turned off by the same item
+			if (ImGui::MenuItem(u8" ...", NULL, !TraceFileName.empty())) {
+				if (!TraceFileName.empty()) {
+					TraceFileName.clear();
+				} else {
+					char const* TracePatterns[1] = { "*.spxt" };
+					const char* path = tinyfd_saveFileDialog(u8" ", StrDEFULAT_PATH.c_str(), 1, TracePatterns, NULL);
+					if (path != NULL) {
+						TraceFileName = path;
+					}
+				}
+			}
+			ImGui::SetNextItemWidth(100);
+			ImGui::DragInt(u8"  ", &TraceTableInterval, 1.0f, 0, 100000, TraceTableInterval == 0 ? u8" " : u8" %d");
+			ImGui::EndMenu();
+		}
+
+		if (ImGui::BeginMenu(u8"")) {
+			ImGui::SetNextItemWidth(100);
+			ImGui::SliderInt(u8" ", &SignificantDigits, 0, 9, SignificantDigits == 0 ? u8"" : "%d");
+			ImGui::MenuItem(u8"  ", NULL, &IsOverviewEnabled);
+			ImGui::SetNextItemWidth(100);
+			ImGui::DragInt(u8" ", &KeptTables, 1.0f, 0, 10000, KeptTables == 0 ? u8"" : "%d");
+			ImGui::MenuItem(u8"", NULL, &Performance.IsShown);
 			ImGui::EndMenu();
 		}
 
@@ -505,67 +1288,20 @@ void MainMenuBar(Matrix& RealMatrix, FractionalMatrix& FracMatrix, std::vector<b
 
 		ImGui::EndChild();
 		if (ImGui::Button(u8"")) {
-			const char* path = tinyfd_openFileDialog(" ", StrDEFULAT_PATH.c_str(), 2, lFilterPatterns, NULL, false);
+			const char* path = tinyfd_openFileDialog(" ", StrDEFULAT_PATH.c_str(), 7, lOpenFilterPatterns, NULL, false);
 			std::string filename;
 			if (path != NULL) {
 				filename = path;
 			}
 
 			if (!filename.empty()) {
-				IsReadHasHappened = true;
-				IsFractionalCoeffs = IsFractionalCoefficients;
-
-				FILE* file = fopen(filename.c_str(), "r");
-				// If it asserts something went horribly wrong
-				assert(file);
-
-				int NumberOfLimitations = -1;
-				int NumberOfVariables = -1;
-				if (fscanf(file, "%d", &NumberOfLimitations) != 1 || fscanf(file, "%d", &NumberOfVariables) != 1) {
-					IsReadHasHappened = false;
-					ErrorOccured = true;
-					ErrorMessage = u8"     !";
-				}
-
-				if (NumberOfVariables < 1 || NumberOfLimitations < 1 || NumberOfLimitations >= NumberOfVariables) {
-					IsReadHasHappened = false;
-					ErrorOccured = true;
-					ErrorMessage = u8" ";
-				}
-
-				if (!ErrorOccured) {
-					OutNumberOfLimitations = NumberOfLimitations;
-					OutNumberOfVariables = NumberOfVariables;
-					FracMatrix.Resize(NumberOfLimitations + 1, NumberOfVariables);
-					RealMatrix.Resize(NumberOfLimitations + 1, NumberOfVariables);
-					BasisActive.resize(NumberOfVariables - 1);
-
-					if (IsFractionalCoefficients) {
-						for (int i = 0; i < NumberOfLimitations; i++) {
-							for (int j = 0; j < NumberOfVariables; j++) {
-								if (fscanf(file, "%d/%d", &FracMatrix[i][j].numerator, &FracMatrix[i][j].denominator) != 2) {
-									IsReadHasHappened = false;
-									ErrorOccured = true;
-									ErrorMessage = u8"     !";
-								}
-							}
-							if (ErrorOccured) { break; }
-						}
-					} else {
-						for (int i = 0; i < NumberOfLimitations; i++) {
-							for (int j = 0; j < NumberOfVariables; j++) {
-								if (fscanf(file, "%f", &RealMatrix[i][j]) != 1) {
-									IsReadHasHappened = false;
-									ErrorOccured = true;
-									ErrorMessage = u8"     !";
-								}
-							}
-							if (ErrorOccured) { break; }
-						}
-					}
-				}
-
-				fclose(file);
+				// Format is chosen by the extension: ".lp", ".mps", ".csv" and ".tsv", ".spxs" snapshot or the text format
+				bool IsSnapshot = HasExtension(filename.c_str(), ".spxs");
+				Problem LoadedProblem;
+				ReadStatistics Statistics;
+				const char* Error = IsSnapshot ? ReadSnapshot(filename.c_str(), Snapshot, Statistics)
+					: LoadProblem(filename.c_str(), IsFractionalCoefficients, LoadedProblem, Statistics);
+				ApplyReadProblem(IsSnapshot ? Snapshot.problem : LoadedProblem, Error, Statistics, IsSnapshot, u8"    ");
 			}
 
 			OpenFileOpenPopup = false;
@@ -577,44 +1313,68 @@ void MainMenuBar(Matrix& RealMatrix, FractionalMatrix& FracMatrix, std::vector<b
 
 	ImGui::PushStyleColor(ImGuiCol_PopupBg, IM_COL32(240, 240, 240, 255));
 	if (ImGui::BeginPopupModal(u8" ", &OpenFileSavePopup, ImGuiWindowFlags_AlwaysAutoResize)) {
-		ImGui::BeginChild("SaveFile", ImVec2(400, 70), true);
+		ImGui::BeginChild("SaveFile", ImVec2(400, 95), true);
 		ImGui::Text(u8"  ");
 		ImGui::Separator();
 		ImGui::PushID(1);
 		ImGui::Combo("", &IsFractionalCoefficients, u8" \0 \0");
 		ImGui::PopID();
+		ImGui::Checkbox(u8"    ", &IsJournalSaved);
 		ImGui::EndChild();
 
 		if (ImGui::Button(u8"")) {
-			const char* path = tinyfd_saveFileDialog(u8" ", StrDEFULAT_PATH.c_str(), 2, lFilterPatterns, NULL);
+			const char* path = tinyfd_saveFileDialog(u8" ", StrDEFULAT_PATH.c_str(), 6, lFilterPatterns, NULL);
 			std::string filename;
 			if (path != NULL) {
 				filename = path;
 			}
 
-			if (!filename.empty()) {
+			if (!filename.empty() && HasExtension(filename.c_str(), ".spxs")) {
+				if (const char* Error = SaveSnapshot(filename.c_str(), IsJournalSaved)) {
+					ErrorOccured = true;
+					ErrorText = std::string(u8"    : ") + Error;
+					ErrorMessage = ErrorText.c_str();
+				}
+			} else if (!filename.empty() && HasExtension(filename.c_str(), ".spxr")) {
+				if (const char* Error = SaveReport(filename.c_str())) {
+					ErrorOccured = true;
+					ErrorText = std::string(u8"    : ") + Error;
+					ErrorMessage = ErrorText.c_str();
+				}
+			} else if (!filename.empty() && HasExtension(filename.c_str(), ".lp")) {
+				const char* Error = IsFractionalCoefficients ? WriteLp(filename.c_str(), FracMatrix, FractionalTargetFunction)
+					: WriteLp(filename.c_str(), RealMatrix, RealTargetFunction);
+				if (Error) {
+					ErrorOccured = true;
+					ErrorText = std::string(u8"    : ") + Error;
+					ErrorMessage = ErrorText.c_str();
+				}
+			} else if (!filename.empty()) {
 				FILE* file = fopen(filename.c_str(), "w");
-				assert(file != NULL);
-
-				if (IsFractionalCoefficients) {
-					fprintf(file, "%d\n%d\n", FracMatrix.RowNumber - 1, FracMatrix.ColNumber);
-					for (int i = 0; i < FracMatrix.RowNumber - 1; i++) {
-						for (int j = 0; j < FracMatrix.ColNumber; j++) {
-							fprintf(file, "%d/%d ", FracMatrix[i][j].numerator, FracMatrix[i][j].denominator);
-						}
-						fprintf(file, "\n");
-					}
+				if (!file) {
+					ErrorOccured = true;
+					ErrorMessage = u8"     ";
 				} else {
-					fprintf(file, "%d\n%d\n", RealMatrix.RowNumber - 1, RealMatrix.ColNumber);
-					for (int i = 0; i < RealMatrix.RowNumber - 1; i++) {
-						for (int j = 0; j < RealMatrix.ColNumber; j++) {
-							fprintf(file, "%f ", RealMatrix[i][j]);
+					if (IsFractionalCoefficients) {
+						fprintf(file, "%d\n%d\n", FracMatrix.RowNumber - 1, FracMatrix.ColNumber);
+						for (int i = 0; i < FracMatrix.RowNumber - 1; i++) {
+							for (int j = 0; j < FracMatrix.ColNumber; j++) {
+								fprintf(file, "%d/%d ", FracMatrix[i][j].numerator, FracMatrix[i][j].denominator);
+							}
+							fprintf(file, "\n");
+						}
+					} else {
+						fprintf(file, "%d\n%d\n", RealMatrix.RowNumber - 1, RealMatrix.ColNumber);
+						for (int i = 0; i < RealMatrix.RowNumber - 1; i++) {
+							for (int j = 0; j < RealMatrix.ColNumber; j++) {
+								fprintf(file, "%f ", RealMatrix[i][j]);
+							}
+							fprintf(file, "\n");
 						}
-						fprintf(file, "\n");
 					}
-				}
 
-				fclose(file);
+					fclose(file);
+				}
 			}
 			OpenFileSavePopup = false;
 			ImGui::CloseCurrentPopup();
@@ -0,0 +1,55 @@
+// Command line modes of SimplexMethod without the graphical interface, for servers that have no display.
+// Everything is included into this file the same way main.cpp includes it, only GLFW, ImGui and OpenGL are left out
+#include <stdio.h>
+
+#include <vector>
+#include <string>
+#include <type_traits>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <new>
+#include <thread>
+#include <future>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstdint>
+#include <cerrno>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include "windows.h" // For mapped files
+#endif
+#include "Common.h"
+#include "Profiler.h"
+#include "Simplex.h"
+#include "Decomposition.h"
+#include "NumberParser.h"
+#include "MpsFile.h"
+#include "LpFile.h"
+#include "ProblemFile.h"
+#include "CsvFile.h"
+#include "Snapshot.h"
+#include "StepTrace.h"
+#include "BasisFile.h"
+#include "SolutionReport.h"
+#include "BatchSolver.h"
+#include "SolverDaemon.h"
+#include "BackgroundSolver.h"
+#include "CommandLine.h"
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		PrintUsage();
+		return 1;
+	}
+	return RunCommandLine(argc, argv);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+// Picture of a matrix where every element is one texel.
+// Positive elements are blue, negative are red, the brighter the color the bigger the magnitude.
+// Magnitude is on a logarithmic scale, so small elements stay visible next to big ones.
+// Matrix wider or taller than the biggest texture OpenGL allows is downsampled:
+// a texel is a block of elements and has the color of the biggest one of them
+
+struct Heatmap {
+	GLuint Texture = 0;
+	// Size of the shown matrix
+	int Width = 0;
+	int Height = 0;
+	// Part of the texture the matrix takes, the last block of a downsampled texture can be cut by the edge of the matrix
+	float MaxU = 1.0f;
+	float MaxV = 1.0f;
+	std::vector<unsigned char> Pixels;
+
+	// Copy of the shown matrix, texture is made again only when another matrix is shown.
+	// Comparing the elements costs much less than drawing them and doesn't depend on where the step is stored
+	std::vector<char> Source;
+
+	void Release() {
+		if (Texture) {
+			glDeleteTextures(1, &Texture);
+			Texture = 0;
+		}
+		Source.clear();
+	}
+
+	template<typename MatrixType> void Update(MatrixType& matrix) {
+		int Count = matrix.RowNumber * matrix.ColNumber;
+		size_t Size = Count * sizeof(matrix.matrix[0]);
+		if (Texture && Width == matrix.ColNumber && Height == matrix.RowNumber && Source.size() == Size && memcmp(Source.data(), matrix.matrix, Size) == 0) {
+			return;
+		}
+		Source.assign((const char*)matrix.matrix, (const char*)matrix.matrix + Size);
+
+		double MaxMagnitude = 0.0;
+		for (int i = 0; i < Count; i++) {
+			MaxMagnitude = std::max(MaxMagnitude, fabs(ToDouble(matrix.matrix[i])));
+		}
+		double Scale = MaxMagnitude > 0.0 ? 1.0 / log1p(MaxMagnitude) : 0.0;
+
+		GLint MaxTextureSize = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_SIZE, &MaxTextureSize);
+		MaxTextureSize = std::max(MaxTextureSize, 1);
+		int BlockWidth = (matrix.ColNumber + MaxTextureSize - 1) / MaxTextureSize;
+		int BlockHeight = (matrix.RowNumber + MaxTextureSize - 1) / MaxTextureSize;
+		int TextureWidth = (matrix.ColNumber + BlockWidth - 1) / BlockWidth;
+		int TextureHeight = (matrix.RowNumber + BlockHeight - 1) / BlockHeight;
+
+		Pixels.resize((size_t)TextureWidth * TextureHeight * 4);
+		for (int y = 0; y < TextureHeight; y++) {
+			for (int x = 0; x < TextureWidth; x++) {
+				// Element of the block with the biggest magnitude, a lone non-zero element isn't lost among zeros
+				double Value = 0.0;
+				for (int i = y * BlockHeight; i < std::min((y + 1) * BlockHeight, matrix.RowNumber); i++) {
+					for (int j = x * BlockWidth; j < std::min((x + 1) * BlockWidth, matrix.ColNumber); j++) {
+						double Element = ToDouble(matrix[i][j]);
+						if (fabs(Element) > fabs(Value)) {
+							Value = Element;
+						}
+					}
+				}
+
+				// From white for zero to saturated color for the biggest magnitude
+				unsigned char Fade = (unsigned char)(255.0 * (1.0 - 0.85 * log1p(fabs(Value)) * Scale));
+				unsigned char* Pixel = &Pixels[((size_t)y * TextureWidth + x) * 4];
+				if (Value > 0) {
+					Pixel[0] = Fade; Pixel[1] = Fade; Pixel[2] = 255;
+				} else if (Value < 0) {
+					Pixel[0] = 255; Pixel[1] = Fade; Pixel[2] = Fade;
+				} else {
+					Pixel[0] = 255; Pixel[1] = 255; Pixel[2] = 255;
+				}
+				Pixel[3] = 255;
+			}
+		}
+
+		if (!Texture) {
+			glGenTextures(1, &Texture);
+		}
+		glBindTexture(GL_TEXTURE_2D, Texture);
+		// Elements stay sharp squares when zoomed in
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, TextureWidth, TextureHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, Pixels.data());
+		Width = matrix.ColNumber;
+		Height = matrix.RowNumber;
+		MaxU = (float)matrix.ColNumber / (TextureWidth * BlockWidth);
+		MaxV = (float)matrix.RowNumber / (TextureHeight * BlockHeight);
+	}
+};
@@ -0,0 +1,608 @@
+#pragma once
+
+// Problems in CPLEX LP format: "Minimize/Maximize", "Subject To", "Bounds", "General", "Binary" and "End".
+// File is read into memory and split into tokens in one pass, terms of constraints are collected by rows
+// and turned into the same sparse columns MPS files are read into.
+// Integrality isn't supported by the simplex method, so general and binary variables are solved as continuous
+
+enum LpTokenType {
+	LP_END,
+	LP_NUMBER,
+	LP_NAME,
+	LP_PLUS,
+	LP_MINUS,
+	LP_LESS,
+	LP_GREATER,
+	LP_EQUAL,
+};
+
+enum LpSection {
+	LP_SECTION_NONE,
+	LP_SECTION_OBJECTIVE,
+	LP_SECTION_CONSTRAINTS,
+	LP_SECTION_BOUNDS,
+	LP_SECTION_GENERAL,
+	LP_SECTION_BINARY,
+	LP_SECTION_UNSUPPORTED,
+	LP_SECTION_END,
+};
+
+struct LpToken {
+	LpTokenType Type = LP_END;
+	TextField Text;
+	double Value = 0.0;
+	int Line = 1;
+	// Section keywords are recognized only at the beginning of a line
+	bool IsLineStart = false;
+	// Name is followed by a colon, so it's a name of a constraint
+	bool IsLabel = false;
+};
+
+static bool IsLpNameCharacter(char Character) {
+	return isalnum((unsigned char)Character) || (Character != '\0' && strchr("!\"#$%&()/,.;?@_`'{}|~", Character));
+}
+
+// Case insensitive comparison with a word in lower case
+static bool IsWord(TextField Field, const char* Word) {
+	int Length = strlen(Word);
+	if (Field.Length != Length) {
+		return false;
+	}
+	for (int i = 0; i < Length; i++) {
+		if (tolower((unsigned char)Field.Begin[i]) != Word[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+struct LpReader {
+	SparseProblem& problem;
+	// Text of the file ends with zero, so the tokenizer checks the end only inside numbers
+	const char* Position;
+	const char* End;
+	int Line = 1;
+	LpToken Token;
+	LpSection Section = LP_SECTION_NONE;
+
+	NameIndex Columns;
+	// Elements of the matrix in the order they are read, by rows
+	std::vector<int> ElementRows;
+	std::vector<int> ElementColumns;
+	std::vector<double> ElementValues;
+
+	LpReader(SparseProblem& problem, const char* Text, size_t Size) : problem(problem), Position(Text), End(Text + Size) {}
+
+	// Skips spaces, line feeds and comments that start with a backslash
+	void SkipSpaces() {
+		while (true) {
+			char Character = *Position;
+			if (Character == '\n') {
+				Line += 1;
+				Position++;
+			} else if (Character == ' ' || Character == '\t' || Character == '\r') {
+				Position++;
+			} else if (Character == '\\') {
+				while (*Position != '\n' && *Position != '\0') {
+					Position++;
+				}
+			} else {
+				return;
+			}
+		}
+	}
+
+	// Reads the next token. Returns error message for characters the format doesn't have
+	const char* Next() {
+		int PreviousLine = Line;
+		SkipSpaces();
+		Token = LpToken();
+		Token.Line = Line;
+		Token.IsLineStart = Line != PreviousLine;
+		Token.Text.Begin = Position;
+
+		char Character = *Position;
+		if (Character == '\0') {
+			return NULL;
+		}
+
+		if (IsDigit(Character) || Character == '.') {
+			DecimalNumber Number;
+			const char* NumberEnd = ScanDecimal(Position, End, Number);
+			if (!NumberEnd) {
+				return "Wrong number";
+			}
+			Token.Type = LP_NUMBER;
+			Token.Text.Length = NumberEnd - Position;
+			Token.Value = DecimalToDouble(Number);
+			Position = NumberEnd;
+			return NULL;
+		}
+
+		if (IsLpNameCharacter(Character)) {
+			while (IsLpNameCharacter(*Position)) {
+				Position++;
+			}
+			Token.Type = LP_NAME;
+			Token.Text.Length = Position - Token.Text.Begin;
+
+			// Colon may be on the same line after spaces
+			const char* After = Position;
+			while (*After == ' ' || *After == '\t') { After++; }
+			if (*After == ':') {
+				Token.IsLabel = true;
+				Position = After + 1;
+			}
+			return NULL;
+		}
+
+		Position++;
+		switch (Character) {
+		case '+': Token.Type = LP_PLUS; break;
+		case '-': Token.Type = LP_MINUS; break;
+		// "<", "<=" and "=<" are the same, as are ">", ">=" and "=>"
+		case '<': Token.Type = LP_LESS; break;
+		case '>': Token.Type = LP_GREATER; break;
+		case '=':
+			Token.Type = LP_EQUAL;
+			if (*Position == '<') { Token.Type = LP_LESS; Position++; }
+			else if (*Position == '>') { Token.Type = LP_GREATER; Position++; }
+			break;
+		case '[': case '^': case '*':
+			return "Quadratic terms aren't supported";
+		default:
+			return "Unexpected character";
+		}
+		if ((Token.Type == LP_LESS || Token.Type == LP_GREATER) && *Position == '=') {
+			Position++;
+		}
+		Token.Text.Length = Position - Token.Text.Begin;
+		return NULL;
+	}
+
+	// Case insensitive check of the word after the current token on the same line
+	bool IsNextWord(const char* Word) const {
+		const char* Begin = Position;
+		while (*Begin == ' ' || *Begin == '\t') { Begin++; }
+		TextField Field;
+		Field.Begin = Begin;
+		while (IsLpNameCharacter(Begin[Field.Length])) { Field.Length++; }
+		return IsWord(Field, Word);
+	}
+
+	// Section that starts at the current token, LP_SECTION_NONE if the token isn't a keyword.
+	// Keyword of two words ends after the next token
+	LpSection SectionKeyword() const {
+		if (Token.Type == LP_END) {
+			return LP_SECTION_END;
+		}
+		if (Token.Type != LP_NAME || !Token.IsLineStart || Token.IsLabel) {
+			return LP_SECTION_NONE;
+		}
+
+		TextField Word = Token.Text;
+		if (IsWord(Word, "minimize") || IsWord(Word, "minimum") || IsWord(Word, "min")
+			|| IsWord(Word, "maximize") || IsWord(Word, "maximum") || IsWord(Word, "max")) {
+			return LP_SECTION_OBJECTIVE;
+		}
+		if (IsWord(Word, "st") || IsWord(Word, "s.t.") || IsWord(Word, "st.")
+			|| (IsWord(Word, "subject") && IsNextWord("to")) || (IsWord(Word, "such") && IsNextWord("that"))) {
+			return LP_SECTION_CONSTRAINTS;
+		}
+		if (IsWord(Word, "bounds") || IsWord(Word, "bound")) {
+			return LP_SECTION_BOUNDS;
+		}
+		if (IsWord(Word, "general") || IsWord(Word, "generals") || IsWord(Word, "gen")) {
+			return LP_SECTION_GENERAL;
+		}
+		if (IsWord(Word, "binary") || IsWord(Word, "binaries") || IsWord(Word, "bin")) {
+			return LP_SECTION_BINARY;
+		}
+		if (IsWord(Word, "semi") || IsWord(Word, "semis") || IsWord(Word, "sos")) {
+			return LP_SECTION_UNSUPPORTED;
+		}
+		if (IsWord(Word, "end")) {
+			return LP_SECTION_END;
+		}
+		return LP_SECTION_NONE;
+	}
+
+	int FindColumn(TextField Name) {
+		int Column = Columns.Find(Name, -1);
+		if (Column != -1) {
+			return Column;
+		}
+
+		// Variables are non-negative if bounds don't say otherwise
+		Column = problem.ColumnNames.size();
+		Columns.Add(Name, Column);
+		problem.ColumnNames.emplace_back(Name.Begin, Name.Length);
+		problem.Objective.push_back(0.0);
+		problem.LowerBounds.push_back(0.0);
+		problem.UpperBounds.push_back(INFINITY);
+		return Column;
+	}
+
+	bool IsComparison() const {
+		return Token.Type == LP_LESS || Token.Type == LP_GREATER || Token.Type == LP_EQUAL;
+	}
+
+	// Reads terms like "- 2 x + 3.5 y + 4" until a comparison or the next section.
+	// Row -1 is the objective. Constant terms are added to Constant, IsEmpty tells if there were no variables
+	const char* ReadExpression(int Row, double& Constant, bool& IsEmpty) {
+		Constant = 0.0;
+		IsEmpty = true;
+		while (true) {
+			double Sign = 1.0;
+			bool HasSign = false;
+			while (Token.Type == LP_PLUS || Token.Type == LP_MINUS) {
+				Sign *= Token.Type == LP_MINUS ? -1.0 : 1.0;
+				HasSign = true;
+				if (const char* Error = Next()) { return Error; }
+			}
+
+			double Coefficient = 1.0;
+			bool HasNumber = false;
+			if (Token.Type == LP_NUMBER) {
+				Coefficient = Token.Value;
+				HasNumber = true;
+				if (const char* Error = Next()) { return Error; }
+			}
+
+			if (Token.Type == LP_NAME && !Token.IsLabel && SectionKeyword() == LP_SECTION_NONE) {
+				int Column = FindColumn(Token.Text);
+				double Value = Sign * Coefficient;
+				if (Row == -1) {
+					problem.Objective[Column] += Value;
+				} else {
+					ElementRows.push_back(Row);
+					ElementColumns.push_back(Column);
+					ElementValues.push_back(Value);
+				}
+				IsEmpty = false;
+				if (const char* Error = Next()) { return Error; }
+			} else if (HasNumber) {
+				Constant += Sign * Coefficient;
+			} else if (HasSign) {
+				return "Sign without a term";
+			} else {
+				return NULL;
+			}
+		}
+	}
+
+	// Number with signs, "inf" and "infinity" are infinite
+	const char* ReadValue(double& Value) {
+		double Sign = 1.0;
+		while (Token.Type == LP_PLUS || Token.Type == LP_MINUS) {
+			Sign *= Token.Type == LP_MINUS ? -1.0 : 1.0;
+			if (const char* Error = Next()) { return Error; }
+		}
+		if (Token.Type == LP_NUMBER) {
+			Value = Sign * Token.Value;
+		} else if (Token.Type == LP_NAME && (IsWord(Token.Text, "inf") || IsWord(Token.Text, "infinity"))) {
+			Value = Sign * INFINITY;
+		} else {
+			return "Number is expected";
+		}
+		return Next();
+	}
+
+	bool IsValueStart() const {
+		return Token.Type == LP_NUMBER || Token.Type == LP_PLUS || Token.Type == LP_MINUS
+			|| (Token.Type == LP_NAME && (IsWord(Token.Text, "inf") || IsWord(Token.Text, "infinity")));
+	}
+
+	const char* ReadObjective() {
+		if (Token.IsLabel) {
+			if (const char* Error = Next()) { return Error; }
+		}
+		bool IsEmpty;
+		const char* Error = ReadExpression(-1, problem.ObjectiveConstant, IsEmpty);
+		if (!Error && SectionKeyword() == LP_SECTION_NONE) {
+			Error = "Objective is followed by something else than a section";
+		}
+		return Error;
+	}
+
+	// "name: expression <= value" or a range "value <= expression <= value"
+	const char* ReadConstraint() {
+		int Row = problem.RowNames.size();
+		if (Token.IsLabel) {
+			problem.RowNames.emplace_back(Token.Text.Begin, Token.Text.Length);
+			if (const char* Error = Next()) { return Error; }
+		} else {
+			problem.RowNames.push_back("R" + std::to_string(Row + 1));
+		}
+		problem.RowLower.push_back(-INFINITY);
+		problem.RowUpper.push_back(INFINITY);
+
+		double Constant;
+		bool IsEmpty;
+		if (const char* Error = ReadExpression(Row, Constant, IsEmpty)) { return Error; }
+		if (!IsComparison()) {
+			return "Constraint has no comparison";
+		}
+
+		// Range has a constant before the first comparison
+		if (IsEmpty) {
+			LpTokenType Comparison = Token.Type;
+			if (const char* Error = Next()) { return Error; }
+			double LeftConstant = Constant;
+			if (const char* Error = ReadExpression(Row, Constant, IsEmpty)) { return Error; }
+			if (IsEmpty || Token.Type != Comparison || Comparison == LP_EQUAL) {
+				return "Wrong range of a constraint";
+			}
+			(Comparison == LP_LESS ? problem.RowLower : problem.RowUpper)[Row] = LeftConstant - Constant;
+		}
+
+		LpTokenType Comparison = Token.Type;
+		if (const char* Error = Next()) { return Error; }
+		double Value;
+		if (const char* Error = ReadValue(Value)) { return Error; }
+		Value -= Constant;
+		if (Comparison != LP_GREATER) {
+			problem.RowUpper[Row] = Value;
+		}
+		if (Comparison != LP_LESS) {
+			problem.RowLower[Row] = Value;
+		}
+		return NULL;
+	}
+
+	// "x <= value", "x >= value", "x = value", "value <= x <= value" and "x free"
+	const char* ReadBound() {
+		double LeftValue = 0.0;
+		LpTokenType LeftComparison = LP_END;
+		if (IsValueStart()) {
+			if (const char* Error = ReadValue(LeftValue)) { return Error; }
+			if (!IsComparison()) {
+				return "Comparison is expected";
+			}
+			LeftComparison = Token.Type;
+			if (const char* Error = Next()) { return Error; }
+		}
+
+		if (Token.Type != LP_NAME || Token.IsLabel) {
+			return "Variable is expected";
+		}
+		int Column = FindColumn(Token.Text);
+		double& Lower = problem.LowerBounds[Column];
+		double& Upper = problem.UpperBounds[Column];
+		if (const char* Error = Next()) { return Error; }
+
+		// Value on the left is compared with the variable, so its sign is the opposite
+		if (LeftComparison == LP_LESS || LeftComparison == LP_EQUAL) { Lower = LeftValue; }
+		if (LeftComparison == LP_GREATER || LeftComparison == LP_EQUAL) { Upper = LeftValue; }
+
+		if (LeftComparison == LP_END && Token.Type == LP_NAME && IsWord(Token.Text, "free")) {
+			Lower = -INFINITY;
+			Upper = INFINITY;
+			return Next();
+		}
+		if (IsComparison() && LeftComparison != LP_EQUAL) {
+			LpTokenType Comparison = Token.Type;
+			if (const char* Error = Next()) { return Error; }
+			double Value;
+			if (const char* Error = ReadValue(Value)) { return Error; }
+			if (Comparison != LP_GREATER) { Upper = Value; }
+			if (Comparison != LP_LESS) { Lower = Value; }
+		} else if (LeftComparison == LP_END) {
+			return "Bound has no comparison";
+		}
+		return NULL;
+	}
+
+	const char* Read() {
+		if (const char* Error = Next()) { return Error; }
+		// The first token starts a line even if the file doesn't start with a line feed
+		Token.IsLineStart = true;
+		Section = SectionKeyword();
+		if (Section != LP_SECTION_OBJECTIVE) {
+			return "File doesn't start with Minimize or Maximize";
+		}
+
+		while (Section != LP_SECTION_END) {
+			if (Section == LP_SECTION_UNSUPPORTED) {
+				return "Section isn't supported";
+			}
+			if (Section == LP_SECTION_OBJECTIVE) {
+				problem.IsMaximization = tolower((unsigned char)Token.Text.Begin[1]) == 'a';
+			}
+			if (Section == LP_SECTION_CONSTRAINTS && (IsWord(Token.Text, "subject") || IsWord(Token.Text, "such"))) {
+				if (const char* Error = Next()) { return Error; }
+			}
+			if (const char* Error = Next()) { return Error; }
+
+			LpSection NextSection;
+			while ((NextSection = SectionKeyword()) == LP_SECTION_NONE) {
+				const char* Error = NULL;
+				switch (Section) {
+				case LP_SECTION_OBJECTIVE: Error = ReadObjective(); break;
+				case LP_SECTION_CONSTRAINTS: Error = ReadConstraint(); break;
+				case LP_SECTION_BOUNDS: Error = ReadBound(); break;
+				case LP_SECTION_GENERAL:
+					if (Token.Type == LP_NAME) {
+						FindColumn(Token.Text);
+						Error = Next();
+					} else {
+						Error = "Variable is expected";
+					}
+					break;
+				case LP_SECTION_BINARY:
+					if (Token.Type == LP_NAME) {
+						int Column = FindColumn(Token.Text);
+						problem.LowerBounds[Column] = 0.0;
+						problem.UpperBounds[Column] = 1.0;
+						Error = Next();
+					} else {
+						Error = "Variable is expected";
+					}
+					break;
+				default: break;
+				}
+				if (Error) {
+					return Error;
+				}
+			}
+			Section = NextSection;
+		}
+		return NULL;
+	}
+
+	// Elements are read by rows, sparse problem keeps them by columns
+	void Finish() {
+		int ColumnCount = problem.ColumnNames.size();
+		problem.ColumnStarts.assign(ColumnCount + 1, 0);
+		for (int Column : ElementColumns) {
+			problem.ColumnStarts[Column + 1] += 1;
+		}
+		for (int j = 0; j < ColumnCount; j++) {
+			problem.ColumnStarts[j + 1] += problem.ColumnStarts[j];
+		}
+
+		std::vector<int> Positions(problem.ColumnStarts.begin(), problem.ColumnStarts.end() - 1);
+		problem.RowIndices.resize(ElementValues.size());
+		problem.Values.resize(ElementValues.size());
+		for (size_t k = 0; k < ElementValues.size(); k++) {
+			int Index = Positions[ElementColumns[k]]++;
+			problem.RowIndices[Index] = ElementRows[k];
+			problem.Values[Index] = ElementValues[k];
+		}
+	}
+};
+
+const char* ReadLp(const char* FileName, SparseProblem& problem, ReadStatistics& Statistics) {
+	auto Start = std::chrono::steady_clock::now();
+	FILE* file = fopen(FileName, "rb");
+	if (!file) {
+		return "Can't open file";
+	}
+
+	// Expressions can continue on the next lines, so the whole file is read at once
+	std::vector<char> Text;
+	const size_t BlockSize = 1 << 20;
+	size_t Size = 0;
+	while (true) {
+		Text.resize(Size + BlockSize + 1);
+		size_t Read = fread(Text.data() + Size, 1, BlockSize, file);
+		Size += Read;
+		if (Read < BlockSize) {
+			break;
+		}
+	}
+	fclose(file);
+	Text[Size] = '\0';
+	Statistics.Bytes = Size;
+
+	problem = SparseProblem();
+	LpReader Reader(problem, Text.data(), Size);
+	const char* Error = NULL;
+	if (strlen(Text.data()) != Size) {
+		Error = "File has zero characters";
+	} else {
+		Error = Reader.Read();
+	}
+
+	if (Error) {
+		Statistics.ErrorLine = Reader.Token.Line;
+	} else {
+		Reader.Finish();
+		Statistics.Elements = problem.Values.size();
+	}
+	Statistics.Lines = Reader.Line;
+	Statistics.Milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+	return Error;
+}
+
+const char* LoadLpProblem(const char* FileName, bool IsFractionalCoefficients, Problem& problem, ReadStatistics& Statistics) {
+	SparseProblem Sparse;
+	const char* Error = ReadLp(FileName, Sparse, Statistics);
+	if (Error) {
+		return Error;
+	}
+	return MakeStandardProblem(Sparse, IsFractionalCoefficients, problem);
+}
+
+static void WriteLpNumber(FILE* file, float Value) {
+	fprintf(file, "%.9g", Value);
+}
+
+// Fractions that aren't integers are written with all digits of double, they are read back by continued fractions
+static void WriteLpNumber(FILE* file, Fraction Value) {
+	if (Value.denominator == 1) {
+		fprintf(file, "%d", Value.numerator);
+	} else {
+		fprintf(file, "%.17g", ToDouble(Value));
+	}
+}
+
+// Writes " + 2 x3", the first term of a line has no plus
+template<typename ElementType> void WriteLpTerm(FILE* file, ElementType Value, int Variable, bool IsFirst) {
+	bool IsNegative = ToDouble(Value) < 0.0;
+	if (IsNegative) {
+		Value = -Value;
+	}
+	fputs(IsFirst ? (IsNegative ? "-" : "") : (IsNegative ? " - " : " + "), file);
+	if (ToDouble(Value) != 1.0) {
+		WriteLpNumber(file, Value);
+		fprintf(file, " ");
+	}
+	fprintf(file, "x%d", Variable + 1);
+}
+
+// Writes problem in the layout of the GUI: equalities of rows of the matrix except the last one,
+// non-negative variables x1...xn and minimum of the target function.
+// All variables are in the objective, even with zero coefficients, so they are read back in the same order
+template<typename MatrixType, typename ElementType> const char* WriteLp(const char* FileName, MatrixType& matrix, std::vector<ElementType>& TargetFunction) {
+	FILE* file = fopen(FileName, "w");
+	if (!file) {
+		return "Can't open file";
+	}
+
+	const int TermsInLine = 8;
+	int NumberOfVariables = matrix.ColNumber - 1;
+	fprintf(file, "\\ Problem of the simplex method: %d limitations, %d variables\n", matrix.RowNumber - 1, NumberOfVariables);
+	fprintf(file, "Minimize\n obj: ");
+	for (int j = 0; j < NumberOfVariables; j++) {
+		if (j != 0 && j % TermsInLine == 0) {
+			fprintf(file, "\n     ");
+		}
+		if (ToDouble(TargetFunction[j]) == 0.0) {
+			fprintf(file, j == 0 ? "0 x%d" : " + 0 x%d", j + 1);
+		} else {
+			WriteLpTerm(file, TargetFunction[j], j, j == 0);
+		}
+	}
+	ElementType Constant = TargetFunction[NumberOfVariables];
+	if (ToDouble(Constant) != 0.0) {
+		fputs(ToDouble(Constant) < 0.0 ? " - " : " + ", file);
+		WriteLpNumber(file, ToDouble(Constant) < 0.0 ? -Constant : Constant);
+	}
+
+	fprintf(file, "\nSubject To\n");
+	for (int i = 0; i < matrix.RowNumber - 1; i++) {
+		fprintf(file, " c%d: ", i + 1);
+		int Terms = 0;
+		for (int j = 0; j < NumberOfVariables; j++) {
+			if (ToDouble(matrix[i][j]) == 0.0) {
+				continue;
+			}
+			if (Terms != 0 && Terms % TermsInLine == 0) {
+				fprintf(file, "\n     ");
+			}
+			WriteLpTerm(file, matrix[i][j], j, Terms == 0);
+			Terms += 1;
+		}
+		if (Terms == 0) {
+			fprintf(file, "0 x1");
+		}
+		fprintf(file, " = ");
+		WriteLpNumber(file, matrix[i][NumberOfVariables]);
+		fprintf(file, "\n");
+	}
+	fprintf(file, "End\n");
+
+	bool IsWritten = !ferror(file);
+	return fclose(file) == 0 && IsWritten ? NULL : "Can't write file";
+}
@@ -0,0 +1,836 @@
+#pragma once
+
+// Problems in MPS format, fixed and free.
+// File is read in one pass by big blocks, lines are split into fields without copying and elements
+// of the matrix go straight into sparse columns. Dense matrix is made only when the problem
+// is turned into the form the solver works with: equalities, non-negative variables and minimum
+
+struct SparseProblem {
+	std::string Name;
+	bool IsMaximization = false;
+	std::vector<std::string> RowNames;
+	std::vector<std::string> ColumnNames;
+	// Limits of a row: RowLower <= a * x <= RowUpper, infinite if there is no limit
+	std::vector<double> RowLower;
+	std::vector<double> RowUpper;
+	// Matrix by columns: elements of column j are at [ColumnStarts[j], ColumnStarts[j + 1])
+	std::vector<int> ColumnStarts;
+	std::vector<int> RowIndices;
+	std::vector<double> Values;
+	std::vector<double> Objective;
+	double ObjectiveConstant = 0.0;
+	std::vector<double> LowerBounds;
+	std::vector<double> UpperBounds;
+};
+
+// What reading of a file has taken
+struct ReadStatistics {
+	long long Bytes = 0;
+	int Lines = 0;
+	long long Elements = 0;
+	double Milliseconds = 0.0;
+	// Line of the error, 0 if there was no error
+	int ErrorLine = 0;
+	// Column of the error, 0 if the reader knows only the line
+	int ErrorColumn = 0;
+};
+
+// Biggest table the dense solver is given, elements of both real and fractional matrices are allocated
+const long long MaxDenseElements = 50000000;
+
+// Part of a line, not terminated by zero
+struct TextField {
+	const char* Begin = NULL;
+	int Length = 0;
+
+	bool Is(const char* Text) const {
+		return Length == (int)strlen(Text) && memcmp(Begin, Text, Length) == 0;
+	}
+};
+
+// Numbers of names of rows and columns. Hashes and entries are kept in one open addressing table,
+// so a lookup touches a couple of cache lines instead of a node of std::unordered_map somewhere in the memory
+struct NameIndex {
+	struct Slot {
+		uint32_t Hash;
+		int Entry;
+	};
+	std::vector<Slot> Slots;
+	std::vector<std::string> Names;
+	std::vector<int> Values;
+
+	static uint32_t HashOf(TextField Name) {
+		uint32_t Hash = 2166136261u;
+		for (int i = 0; i < Name.Length; i++) {
+			Hash = (Hash ^ (unsigned char)Name.Begin[i]) * 16777619u;
+		}
+		return Hash;
+	}
+
+	// Returns number of the name or Missing if there's no such name
+	int Find(TextField Name, int Missing) const {
+		if (Slots.empty()) {
+			return Missing;
+		}
+		uint32_t Hash = HashOf(Name);
+		size_t Mask = Slots.size() - 1;
+		for (size_t i = Hash & Mask; Slots[i].Entry != -1; i = (i + 1) & Mask) {
+			const std::string& Other = Names[Slots[i].Entry];
+			if (Slots[i].Hash == Hash && Other.size() == (size_t)Name.Length && memcmp(Other.data(), Name.Begin, Name.Length) == 0) {
+				return Values[Slots[i].Entry];
+			}
+		}
+		return Missing;
+	}
+
+	// Name must not be in the index yet
+	void Add(TextField Name, int Value) {
+		// Table is at most half full, so chains of slots stay short
+		if ((Names.size() + 1) * 2 > Slots.size()) {
+			std::vector<Slot> OldSlots(std::max<size_t>(1024, Slots.size() * 2), Slot{ 0, -1 });
+			OldSlots.swap(Slots);
+			for (Slot& slot : OldSlots) {
+				if (slot.Entry != -1) {
+					Insert(slot);
+				}
+			}
+		}
+		Insert(Slot{ HashOf(Name), (int)Names.size() });
+		Names.emplace_back(Name.Begin, Name.Length);
+		Values.push_back(Value);
+	}
+
+	void Insert(Slot slot) {
+		size_t Mask = Slots.size() - 1;
+		size_t i = slot.Hash & Mask;
+		while (Slots[i].Entry != -1) {
+			i = (i + 1) & Mask;
+		}
+		Slots[i] = slot;
+	}
+};
+
+// Number of the whole field, "Inf" and "Infinity" with any case and sign are infinite
+static bool ParseNumber(TextField Field, double& Value) {
+	const char* End = Field.Begin + Field.Length;
+	DecimalNumber Number;
+	if (ScanDecimal(Field.Begin, End, Number) == End) {
+		Value = DecimalToDouble(Number);
+		return true;
+	}
+
+	TextField Word = Field;
+	bool IsNegative = Word.Length > 0 && Word.Begin[0] == '-';
+	if (Word.Length > 0 && (Word.Begin[0] == '-' || Word.Begin[0] == '+')) {
+		Word.Begin++;
+		Word.Length--;
+	}
+	if (Word.Length != 3 && Word.Length != 8) {
+		return false;
+	}
+	for (int i = 0; i < Word.Length; i++) {
+		if (tolower((unsigned char)Word.Begin[i]) != "infinity"[i]) {
+			return false;
+		}
+	}
+	Value = IsNegative ? -INFINITY : INFINITY;
+	return true;
+}
+
+enum MpsSection {
+	MPS_NONE,
+	MPS_NAME,
+	MPS_OBJSENSE,
+	MPS_ROWS,
+	MPS_COLUMNS,
+	MPS_RHS,
+	MPS_RANGES,
+	MPS_BOUNDS,
+	MPS_ENDATA,
+};
+
+// Row numbers of the names map that aren't rows of the matrix
+const int MpsObjectiveRow = -1;
+const int MpsFreeRow = -2;
+
+struct MpsReader {
+	SparseProblem& problem;
+	MpsSection Section = MPS_NONE;
+	NameIndex Rows;
+	NameIndex Columns;
+	std::vector<char> RowTypes;
+	std::vector<double> RightHandSide;
+	std::vector<double> Ranges;
+	std::string RhsSet;
+	std::string RangesSet;
+	std::string BoundsSet;
+	bool IsObjectiveFound = false;
+
+	// Fields as in fixed format: code, two names and two numbers after the second and the third name
+	TextField Fields[6];
+
+	MpsReader(SparseProblem& problem) : problem(problem) {}
+
+	int FindRow(TextField Name) {
+		return Rows.Find(Name, INT32_MIN);
+	}
+
+	int FindColumn(TextField Name) {
+		return Columns.Find(Name, -1);
+	}
+
+	// Free format: fields are separated by spaces, names can't have spaces inside
+	static int SplitTokens(const char* Line, int Length, TextField* Tokens, int MaxTokens) {
+		int Count = 0;
+		int i = 0;
+		while (i < Length) {
+			while (i < Length && (Line[i] == ' ' || Line[i] == '\t')) { i++; }
+			if (i == Length) { break; }
+			if (Count == MaxTokens) { return MaxTokens + 1; }
+			Tokens[Count].Begin = Line + i;
+			while (i < Length && Line[i] != ' ' && Line[i] != '\t') { i++; }
+			Tokens[Count].Length = Line + i - Tokens[Count].Begin;
+			Count += 1;
+		}
+		return Count;
+	}
+
+	// Fixed format has spaces between its fields
+	static bool IsFixedLayout(const char* Line, int Length) {
+		static const int Gaps[] = { 0, 3, 12, 13, 22, 23, 36, 37, 38, 47, 48 };
+		if (Length > 61) {
+			return false;
+		}
+		for (int Gap : Gaps) {
+			if (Gap < Length && Line[Gap] != ' ') {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Fixed format: fields are in columns 2-3, 5-12, 15-22, 25-36, 40-47 and 50-61, names can have spaces
+	void SplitFixed(const char* Line, int Length) {
+		static const int Starts[6] = { 1, 4, 14, 24, 39, 49 };
+		static const int Ends[6] = { 3, 12, 22, 36, 47, 61 };
+		for (int f = 0; f < 6; f++) {
+			int Start = std::min(Starts[f], Length);
+			int End = std::min(Ends[f], Length);
+			while (Start < End && Line[Start] == ' ') { Start++; }
+			while (End > Start && Line[End - 1] == ' ') { End--; }
+			Fields[f].Begin = Line + Start;
+			Fields[f].Length = End - Start;
+		}
+	}
+
+	// Puts tokens of a free format line into fixed format fields.
+	// Set names of RHS, RANGES and BOUNDS may be left out, it's found out from the number of tokens
+	bool SplitFree(const char* Line, int Length) {
+		TextField Tokens[6];
+		int Count = SplitTokens(Line, Length, Tokens, 6);
+		for (int f = 0; f < 6; f++) {
+			Fields[f] = TextField();
+		}
+
+		switch (Section) {
+		case MPS_ROWS:
+			if (Count != 2) { return false; }
+			Fields[0] = Tokens[0];
+			Fields[1] = Tokens[1];
+			return true;
+		case MPS_COLUMNS:
+			if (Count != 3 && Count != 5) { return false; }
+			for (int t = 0; t < Count; t++) {
+				Fields[t + 1] = Tokens[t];
+			}
+			return true;
+		case MPS_RHS:
+		case MPS_RANGES: {
+			if (Count < 2 || Count > 5) { return false; }
+			int First = Count % 2 == 0 ? 2 : 1;
+			for (int t = 0; t < Count; t++) {
+				Fields[t + First] = Tokens[t];
+			}
+			return true;
+		}
+		case MPS_BOUNDS: {
+			if (Count < 2 || Count > 4) { return false; }
+			Fields[0] = Tokens[0];
+			bool HasValue = !(Tokens[0].Is("FR") || Tokens[0].Is("MI") || Tokens[0].Is("PL") || Tokens[0].Is("BV"));
+			int NameTokens = Count - 1 - (HasValue ? 1 : 0);
+			if (NameTokens == 2) {
+				Fields[1] = Tokens[1];
+				Fields[2] = Tokens[2];
+			} else if (NameTokens == 1) {
+				Fields[2] = Tokens[1];
+			} else {
+				return false;
+			}
+			if (HasValue) {
+				Fields[3] = Tokens[Count - 1];
+			}
+			return true;
+		}
+		default:
+			return false;
+		}
+	}
+
+	const char* StartSection(const char* Line, int Length) {
+		TextField Tokens[3];
+		int Count = SplitTokens(Line, Length, Tokens, 3);
+		TextField Name = Tokens[0];
+		if (Name.Is("NAME")) {
+			Section = MPS_NAME;
+			if (Count > 1) {
+				problem.Name.assign(Tokens[1].Begin, Line + Length - Tokens[1].Begin);
+			}
+		} else if (Name.Is("OBJSENSE")) {
+			Section = MPS_OBJSENSE;
+			if (Count > 1) {
+				return ReadObjectiveSense(Tokens[1]);
+			}
+		} else if (Name.Is("ROWS")) {
+			Section = MPS_ROWS;
+		} else if (Name.Is("COLUMNS")) {
+			Section = MPS_COLUMNS;
+		} else if (Name.Is("RHS")) {
+			Section = MPS_RHS;
+		} else if (Name.Is("RANGES")) {
+			Section = MPS_RANGES;
+		} else if (Name.Is("BOUNDS")) {
+			Section = MPS_BOUNDS;
+		} else if (Name.Is("ENDATA")) {
+			Section = MPS_ENDATA;
+		} else {
+			return "Unknown section of MPS file";
+		}
+		return NULL;
+	}
+
+	const char* ReadObjectiveSense(TextField Sense) {
+		if (Sense.Is("MAX") || Sense.Is("MAXIMIZE")) {
+			problem.IsMaximization = true;
+		} else if (Sense.Is("MIN") || Sense.Is("MINIMIZE")) {
+			problem.IsMaximization = false;
+		} else {
+			return "Unknown objective sense";
+		}
+		return NULL;
+	}
+
+	// Lines are read twice if they aren't free format, so nothing is changed until the whole line is checked
+	const char* ReadRow() {
+		TextField Type = Fields[0];
+		TextField Name = Fields[1];
+		if (Name.Length == 0) {
+			return "Row has no name";
+		}
+		if (FindRow(Name) != INT32_MIN) {
+			return "Row is defined twice";
+		}
+
+		int Row;
+		if (Type.Is("N")) {
+			// The first free row is the objective, the rest are ignored
+			Row = IsObjectiveFound ? MpsFreeRow : MpsObjectiveRow;
+			IsObjectiveFound = true;
+		} else if (Type.Is("E") || Type.Is("L") || Type.Is("G")) {
+			Row = problem.RowNames.size();
+			problem.RowNames.emplace_back(Name.Begin, Name.Length);
+			RowTypes.push_back(Type.Begin[0]);
+			RightHandSide.push_back(0.0);
+			Ranges.push_back(NAN);
+		} else {
+			return "Unknown type of row";
+		}
+
+		Rows.Add(Name, Row);
+		return NULL;
+	}
+
+	// Reads pairs of row and number. Returns number of pairs or -1 if the line is wrong
+	int ReadPairs(int PairRows[2], double PairValues[2], const char*& Error, const char* NumberError) {
+		int Count = 0;
+		for (int Pair = 0; Pair < 2; Pair++) {
+			TextField RowName = Fields[2 + Pair * 2];
+			if (RowName.Length == 0) {
+				continue;
+			}
+			if (!ParseNumber(Fields[3 + Pair * 2], PairValues[Count])) {
+				Error = NumberError;
+				return -1;
+			}
+			PairRows[Count] = FindRow(RowName);
+			if (PairRows[Count] == INT32_MIN) {
+				Error = "Unknown row";
+				return -1;
+			}
+			Count += 1;
+		}
+		return Count;
+	}
+
+	const char* ReadColumn() {
+		// Markers of integer variables, integrality is ignored
+		if (Fields[2].Is("'MARKER'")) {
+			return NULL;
+		}
+
+		int PairRows[2];
+		double PairValues[2];
+		const char* Error = NULL;
+		int Pairs = ReadPairs(PairRows, PairValues, Error, "Can't read element of the matrix");
+		if (Pairs == -1) {
+			return Error;
+		}
+
+		int Column = problem.ColumnNames.size() - 1;
+		if (Column < 0 || !(Fields[1].Length == (int)problem.ColumnNames[Column].size() && memcmp(Fields[1].Begin, problem.ColumnNames[Column].data(), Fields[1].Length) == 0)) {
+			// Elements of one column go one after another
+			if (FindColumn(Fields[1]) != -1) {
+				return "Column is split into parts";
+			}
+			Column = problem.ColumnNames.size();
+			problem.ColumnNames.emplace_back(Fields[1].Begin, Fields[1].Length);
+			Columns.Add(Fields[1], Column);
+			problem.ColumnStarts.push_back(problem.Values.size());
+			problem.Objective.push_back(0.0);
+			problem.LowerBounds.push_back(0.0);
+			problem.UpperBounds.push_back(INFINITY);
+		}
+
+		for (int Pair = 0; Pair < Pairs; Pair++) {
+			int Row = PairRows[Pair];
+			double Value = PairValues[Pair];
+			if (Row == MpsObjectiveRow) {
+				problem.Objective[Column] = Value;
+			} else if (Row != MpsFreeRow && Value != 0.0) {
+				problem.RowIndices.push_back(Row);
+				problem.Values.push_back(Value);
+			}
+		}
+		return NULL;
+	}
+
+	// Only the first set of RHS and RANGES is used
+	static bool IsOtherSet(TextField Set, std::string& FirstSet) {
+		if (FirstSet.empty()) {
+			FirstSet.assign(Set.Begin, Set.Length);
+			// Unnamed set is still a set
+			if (FirstSet.empty()) {
+				FirstSet = " ";
+			}
+			return false;
+		}
+		return Set.Length == 0 ? FirstSet != " " : !(Set.Length == (int)FirstSet.size() && memcmp(Set.Begin, FirstSet.data(), Set.Length) == 0);
+	}
+
+	const char* ReadRightHandSide(bool IsRange) {
+		int PairRows[2];
+		double PairValues[2];
+		const char* Error = NULL;
+		int Pairs = ReadPairs(PairRows, PairValues, Error, IsRange ? "Can't read range" : "Can't read right hand side");
+		if (Pairs == -1 || IsOtherSet(Fields[1], IsRange ? RangesSet : RhsSet)) {
+			return Error;
+		}
+
+		for (int Pair = 0; Pair < Pairs; Pair++) {
+			int Row = PairRows[Pair];
+			double Value = PairValues[Pair];
+			if (Row >= 0) {
+				(IsRange ? Ranges : RightHandSide)[Row] = Value;
+			} else if (Row == MpsObjectiveRow && !IsRange) {
+				// Right hand side of the objective is minus its constant
+				problem.ObjectiveConstant = -Value;
+			}
+		}
+		return NULL;
+	}
+
+	const char* ReadBound() {
+		int Column = FindColumn(Fields[2]);
+		if (Column == -1) {
+			return "Unknown column in bounds";
+		}
+
+		TextField Type = Fields[0];
+		double Value = 0.0;
+		if (Fields[3].Length != 0 && !ParseNumber(Fields[3], Value)) {
+			return "Can't read bound";
+		}
+		if (IsOtherSet(Fields[1], BoundsSet)) {
+			return NULL;
+		}
+
+		double& Lower = problem.LowerBounds[Column];
+		double& Upper = problem.UpperBounds[Column];
+		if (Type.Is("UP") || Type.Is("UI") || Type.Is("SC")) {
+			Upper = Value;
+			// Negative upper bound of a variable without lower bound makes it unbounded below
+			if (Value < 0.0 && Lower == 0.0) {
+				Lower = -INFINITY;
+			}
+		} else if (Type.Is("LO") || Type.Is("LI")) {
+			Lower = Value;
+		} else if (Type.Is("FX")) {
+			Lower = Value;
+			Upper = Value;
+		} else if (Type.Is("FR")) {
+			Lower = -INFINITY;
+			Upper = INFINITY;
+		} else if (Type.Is("MI")) {
+			Lower = -INFINITY;
+		} else if (Type.Is("PL")) {
+			Upper = INFINITY;
+		} else if (Type.Is("BV")) {
+			Lower = 0.0;
+			Upper = 1.0;
+		} else {
+			return "Unknown type of bound";
+		}
+		return NULL;
+	}
+
+	const char* ReadLine(const char* Line, int Length) {
+		// Empty lines and comments
+		int First = 0;
+		while (First < Length && (Line[First] == ' ' || Line[First] == '\t')) { First++; }
+		if (First == Length || Line[0] == '*') {
+			return NULL;
+		}
+
+		// Sections start in the first column
+		if (First == 0) {
+			return StartSection(Line, Length);
+		}
+
+		if (Section == MPS_OBJSENSE) {
+			TextField Tokens[1];
+			if (SplitTokens(Line, Length, Tokens, 1) != 1) {
+				return "Unknown objective sense";
+			}
+			return ReadObjectiveSense(Tokens[0]);
+		}
+		if (Section == MPS_NONE || Section == MPS_NAME || Section == MPS_ENDATA) {
+			return "Data outside of a section";
+		}
+
+		// Line is read as free format first, names with spaces are read as fixed format
+		bool IsSplit = SplitFree(Line, Length);
+		for (int Attempt = 0; Attempt < 2; Attempt++) {
+			const char* Error = "Wrong number of fields";
+			if (IsSplit) {
+				switch (Section) {
+				case MPS_ROWS: Error = ReadRow(); break;
+				case MPS_COLUMNS: Error = ReadColumn(); break;
+				case MPS_RHS: Error = ReadRightHandSide(false); break;
+				case MPS_RANGES: Error = ReadRightHandSide(true); break;
+				case MPS_BOUNDS: Error = ReadBound(); break;
+				default: break;
+				}
+			}
+			if (!Error || Attempt == 1 || !IsFixedLayout(Line, Length)) {
+				return Error;
+			}
+
+			SplitFixed(Line, Length);
+			IsSplit = true;
+		}
+		return NULL;
+	}
+
+	// Turns right hand sides and ranges into limits of rows
+	void Finish() {
+		problem.ColumnStarts.push_back(problem.Values.size());
+
+		int RowCount = problem.RowNames.size();
+		problem.RowLower.resize(RowCount);
+		problem.RowUpper.resize(RowCount);
+		for (int i = 0; i < RowCount; i++) {
+			double Rhs = RightHandSide[i];
+			double Range = Ranges[i];
+			double& Lower = problem.RowLower[i];
+			double& Upper = problem.RowUpper[i];
+			switch (RowTypes[i]) {
+			case 'E':
+				Lower = Rhs;
+				Upper = Rhs;
+				if (!std::isnan(Range)) {
+					(Range > 0.0 ? Upper : Lower) = Rhs + Range;
+				}
+				break;
+			case 'L':
+				Lower = std::isnan(Range) ? -INFINITY : Rhs - fabs(Range);
+				Upper = Rhs;
+				break;
+			case 'G':
+				Lower = Rhs;
+				Upper = std::isnan(Range) ? INFINITY : Rhs + fabs(Range);
+				break;
+			}
+		}
+	}
+};
+
+const char* ReadMps(const char* FileName, SparseProblem& problem, ReadStatistics& Statistics) {
+	auto Start = std::chrono::steady_clock::now();
+	FILE* file = fopen(FileName, "rb");
+	if (!file) {
+		return "Can't open file";
+	}
+
+	problem = SparseProblem();
+	MpsReader Reader(problem);
+	const char* Error = NULL;
+
+	// Block is read after the incomplete line left from the previous one
+	const size_t BlockSize = 1 << 20;
+	std::vector<char> Buffer(BlockSize * 2);
+	size_t Left = 0;
+	bool IsEnd = false;
+	while (!IsEnd && !Error && Reader.Section != MPS_ENDATA) {
+		if (Buffer.size() - Left < BlockSize) {
+			Buffer.resize(Left + BlockSize);
+		}
+		size_t Read = fread(Buffer.data() + Left, 1, BlockSize, file);
+		Statistics.Bytes += Read;
+		IsEnd = Read < BlockSize;
+		size_t Size = Left + Read;
+
+		const char* LineStart = Buffer.data();
+		const char* BufferEnd = Buffer.data() + Size;
+		while (!Error) {
+			const char* LineEnd = (const char*)memchr(LineStart, '\n', BufferEnd - LineStart);
+			if (!LineEnd) {
+				if (!IsEnd || LineStart == BufferEnd) {
+					break;
+				}
+				// Last line without line feed
+				LineEnd = BufferEnd;
+			}
+
+			int Length = LineEnd - LineStart;
+			if (Length > 0 && LineStart[Length - 1] == '\r') {
+				Length -= 1;
+			}
+			Statistics.Lines += 1;
+			Error = Reader.ReadLine(LineStart, Length);
+			LineStart = LineEnd == BufferEnd ? BufferEnd : LineEnd + 1;
+			if (Reader.Section == MPS_ENDATA) {
+				break;
+			}
+		}
+
+		Left = BufferEnd - LineStart;
+		memmove(Buffer.data(), LineStart, Left);
+	}
+	fclose(file);
+
+	if (Error) {
+		Statistics.ErrorLine = Statistics.Lines;
+	} else if (!Reader.IsObjectiveFound && problem.ColumnNames.empty()) {
+		Error = "File has no problem in MPS format";
+	} else {
+		Reader.Finish();
+		Statistics.Elements = problem.Values.size();
+	}
+	Statistics.Milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+	return Error;
+}
+
+// Fraction that is equal to a number of the file. Convergents of the continued fraction find both
+// decimal numbers and fractions that were written with all digits of double.
+// Returns false if it doesn't fit into Fraction
+static bool ToFraction(double Value, Fraction& Result) {
+	if (!(fabs(Value) < INT32_MAX)) {
+		return false;
+	}
+	double Tolerance = 1e-12 * std::max(1.0, fabs(Value));
+	double PreviousNumerator = 1.0;
+	double PreviousDenominator = 0.0;
+	double Numerator = floor(Value);
+	double Denominator = 1.0;
+	double Rest = Value - Numerator;
+	while (fabs(Value - Numerator / Denominator) > Tolerance) {
+		Rest = 1.0 / Rest;
+		double Term = floor(Rest);
+		Rest -= Term;
+		double NextNumerator = Term * Numerator + PreviousNumerator;
+		double NextDenominator = Term * Denominator + PreviousDenominator;
+		if (fabs(NextNumerator) >= INT32_MAX || NextDenominator >= INT32_MAX) {
+			return false;
+		}
+		PreviousNumerator = Numerator;
+		PreviousDenominator = Denominator;
+		Numerator = NextNumerator;
+		Denominator = NextDenominator;
+	}
+	Result = Fraction((int)Numerator, (int)Denominator);
+	return true;
+}
+
+// Makes problem the solver works with. Every variable becomes non-negative:
+// variable with lower bound l is l + x', with only upper bound u is u - x', free variable is x' - x''.
+// Inequalities and upper bounds get slack variables, range l <= a * x <= u is a * x - s = l with s <= u - l.
+// Maximization is solved as minimization of -f, problem keeps the sense to give the objective its sign back
+const char* MakeStandardProblem(SparseProblem& Sparse, bool IsFractionalCoefficients, Problem& problem) {
+	int RowCount = Sparse.RowNames.size();
+	int ColumnCount = Sparse.ColumnNames.size();
+	double Sense = Sparse.IsMaximization ? -1.0 : 1.0;
+
+	// Standard variables of every column: first index, sign and how many
+	struct ColumnMapping {
+		int First;
+		double Sign;
+		bool IsSplit;
+		double Shift;
+	};
+	std::vector<ColumnMapping> Mapping(ColumnCount);
+	int Variables = 0;
+	int ExtraRows = 0;
+	for (int j = 0; j < ColumnCount; j++) {
+		double Lower = Sparse.LowerBounds[j];
+		double Upper = Sparse.UpperBounds[j];
+		if (Lower > Upper) {
+			return "Lower bound of a variable is bigger than upper bound";
+		}
+		ColumnMapping& Map = Mapping[j];
+		Map.First = Variables;
+		Map.IsSplit = std::isinf(Lower) && std::isinf(Upper);
+		Map.Sign = !std::isinf(Lower) || Map.IsSplit ? 1.0 : -1.0;
+		Map.Shift = !std::isinf(Lower) ? Lower : (Map.IsSplit ? 0.0 : Upper);
+		Variables += Map.IsSplit ? 2 : 1;
+		// Upper bound of a shifted variable is a row with a slack
+		if (!std::isinf(Lower) && !std::isinf(Upper)) {
+			ExtraRows += 1;
+			Variables += 1;
+		}
+	}
+
+	// Rows without limits aren't limitations
+	std::vector<int> RowMapping(RowCount, -1);
+	int Limitations = 0;
+	for (int i = 0; i < RowCount; i++) {
+		double Lower = Sparse.RowLower[i];
+		double Upper = Sparse.RowUpper[i];
+		if (Lower > Upper) {
+			return "Range of a row is empty";
+		}
+		if (std::isinf(Lower) && std::isinf(Upper)) {
+			continue;
+		}
+		RowMapping[i] = Limitations++;
+		if (Lower != Upper) {
+			Variables += 1;
+			if (!std::isinf(Lower) && !std::isinf(Upper)) {
+				ExtraRows += 1;
+				Variables += 1;
+			}
+		}
+	}
+	Limitations += ExtraRows;
+
+	if (Limitations == 0 || Variables == 0) {
+		return "Problem has no limitations";
+	}
+	if ((long long)(Limitations + 1) * (Variables + 1) > MaxDenseElements) {
+		return "Problem is too big for the table of the simplex method";
+	}
+
+	std::vector<double> A((size_t)Limitations * (Variables + 1), 0.0);
+	std::vector<double> C(Variables + 1, 0.0);
+	auto Element = [&](int Row, int Column) -> double& { return A[(size_t)Row * (Variables + 1) + Column]; };
+	int B = Variables;
+
+	// Right hand sides, shifts of variables move them later
+	for (int i = 0; i < RowCount; i++) {
+		if (RowMapping[i] != -1) {
+			Element(RowMapping[i], B) = std::isinf(Sparse.RowLower[i]) ? Sparse.RowUpper[i] : Sparse.RowLower[i];
+		}
+	}
+
+	int NextRow = Limitations - ExtraRows;
+	int NextVariable = 0;
+	for (int j = 0; j < ColumnCount; j++) {
+		ColumnMapping& Map = Mapping[j];
+		NextVariable = std::max(NextVariable, Map.First + (Map.IsSplit ? 2 : 1));
+		for (int k = Sparse.ColumnStarts[j]; k < Sparse.ColumnStarts[j + 1]; k++) {
+			int Row = RowMapping[Sparse.RowIndices[k]];
+			if (Row == -1) {
+				continue;
+			}
+			double Value = Sparse.Values[k];
+			Element(Row, Map.First) += Map.Sign * Value;
+			if (Map.IsSplit) {
+				Element(Row, Map.First + 1) -= Value;
+			}
+			Element(Row, B) -= Value * Map.Shift;
+		}
+
+		double Cost = Sense * Sparse.Objective[j];
+		C[Map.First] = Map.Sign * Cost;
+		if (Map.IsSplit) {
+			C[Map.First + 1] = -Cost;
+		}
+		C[Variables] += Cost * Map.Shift;
+
+		// x' + s = u - l
+		if (!std::isinf(Sparse.LowerBounds[j]) && !std::isinf(Sparse.UpperBounds[j])) {
+			int Slack = Map.First + 1;
+			Element(NextRow, Map.First) = 1.0;
+			Element(NextRow, Slack) = 1.0;
+			Element(NextRow, B) = Sparse.UpperBounds[j] - Sparse.LowerBounds[j];
+			NextRow += 1;
+			NextVariable = Slack + 1;
+		}
+	}
+
+	// Slacks of inequalities
+	for (int i = 0; i < RowCount; i++) {
+		int Row = RowMapping[i];
+		double Lower = Sparse.RowLower[i];
+		double Upper = Sparse.RowUpper[i];
+		if (Row == -1 || Lower == Upper) {
+			continue;
+		}
+		int Slack = NextVariable++;
+		Element(Row, Slack) = std::isinf(Lower) ? 1.0 : -1.0;
+		if (!std::isinf(Lower) && !std::isinf(Upper)) {
+			Element(NextRow, Slack) = 1.0;
+			Element(NextRow, NextVariable++) = 1.0;
+			Element(NextRow, B) = Upper - Lower;
+			NextRow += 1;
+		}
+	}
+	C[Variables] += Sense * Sparse.ObjectiveConstant;
+
+	problem.IsFractionalCoefficients = IsFractionalCoefficients;
+	problem.Resize(Limitations, Variables);
+	problem.IsMaximization = Sparse.IsMaximization;
+	for (int i = 0; i < Limitations; i++) {
+		for (int j = 0; j <= Variables; j++) {
+			double Value = Element(i, j);
+			problem.RealMatrix[i][j] = (float)Value;
+			if (IsFractionalCoefficients && !ToFraction(Value, problem.FracMatrix[i][j])) {
+				return "Number can't be written as a fraction";
+			}
+		}
+	}
+	for (int j = 0; j <= Variables; j++) {
+		problem.RealTargetFunction[j] = (float)C[j];
+		if (IsFractionalCoefficients && !ToFraction(C[j], problem.FractionalTargetFunction[j])) {
+			return "Number can't be written as a fraction";
+		}
+	}
+	return NULL;
+}
+
+const char* LoadMpsProblem(const char* FileName, bool IsFractionalCoefficients, Problem& problem, ReadStatistics& Statistics) {
+	SparseProblem Sparse;
+	const char* Error = ReadMps(FileName, Sparse, Statistics);
+	if (Error) {
+		return Error;
+	}
+	return MakeStandardProblem(Sparse, IsFractionalCoefficients, problem);
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+// Numbers of problem files without strtod and fscanf, so reading doesn't depend on the locale
+// and doesn't need text terminated by zero.
+// Digits are gathered into a 64-bit mantissa, eight at a time when they go in a row. When both the mantissa
+// and the power of ten are exact, one multiplication or division gives the correctly rounded number
+// (fast path of Clinger). Numbers with more than 19 digits or a big exponent are left to strtod
+
+struct DecimalNumber {
+	uint64_t Mantissa = 0;
+	int Exponent = 0;
+	bool IsNegative = false;
+	// Every significant digit is in the mantissa
+	bool IsExact = true;
+	// Text of the number, for strtod
+	const char* Begin = NULL;
+	const char* End = NULL;
+};
+
+// Eight characters are checked and converted by arithmetic on one 64-bit word.
+// Bytes of the word are in little-endian order, as on x86 and ARM
+static inline uint64_t LoadEightBytes(const char* Text) {
+	uint64_t Chunk;
+	memcpy(&Chunk, Text, sizeof(Chunk));
+	return Chunk;
+}
+
+static inline bool IsEightDigits(uint64_t Chunk) {
+	return (((Chunk + 0x4646464646464646ULL) | (Chunk - 0x3030303030303030ULL)) & 0x8080808080808080ULL) == 0;
+}
+
+static inline uint32_t EightDigitsValue(uint64_t Chunk) {
+	const uint64_t Mask = 0x000000FF000000FFULL;
+	const uint64_t HighMultiplier = 100 + (1000000ULL << 32);
+	const uint64_t LowMultiplier = 1 + (10000ULL << 32);
+	Chunk -= 0x3030303030303030ULL;
+	// Pairs of digits, then both halves of the word at once
+	Chunk = Chunk * 10 + (Chunk >> 8);
+	return (uint32_t)(((Chunk & Mask) * HighMultiplier + ((Chunk >> 16) & Mask) * LowMultiplier) >> 32);
+}
+
+static inline bool IsDigit(char Character) {
+	return (unsigned char)(Character - '0') < 10;
+}
+
+// Adds digits to the mantissa while it has room for them, the rest are counted in Dropped.
+// Digits counts significant digits in the mantissa
+static inline const char* ScanDigits(const char* Position, const char* End, DecimalNumber& Number, int& Digits, int& Dropped) {
+	while (End - Position >= 8 && Digits <= 11) {
+		uint64_t Chunk = LoadEightBytes(Position);
+		if (!IsEightDigits(Chunk)) {
+			break;
+		}
+		Number.Mantissa = Number.Mantissa * 100000000 + EightDigitsValue(Chunk);
+		Digits += 8;
+		Position += 8;
+	}
+	while (Position < End && IsDigit(*Position)) {
+		if (Digits < 19) {
+			Number.Mantissa = Number.Mantissa * 10 + (*Position - '0');
+			// Leading zeros aren't significant
+			Digits += Number.Mantissa != 0;
+		} else {
+			Dropped += 1;
+		}
+		Position++;
+	}
+	return Position;
+}
+
+// Reads "-12.5e3" and alike. Returns position after the number or NULL if there's no number
+static const char* ScanDecimal(const char* Position, const char* End, DecimalNumber& Number) {
+	Number = DecimalNumber();
+	Number.Begin = Position;
+	if (Position < End && (*Position == '-' || *Position == '+')) {
+		Number.IsNegative = *Position == '-';
+		Position++;
+	}
+
+	int Digits = 0;
+	int Dropped = 0;
+	const char* IntegerBegin = Position;
+	Position = ScanDigits(Position, End, Number, Digits, Dropped);
+	bool HasDigits = Position != IntegerBegin;
+	Number.Exponent = Dropped;
+	Number.IsExact = Dropped == 0;
+
+	if (Position < End && *Position == '.') {
+		Position++;
+		const char* FractionBegin = Position;
+		Dropped = 0;
+		Position = ScanDigits(Position, End, Number, Digits, Dropped);
+		Number.Exponent -= (int)(Position - FractionBegin) - Dropped;
+		Number.IsExact = Number.IsExact && Dropped == 0;
+		HasDigits = HasDigits || Position != FractionBegin;
+	}
+	if (!HasDigits) {
+		return NULL;
+	}
+
+	// Exponent without digits isn't a part of the number, as in strtod
+	if (Position < End && (*Position == 'e' || *Position == 'E')) {
+		const char* ExponentPosition = Position + 1;
+		bool IsNegativeExponent = false;
+		if (ExponentPosition < End && (*ExponentPosition == '-' || *ExponentPosition == '+')) {
+			IsNegativeExponent = *ExponentPosition == '-';
+			ExponentPosition++;
+		}
+		if (ExponentPosition < End && IsDigit(*ExponentPosition)) {
+			int Value = 0;
+			while (ExponentPosition < End && IsDigit(*ExponentPosition)) {
+				if (Value < 100000) {
+					Value = Value * 10 + (*ExponentPosition - '0');
+				}
+				ExponentPosition++;
+			}
+			Number.Exponent += IsNegativeExponent ? -Value : Value;
+			Position = ExponentPosition;
+		}
+	}
+	Number.End = Position;
+	return Position;
+}
+
+static double SlowDecimalToDouble(const DecimalNumber& Number) {
+	std::string Text(Number.Begin, Number.End);
+	return strtod(Text.c_str(), NULL);
+}
+
+static double DecimalToDouble(const DecimalNumber& Number) {
+	static const double Powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+	double Value;
+	if (Number.Mantissa == 0) {
+		Value = 0.0;
+	} else if (Number.IsExact && Number.Mantissa <= (1ULL << 53) && Number.Exponent >= -22 && Number.Exponent <= 22) {
+		Value = (double)Number.Mantissa;
+		Value = Number.Exponent < 0 ? Value / Powers[-Number.Exponent] : Value * Powers[Number.Exponent];
+	} else {
+		return SlowDecimalToDouble(Number);
+	}
+	return Number.IsNegative ? -Value : Value;
+}
+
+static float DecimalToFloat(const DecimalNumber& Number) {
+	static const float Powers[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+	if (Number.IsExact && Number.Mantissa <= (1ULL << 24) && Number.Exponent >= -10 && Number.Exponent <= 10) {
+		float Value = (float)Number.Mantissa;
+		Value = Number.Exponent < 0 ? Value / Powers[-Number.Exponent] : Value * Powers[Number.Exponent];
+		return Number.IsNegative ? -Value : Value;
+	}
+
+	// Correctly rounded double is rounded once more. Halfway points between floats are exact in double,
+	// so the second rounding is wrong only when the double is exactly such a point
+	if (Number.IsExact && Number.Mantissa <= (1ULL << 53) && Number.Exponent >= -22 && Number.Exponent <= 22) {
+		double Value = DecimalToDouble(Number);
+		uint64_t Bits;
+		memcpy(&Bits, &Value, sizeof(Bits));
+		if ((Bits & 0x1FFFFFFF) != 0x10000000) {
+			return (float)Value;
+		}
+	}
+	std::string Text(Number.Begin, Number.End);
+	return strtof(Text.c_str(), NULL);
+}
+
+// Reads an integer that fits into int. Returns error message or NULL
+static const char* ScanInteger(const char*& Position, const char* End, int& Value) {
+	bool IsNegative = false;
+	if (Position < End && (*Position == '-' || *Position == '+')) {
+		IsNegative = *Position == '-';
+		Position++;
+	}
+	const char* DigitsBegin = Position;
+	long long Result = 0;
+	while (Position < End && IsDigit(*Position)) {
+		Result = Result * 10 + (*Position - '0');
+		if (Result > (long long)INT32_MAX + IsNegative) {
+			return "Number is too big";
+		}
+		Position++;
+	}
+	if (Position == DigitsBegin) {
+		return "Wrong number";
+	}
+	Value = (int)(IsNegative ? -Result : Result);
+	return NULL;
+}
@@ -0,0 +1,417 @@
+#pragma once
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// File mapped into memory, pages are read by the system when the parser gets to them
+struct MappedFile {
+	const char* Data = NULL;
+	size_t Size = 0;
+#ifdef _WIN32
+	HANDLE File = INVALID_HANDLE_VALUE;
+	HANDLE Mapping = NULL;
+#else
+	int Descriptor = -1;
+#endif
+
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	~MappedFile() {
+		Close();
+	}
+
+	// Returns NULL on success and error message otherwise
+	const char* Open(const char* FileName) {
+		Close();
+#ifdef _WIN32
+		File = CreateFileA(FileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		LARGE_INTEGER FileSize;
+		if (File == INVALID_HANDLE_VALUE || !GetFileSizeEx(File, &FileSize)) {
+			return "Can't open file";
+		}
+		Size = (size_t)FileSize.QuadPart;
+		if (Size == 0) {
+			return NULL;
+		}
+		Mapping = CreateFileMappingA(File, NULL, PAGE_READONLY, 0, 0, NULL);
+		Data = Mapping ? (const char*)MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+#else
+		Descriptor = open(FileName, O_RDONLY);
+		struct stat FileStatus;
+		if (Descriptor == -1 || fstat(Descriptor, &FileStatus) != 0) {
+			return "Can't open file";
+		}
+		Size = FileStatus.st_size;
+		if (Size == 0) {
+			return NULL;
+		}
+		void* Memory = mmap(NULL, Size, PROT_READ, MAP_PRIVATE, Descriptor, 0);
+		if (Memory != MAP_FAILED) {
+			madvise(Memory, Size, MADV_SEQUENTIAL);
+			Data = (const char*)Memory;
+		}
+#endif
+		return Data ? NULL : "Can't map file into memory";
+	}
+
+	void Close() {
+#ifdef _WIN32
+		if (Data) { UnmapViewOfFile(Data); }
+		if (Mapping) { CloseHandle(Mapping); }
+		if (File != INVALID_HANDLE_VALUE) { CloseHandle(File); }
+		Mapping = NULL;
+		File = INVALID_HANDLE_VALUE;
+#else
+		if (Data) { munmap((void*)Data, Size); }
+		if (Descriptor != -1) { close(Descriptor); }
+		Descriptor = -1;
+#endif
+		Data = NULL;
+		Size = 0;
+	}
+};
+
+// Text format of problem files: number of limitations, number of columns (variables and vector B) and the matrix itself.
+// Text format may be continued with one more row of the same length that contains
+// target function coefficients with constant C as the last element.
+// If there's no such row target function is zero and only admissibility of the problem is checked.
+// Numbers are read where they lie, real numbers may be written as a/b too, fractions may be integers
+struct ProblemText {
+	const char* Begin;
+	const char* Position;
+	const char* End;
+	// Beginning of the number that is read, error is reported at it
+	const char* Token;
+
+	ProblemText(const char* Text, size_t Size) : Begin(Text), Position(Text), End(Text + Size), Token(Text) {}
+
+	void SkipSpaces() {
+		while (Position < End && (*Position == ' ' || *Position == '\n' || *Position == '\r' || *Position == '\t')) {
+			Position++;
+		}
+		Token = Position;
+	}
+
+	bool IsAtEnd() {
+		SkipSpaces();
+		return Position == End;
+	}
+
+	// Number has to be followed by a space or the end of the text
+	const char* CheckSeparator() const {
+		bool IsSeparated = Position == End || *Position == ' ' || *Position == '\n' || *Position == '\r' || *Position == '\t';
+		return IsSeparated ? NULL : "Wrong number";
+	}
+
+	// Missing is the error when the text has ended
+	const char* ReadInteger(int& Value, const char* Missing) {
+		if (IsAtEnd()) {
+			return Missing;
+		}
+		if (const char* Error = ScanInteger(Position, End, Value)) {
+			return Error;
+		}
+		return CheckSeparator();
+	}
+
+	const char* ReadReal(float& Value, const char* Missing) {
+		if (IsAtEnd()) {
+			return Missing;
+		}
+		DecimalNumber Number;
+		const char* NumberEnd = ScanDecimal(Position, End, Number);
+		if (!NumberEnd) {
+			return "Wrong number";
+		}
+		Position = NumberEnd;
+		Value = DecimalToFloat(Number);
+
+		if (Position < End && *Position == '/') {
+			NumberEnd = ScanDecimal(Position + 1, End, Number);
+			if (!NumberEnd) {
+				return "Wrong number";
+			}
+			Position = NumberEnd;
+			if (Number.Mantissa == 0) {
+				return "Denominator is zero";
+			}
+			Value = (float)(Value / DecimalToDouble(Number));
+		}
+		return CheckSeparator();
+	}
+
+	const char* ReadFraction(Fraction& Value, const char* Missing) {
+		if (IsAtEnd()) {
+			return Missing;
+		}
+		Value.denominator = 1;
+		if (const char* Error = ScanInteger(Position, End, Value.numerator)) {
+			return Error;
+		}
+		if (Position < End && *Position == '/') {
+			Position++;
+			if (const char* Error = ScanInteger(Position, End, Value.denominator)) {
+				return Error;
+			}
+			if (Value.denominator == 0) {
+				return "Denominator is zero";
+			}
+			// Fractions are kept as they are written, only the sign goes to the numerator
+			if (Value.denominator < 0) {
+				Value.numerator = -Value.numerator;
+				Value.denominator = -Value.denominator;
+			}
+		}
+		return CheckSeparator();
+	}
+
+	const char* ReadElement(Problem& problem, Fraction& FracElement, float& RealElement, const char* Missing) {
+		if (!problem.IsFractionalCoefficients) {
+			return ReadReal(RealElement, Missing);
+		}
+		const char* Error = ReadFraction(FracElement, Missing);
+		RealElement = (float)ToDouble(FracElement);
+		return Error;
+	}
+
+	const char* Read(bool IsFractionalCoefficients, Problem& problem) {
+		int NumberOfLimitations = -1;
+		int NumberOfColumns = -1;
+		const char* DimensionsError = "Can't read dimensions of the problem";
+		if (ReadInteger(NumberOfLimitations, DimensionsError) || ReadInteger(NumberOfColumns, DimensionsError)) {
+			return DimensionsError;
+		}
+
+		if (NumberOfColumns < 2 || NumberOfLimitations < 1 || NumberOfLimitations >= NumberOfColumns) {
+			return "Wrong dimensions of the problem";
+		}
+		// Every number takes at least two characters with its separator
+		if ((long long)NumberOfLimitations * NumberOfColumns > (long long)(End - Begin) / 2 + 1) {
+			return "Can't read matrix of limitations";
+		}
+
+		problem.IsFractionalCoefficients = IsFractionalCoefficients;
+		problem.Resize(NumberOfLimitations, NumberOfColumns - 1);
+
+		// Elements go straight into rows of the matrices
+		for (int i = 0; i < NumberOfLimitations; i++) {
+			float* RealRow = problem.RealMatrix[i];
+			Fraction* FracRow = problem.FracMatrix[i];
+			for (int j = 0; j < NumberOfColumns; j++) {
+				if (const char* Error = ReadElement(problem, FracRow[j], RealRow[j], "Can't read matrix of limitations")) {
+					return Error;
+				}
+			}
+		}
+
+		// Optional target function
+		if (IsAtEnd()) {
+			return NULL;
+		}
+		for (int j = 0; j < NumberOfColumns; j++) {
+			if (const char* Error = ReadElement(problem, problem.FractionalTargetFunction[j], problem.RealTargetFunction[j], "Can't read target function")) {
+				return Error;
+			}
+		}
+		return NULL;
+	}
+
+	// Keyed format of configuration files, as src/ProblemConfiguration.txt:
+	//   NV: 2   number of variables
+	//   NL: 2   number of limitations
+	//   R       automatic solution, without it the solution is step by step
+	//   F       fractions, without it real numbers
+	//   A       artificial basis, without it explicit basis
+	//   ML:     matrix of limitations, a row on every line, vector B at the end of a row may be omitted
+	//   TF:     optional target function on one line, constant C at the end may be omitted
+	// Flags go before the matrix, because it's read in the type they give
+	static bool IsKeyCharacter(char Character) {
+		return (unsigned char)((Character | 0x20) - 'a') < 26;
+	}
+
+	bool IsKeyed() {
+		return !IsAtEnd() && IsKeyCharacter(*Position);
+	}
+
+	// Skips spaces only up to the end of the line
+	bool IsLineEnd() {
+		while (Position < End && (*Position == ' ' || *Position == '\r' || *Position == '\t')) {
+			Position++;
+		}
+		Token = Position;
+		return Position == End || *Position == '\n';
+	}
+
+	// Reads one row of the matrix or the target function, the last element may be omitted and stays zero
+	const char* ReadKeyedRow(Problem& problem, float* RealRow, Fraction* FracRow, const char* Missing) {
+		if (IsAtEnd() || IsKeyCharacter(*Position)) {
+			return Missing;
+		}
+		int NumberOfColumns = problem.NumberOfVariables + 1;
+		int j = 0;
+		while (!IsLineEnd()) {
+			if (j == NumberOfColumns) {
+				return "Too many numbers in the row";
+			}
+			if (const char* Error = ReadElement(problem, FracRow[j], RealRow[j], Missing)) {
+				return Error;
+			}
+			j++;
+		}
+		return j < NumberOfColumns - 1 ? "Not enough numbers in the row" : NULL;
+	}
+
+	const char* ReadConfiguration(Problem& problem) {
+		int NumberOfVariables = -1;
+		int NumberOfLimitations = -1;
+		bool HasMatrix = false;
+		problem.HasSolveModes = true;
+		problem.IsFractionalCoefficients = false;
+		problem.IsArtificialBasis = false;
+		problem.IsAutomatic = false;
+
+		while (!IsAtEnd()) {
+			const char* Key = Position;
+			while (Position < End && IsKeyCharacter(*Position)) {
+				Position++;
+			}
+			size_t KeyLength = Position - Key;
+			if (KeyLength == 0) {
+				return "Key is expected";
+			}
+			bool HasColon = Position < End && *Position == ':';
+			Position += HasColon;
+			if (!IsLineEnd() && !HasColon) {
+				return "Wrong key";
+			}
+			Token = Key;
+
+			if (KeyLength == 1 && !HasColon) {
+				if (HasMatrix) {
+					return "Flags have to go before the matrix";
+				}
+				if (*Key == 'R') {
+					problem.IsAutomatic = true;
+				} else if (*Key == 'F') {
+					problem.IsFractionalCoefficients = true;
+				} else if (*Key == 'A') {
+					problem.IsArtificialBasis = true;
+				} else {
+					return "Unknown flag";
+				}
+			} else if (KeyLength == 2 && HasColon && (memcmp(Key, "NV", 2) == 0 || memcmp(Key, "NL", 2) == 0)) {
+				if (HasMatrix) {
+					return "Dimensions have to go before the matrix";
+				}
+				int& Value = Key[1] == 'V' ? NumberOfVariables : NumberOfLimitations;
+				if (const char* Error = ReadInteger(Value, "Can't read dimensions of the problem")) {
+					return Error;
+				}
+			} else if (KeyLength == 2 && HasColon && memcmp(Key, "ML", 2) == 0) {
+				if (HasMatrix) {
+					return "Matrix is given twice";
+				}
+				if (NumberOfVariables < 1 || NumberOfLimitations < 1 || NumberOfLimitations > NumberOfVariables) {
+					return "Wrong dimensions of the problem";
+				}
+				// Every number takes at least two characters with its separator
+				if ((long long)NumberOfLimitations * NumberOfVariables > (long long)(End - Begin) / 2 + 1) {
+					return "Can't read matrix of limitations";
+				}
+				problem.Resize(NumberOfLimitations, NumberOfVariables);
+				for (int i = 0; i < NumberOfLimitations; i++) {
+					if (const char* Error = ReadKeyedRow(problem, problem.RealMatrix[i], problem.FracMatrix[i], "Can't read matrix of limitations")) {
+						return Error;
+					}
+				}
+				HasMatrix = true;
+			} else if (KeyLength == 2 && HasColon && memcmp(Key, "TF", 2) == 0) {
+				if (!HasMatrix) {
+					return "Target function has to go after the matrix";
+				}
+				if (const char* Error = ReadKeyedRow(problem, problem.RealTargetFunction.data(), problem.FractionalTargetFunction.data(), "Can't read target function")) {
+					return Error;
+				}
+			} else {
+				return "Unknown key";
+			}
+		}
+		return HasMatrix ? NULL : "Can't read matrix of limitations";
+	}
+
+	// Line and column of the number where reading has stopped, both start from 1
+	void FindErrorPosition(ReadStatistics& Statistics) const {
+		int Line = 1;
+		const char* LineStart = Begin;
+		while (const char* LineEnd = (const char*)memchr(LineStart, '\n', Token - LineStart)) {
+			Line += 1;
+			LineStart = LineEnd + 1;
+		}
+		Statistics.ErrorLine = Line;
+		Statistics.ErrorColumn = Token - LineStart + 1;
+	}
+};
+
+// Reads problem from text in memory. Returns NULL on success and error message otherwise.
+// Text that starts with a letter is a configuration file, its type of elements is taken from the file
+const char* ParseProblem(const char* Text, size_t Size, bool IsFractionalCoefficients, Problem& problem, ReadStatistics& Statistics) {
+	ProblemText Reader(Text, Size);
+	const char* Error = Reader.IsKeyed() ? Reader.ReadConfiguration(problem) : Reader.Read(IsFractionalCoefficients, problem);
+	if (Error) {
+		Reader.FindErrorPosition(Statistics);
+	} else {
+		Statistics.Elements = (long long)problem.NumberOfLimitations * (problem.NumberOfVariables + 1);
+	}
+	Statistics.Bytes = Size;
+	return Error;
+}
+
+static bool HasExtension(const char* FileName, const char* Extension) {
+	size_t NameLength = strlen(FileName);
+	size_t ExtensionLength = strlen(Extension);
+	if (NameLength < ExtensionLength) {
+		return false;
+	}
+	for (size_t i = 0; i < ExtensionLength; i++) {
+		if (tolower((unsigned char)FileName[NameLength - ExtensionLength + i]) != Extension[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Tables of numbers are read by CsvFile.h
+const char* LoadCsvProblem(const char* FileName, bool IsFractionalCoefficients, Problem& problem, ReadStatistics& Statistics);
+
+// Reads a problem in the format given by the extension of the file: ".mps", ".lp", ".csv" and ".tsv" or the text format
+const char* LoadProblem(const char* FileName, bool IsFractionalCoefficients, Problem& problem, ReadStatistics& Statistics) {
+	if (HasExtension(FileName, ".csv") || HasExtension(FileName, ".tsv")) {
+		return LoadCsvProblem(FileName, IsFractionalCoefficients, problem, Statistics);
+	}
+	if (HasExtension(FileName, ".mps")) {
+		return LoadMpsProblem(FileName, IsFractionalCoefficients, problem, Statistics);
+	}
+	if (HasExtension(FileName, ".lp")) {
+		return LoadLpProblem(FileName, IsFractionalCoefficients, problem, Statistics);
+	}
+
+	auto Start = std::chrono::steady_clock::now();
+	MappedFile File;
+	const char* Error = File.Open(FileName);
+	if (!Error) {
+		Error = ParseProblem(File.Data, File.Size, IsFractionalCoefficients, problem, Statistics);
+	}
+	Statistics.Milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+	return Error;
+}
+
+const char* LoadProblem(const char* FileName, bool IsFractionalCoefficients, Problem& problem) {
+	ReadStatistics Statistics;
+	return LoadProblem(FileName, IsFractionalCoefficients, problem, Statistics);
+}
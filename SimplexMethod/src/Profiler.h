@@ -0,0 +1,52 @@
+#pragma once
+
+// Time spent by the solver.
+// Every pivot adds time of its parts to global counters, the performance panel takes
+// differences of the counters between its samples. Counters are shared by all threads that solve,
+// except threads that set IsSkipped (speculative steps are not the solution the user sees)
+
+typedef std::chrono::steady_clock ProfileClock;
+
+enum ProfileSection {
+	// Check of the table and choice of the entering column
+	PROFILE_PRICING,
+	// Choice of the leaving row
+	PROFILE_RATIO_TEST,
+	// Recalculation of the table
+	PROFILE_UPDATE,
+	// Gauss elimination of the explicit basis
+	PROFILE_GAUSS_ELIMINATION,
+	PROFILE_SECTION_COUNT,
+};
+
+struct SolverProfile {
+	std::atomic<long long> Nanoseconds[PROFILE_SECTION_COUNT] = {};
+	// Number and whole time of pivots, index 0 is the simplex algorithm and 1 is the artificial basis method
+	std::atomic<long long> Pivots[2] = {};
+	std::atomic<long long> PivotNanoseconds[2] = {};
+	static inline thread_local bool IsSkipped = false;
+
+	static long long Elapsed(ProfileClock::time_point Start, ProfileClock::time_point End) {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(End - Start).count();
+	}
+
+	// Adds time since Start to a section. Returns current time, so the next section starts from it
+	ProfileClock::time_point Add(ProfileSection Section, ProfileClock::time_point Start) {
+		ProfileClock::time_point Now = ProfileClock::now();
+		if (IsSkipped) {
+			return Now;
+		}
+		Nanoseconds[Section].fetch_add(Elapsed(Start, Now), std::memory_order_relaxed);
+		return Now;
+	}
+
+	void AddPivot(bool IsArtificialStep, ProfileClock::time_point Start) {
+		if (IsSkipped) {
+			return;
+		}
+		Pivots[IsArtificialStep].fetch_add(1, std::memory_order_relaxed);
+		PivotNanoseconds[IsArtificialStep].fetch_add(Elapsed(Start, ProfileClock::now()), std::memory_order_relaxed);
+	}
+};
+
+SolverProfile Profiler;
@@ -0,0 +1,947 @@
+#pragma once
+
+AlgorithmState CheckAlgorithmState(Matrix& matrix, bool IsAutomatic, bool IsArtificialStep) {
+	AlgorithmState state = UNDEFINED;
+
+	for (int i = 0; i < matrix.ColNumber - 1; i++) {
+		if (matrix[matrix.RowNumber - 1][i] < -EPSILON) {
+			state = UNDEFINED;
+			// Check if there is at least one positive element in a column
+			for (int j = 0; j < matrix.RowNumber - 1; j++) {
+				if (matrix[j][i] > EPSILON) {
+					state = CONTINUE;
+					break;
+				}
+			}
+			if (state == UNDEFINED) {
+				state = UNLIMITED_SOLUTION;
+				break;
+			}
+		}
+	}
+
+	if (state == UNDEFINED) {
+		state = COMPLETED;
+
+		// Check if system of equalities have solutions
+		if (IsArtificialStep) {
+			if (matrix[matrix.RowNumber - 1][matrix.ColNumber - 1] < -EPSILON) {
+				state = SOLUTION_DOESNT_EXIST;
+			}
+		}
+	}
+
+	// Check if rows are indepenedent
+	for (int i = 0; i < matrix.RowNumber - 1; i++) {
+		int ZeroElementsCount = 0;
+		for (int j = 0; j < matrix.ColNumber - 1; j++) {
+			// if element is zero
+			if (fabs(matrix[i][j]) < EPSILON) {
+				ZeroElementsCount++;
+			}
+		}
+		if (ZeroElementsCount == matrix.ColNumber - 1) {
+			state = SOLUTION_DOESNT_EXIST;
+			break;
+		}
+	}
+
+	assert(state != UNDEFINED);
+	return state;
+}
+
+AlgorithmState CheckAlgorithmState(FractionalMatrix& matrix, bool IsAutomatic, bool IsArtificialStep) {
+	AlgorithmState state = UNDEFINED;
+
+	for (int i = 0; i < matrix.ColNumber - 1; i++) {
+		// Last row contains negative numbers
+		if (matrix[matrix.RowNumber - 1][i] < 0) {
+			state = UNDEFINED;
+			// Check if there is at least one positive element in a column
+			for (int j = 0; j < matrix.RowNumber - 1; j++) {
+				if (matrix[j][i] > 0) {
+					state = CONTINUE;
+					break;
+				}
+			}
+			if (state == UNDEFINED) {
+				state = UNLIMITED_SOLUTION;
+				break;
+			}
+		}
+	}
+
+	if (state == UNDEFINED) {
+		state = COMPLETED;
+
+		// Check if system of equalities have solutions
+		if (IsArtificialStep) {
+			if (matrix[matrix.RowNumber - 1][matrix.ColNumber - 1] < -EPSILON) {
+				state = SOLUTION_DOESNT_EXIST;
+			}
+		}
+	}
+
+	// Check if rows are indepenedent
+	for (int i = 0; i < matrix.RowNumber - 1; i++) {
+		int ZeroElementsCount = 0;
+		for (int j = 0; j < matrix.ColNumber - 1; j++) {
+			// if element is zero
+			if (matrix[i][j] == Fraction(0, 1)) {
+				ZeroElementsCount++;
+			}
+		}
+		if (ZeroElementsCount == matrix.ColNumber - 1) {
+			state = SOLUTION_DOESNT_EXIST;
+			break;
+		}
+	}
+
+	assert(state != UNDEFINED);
+	return state;
+}
+
+template<typename MatrixType, typename ElementType> Step SimplexStep(Step step) {
+	int CurrentColumnIndex = -1;
+	int CurrentRowIndex = -1;
+	ElementType CurrentLead;
+
+	if (step.IsCompleted) {
+		return step;
+	}
+	ProfileClock::time_point PivotStart = ProfileClock::now();
+
+	// Choose matrix based on input
+	MatrixType matrix;
+	if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
+		// Real case
+		matrix = step.RealMatrix;
+	} else {
+		// Fractional case
+		matrix = step.FracMatrix;
+	}
+
+	// Define generic zero for both real and fractional cases
+	ElementType ZeroElement;
+	if constexpr (IS_SAME_TYPE(ElementType, float)) {
+		// Real case
+		ZeroElement = EPSILON;
+	} else {
+		// Fractional case
+		ZeroElement = Fraction(0, 1);
+	}
+
+	// Check what algorithm state is
+	ProfileClock::time_point SectionStart = ProfileClock::now();
+	AlgorithmState state = UNDEFINED;
+	state = CheckAlgorithmState(matrix, step.IsAutomatic, step.IsArtificialStep);
+	assert(state != UNDEFINED);
+
+	if (state != CONTINUE) {
+		Profiler.Add(PROFILE_PRICING, SectionStart);
+	}
+	if (state == UNLIMITED_SOLUTION) {
+		step.IsCompleted = true;
+		return step;
+	} else if (state == COMPLETED) {
+		step.IsCompleted = true;
+		return step;
+	} else if (state == SOLUTION_DOESNT_EXIST) {
+		step.IsCompleted = true;
+		return step;
+	}
+
+	// Choose lead element
+	if (step.IsAutomatic) {
+		CurrentRowIndex = -1;
+		// Assigning appropriate values to these variables
+		ElementType ColumnMinimum;
+		if constexpr (IS_SAME_TYPE(ElementType, float)) {
+			// Real case
+			CurrentLead = FLT_MAX;
+			ColumnMinimum = FLT_MAX;
+		} else {
+			// Fractional case
+			CurrentLead = Fraction(INT32_MAX, 1);
+			ColumnMinimum = Fraction(INT32_MAX, 1);
+		}
+
+		// Find number of column of an available element
+		for (int i = 0; i < matrix.RowNumber - 1; i++) {
+			for (int j = 0; j < matrix.ColNumber - 1; j++) {
+				if (matrix[matrix.RowNumber - 1][j] < -ZeroElement) {
+					if (matrix[i][j] > ZeroElement) {
+						CurrentColumnIndex = j;
+						break;
+					}
+				}
+			}
+		}
+		SectionStart = Profiler.Add(PROFILE_PRICING, SectionStart);
+
+		// Choose any available lead element
+		for (int i = 0; i < matrix.RowNumber - 1; i++) {
+			if (matrix[i][CurrentColumnIndex] > ZeroElement) {
+				if (matrix[i][matrix.ColNumber - 1] / matrix[i][CurrentColumnIndex] < ColumnMinimum) {
+					CurrentLead = matrix[i][CurrentColumnIndex];
+					ColumnMinimum = matrix[i][matrix.ColNumber - 1] / matrix[i][CurrentColumnIndex];
+					CurrentRowIndex = i;
+				}
+			}
+		}
+		SectionStart = Profiler.Add(PROFILE_RATIO_TEST, SectionStart);
+	} else {
+		CurrentColumnIndex = step.LeadElementRC.Column;
+		CurrentRowIndex = step.LeadElementRC.Row;
+
+		// Assignment of lead element
+		CurrentLead = matrix[step.LeadElementRC.Row][step.LeadElementRC.Column];
+		// Lead is chosen by user, only the check of the table is pricing
+		SectionStart = Profiler.Add(PROFILE_PRICING, SectionStart);
+	}
+
+	assert(CurrentRowIndex != -1);
+	assert(CurrentColumnIndex != -1);
+	if constexpr (IS_SAME_TYPE(MatrixType, FractionalMatrix)) {
+		assert(CurrentLead.numerator != -1);
+	} else {
+		assert(CurrentLead != -1);
+	}
+
+	// Lead element is equal to 1 / Lead
+	if constexpr (IS_SAME_TYPE(ElementType, float)) {
+		// Real case
+		matrix[CurrentRowIndex][CurrentColumnIndex] = 1 / CurrentLead;
+	} else {
+		// Fractional case
+		matrix[CurrentRowIndex][CurrentColumnIndex] = Fraction(1, 1) / CurrentLead;
+	}
+
+	// Divide Row by lead
+	for (int i = 0; i < matrix.ColNumber; i++) {
+		if (i == CurrentColumnIndex) { continue; }
+		matrix[CurrentRowIndex][i] = matrix[CurrentRowIndex][i] / CurrentLead;
+	}
+
+	// Divide Column by negative lead
+	for (int i = 0; i < matrix.RowNumber; i++) {
+		if (i == CurrentRowIndex) { continue; }
+		matrix[i][CurrentColumnIndex] = (matrix[i][CurrentColumnIndex] / (-CurrentLead));
+	}
+
+	// Subtract all other rows by lead row
+	for (int i = 0; i < matrix.RowNumber; i++) {
+		if (i == CurrentRowIndex) { continue; }
+		for (int j = 0; j < matrix.ColNumber; j++) {
+			if (j == CurrentColumnIndex) { continue; }
+			matrix[i][j] = matrix[i][j] - CurrentLead * matrix[i][CurrentColumnIndex] * matrix[CurrentRowIndex][j] * (-1);
+		}
+	}
+
+	// Assign new step matricies
+	Step NewStep = step;
+	if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
+		// Real case
+		NewStep.RealMatrix = matrix;
+		NewStep.FracMatrix = step.FracMatrix;
+	} else {
+		// Fractional case
+		NewStep.RealMatrix = step.RealMatrix;
+		NewStep.FracMatrix = matrix;
+	}
+	NewStep.StepID += 1;
+	NewStep.StepChosenRC.Row = CurrentRowIndex;
+	NewStep.StepChosenRC.Column = CurrentColumnIndex;
+	Profiler.Add(PROFILE_UPDATE, SectionStart);
+	Profiler.AddPivot(step.IsArtificialStep, PivotStart);
+	return NewStep;
+}
+
+void MakeArtificialFunctionCoefficients(Matrix& matrix) {
+	for (int i = 0; i < matrix.ColNumber; i++) {
+		float ColumnSum = 0.0f;
+		for (int j = 0; j < matrix.RowNumber - 1; j++) {
+			ColumnSum += matrix[j][i];
+		}
+		matrix[matrix.RowNumber - 1][i] = -ColumnSum;
+	}
+
+	// If last element in a row is less than zero multiply row by (-1)
+	int LastElementInARow = matrix.ColNumber - 1;
+	for (int i = 0; i < matrix.RowNumber - 1; i++) {
+		if (matrix[i][LastElementInARow] < -EPSILON) {
+			for (int j = 0; j < matrix.ColNumber; j++) {
+				matrix[i][j] = matrix[i][j] * (-1);
+			}
+		}
+	}
+}
+
+void MakeArtificialFunctionCeofficients(FractionalMatrix& matrix) {
+	for (int i = 0; i < matrix.ColNumber; i++) {
+		Fraction ColumnSum = Fraction(0, 1);
+		for (int j = 0; j < matrix.RowNumber - 1; j++) {
+			ColumnSum = ColumnSum + matrix[j][i];
+		}
+		matrix[matrix.RowNumber - 1][i] = -ColumnSum;
+	}
+
+	// If last element in a row is less than zero multiply row by (-1)
+	int LastElementInARow = matrix.ColNumber - 1;
+	for (int i = 0; i < matrix.RowNumber - 1; i++) {
+		if (matrix[i][LastElementInARow] < 0) {
+			for (int j = 0; j < matrix.ColNumber; j++) {
+				matrix[i][j] = matrix[i][j] * (-1);
+			}
+		}
+	}
+}
+
+void MakeSimplexAlgorithmFunctionCoefficients(Step& step, std::vector<float>& RealTargetFunction) {
+	Matrix TargetFunctionCoefficientsMatrix(step.RealMatrix);
+
+	// Copy table one to one multiplying basis rows on coefficients of target function
+	for (int i = 0; i < step.RealMatrix.RowNumber - 1; i++) {
+		for (int j = 0; j < step.RealMatrix.ColNumber; j++) {
+			if (j < step.RealMatrix.ColNumber - 1) {
+				TargetFunctionCoefficientsMatrix[i][j] = (-1) * RealTargetFunction[step.NumbersOfVariables[i] - 1] * step.RealMatrix[i][j];
+			} else {
+				TargetFunctionCoefficientsMatrix[i][j] = RealTargetFunction[step.NumbersOfVariables[i] - 1] * step.RealMatrix[i][j];
+			}
+		}
+	}
+
+	// Fill new target function coefficients
+	for (int i = 0; i < TargetFunctionCoefficientsMatrix.ColNumber - 1; i++) {
+		float ColumnSum = 0.0f;
+		for (int j = 0; j < TargetFunctionCoefficientsMatrix.RowNumber - 1; j++) {
+			ColumnSum += TargetFunctionCoefficientsMatrix[j][i];
+		}
+		ColumnSum += RealTargetFunction[step.NumbersOfVariables[i + step.RealMatrix.RowNumber - 1] - 1];
+		step.RealMatrix[step.RealMatrix.RowNumber - 1][i] = ColumnSum;
+	}
+
+	// Free coefficient
+	float ColumnSum = 0.0f;
+	for (int i = 0; i < TargetFunctionCoefficientsMatrix.RowNumber - 1; i++) {
+		ColumnSum += TargetFunctionCoefficientsMatrix[i][TargetFunctionCoefficientsMatrix.ColNumber - 1];
+	}
+	ColumnSum += RealTargetFunction[RealTargetFunction.size() - 1];
+	step.RealMatrix[step.RealMatrix.RowNumber - 1][step.RealMatrix.ColNumber - 1] = -ColumnSum;
+}
+
+template<typename MatrixType, typename ElementType> void MakeSimplexAlgorithmFunctionCoefficients(MatrixType& matrix, std::vector<int> NumbersOfVariables, std::vector<ElementType>& TargetFunction) {
+	MatrixType TargetFunctionCoefficientsMatrix(matrix);
+
+	// Type-independent zero element
+	// Float is [-EPSILON, +EPSILON], Fraction is 0/1
+	ElementType ZeroElement;
+	if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
+		ZeroElement = EPSILON;
+	} else {
+		ZeroElement = Fraction(0, 1);
+	}
+
+	// Copy table one to one multiplying basis rows on coefficients of target function
+	for (int i = 0; i < matrix.RowNumber - 1; i++) {
+		for (int j = 0; j < matrix.ColNumber; j++) {
+			if (j < matrix.ColNumber - 1) {
+				TargetFunctionCoefficientsMatrix[i][j] = TargetFunction[NumbersOfVariables[i] - 1] * matrix[i][j] * (-1);
+			} else {
+				TargetFunctionCoefficientsMatrix[i][j] = TargetFunction[NumbersOfVariables[i] - 1] * matrix[i][j];
+			}
+		}
+	}
+
+	// Fill new target function coefficients
+	for (int i = 0; i < TargetFunctionCoefficientsMatrix.ColNumber - 1; i++) {
+		ElementType ColumnSum;
+		if constexpr (IS_SAME_TYPE(ElementType, float)) {
+			ColumnSum = 0.0f;
+		} else {
+			ColumnSum = Fraction(0, 1);
+		}
+		for (int j = 0; j < TargetFunctionCoefficientsMatrix.RowNumber - 1; j++) {
+			ColumnSum = ColumnSum + TargetFunctionCoefficientsMatrix[j][i];
+		}
+		ColumnSum = ColumnSum + TargetFunction[NumbersOfVariables[i + matrix.RowNumber - 1] - 1];
+		matrix[matrix.RowNumber - 1][i] = ColumnSum;
+	}
+
+	// Free coefficient
+	ElementType ColumnSum = ZeroElement;
+	for (int i = 0; i < TargetFunctionCoefficientsMatrix.RowNumber - 1; i++) {
+		ColumnSum = ColumnSum + TargetFunctionCoefficientsMatrix[i][TargetFunctionCoefficientsMatrix.ColNumber - 1];
+	}
+	ColumnSum = ColumnSum + TargetFunction[TargetFunction.size() - 1];
+	matrix[matrix.RowNumber - 1][matrix.ColNumber - 1] = -ColumnSum;
+}
+
+void MakeSimplexAlgorithmFunctionCoefficients(Step& step, std::vector<Fraction>& FracTargetFunction) {
+	FractionalMatrix TargetFunctionCoefficientsMatrix(step.FracMatrix);
+
+	// Copy table one to one multiplying basis rows on coefficients of target function
+	for (int i = 0; i < step.FracMatrix.RowNumber - 1; i++) {
+		for (int j = 0; j < step.FracMatrix.ColNumber; j++) {
+			if (j < step.FracMatrix.ColNumber - 1) {
+				TargetFunctionCoefficientsMatrix[i][j] = FracTargetFunction[step.NumbersOfVariables[i] - 1] * step.FracMatrix[i][j] * (-1);
+			} else {
+				TargetFunctionCoefficientsMatrix[i][j] = FracTargetFunction[step.NumbersOfVariables[i] - 1] * step.FracMatrix[i][j];
+			}
+		}
+	}
+
+	// Fill new target function coefficients
+	for (int i = 0; i < TargetFunctionCoefficientsMatrix.ColNumber - 1; i++) {
+		Fraction ColumnSum = Fraction(0, 1);
+		for (int j = 0; j < TargetFunctionCoefficientsMatrix.RowNumber - 1; j++) {
+			ColumnSum += TargetFunctionCoefficientsMatrix[j][i];
+		}
+		ColumnSum += FracTargetFunction[step.NumbersOfVariables[i + step.FracMatrix.RowNumber - 1] - 1];
+		step.FracMatrix[step.FracMatrix.RowNumber - 1][i] = ColumnSum;
+	}
+
+	// Free coefficient
+	Fraction ColumnSum = Fraction(0, 1);
+	for (int i = 0; i < TargetFunctionCoefficientsMatrix.RowNumber - 1; i++) {
+		ColumnSum += TargetFunctionCoefficientsMatrix[i][TargetFunctionCoefficientsMatrix.ColNumber - 1];
+	}
+	ColumnSum += FracTargetFunction[FracTargetFunction.size() - 1];
+	step.FracMatrix[step.FracMatrix.RowNumber - 1][step.FracMatrix.ColNumber - 1] = -ColumnSum;
+}
+
+template<typename MatrixType, typename ElementType> void GaussElimination(MatrixType& matrix) {
+	int PivotRow = 0;
+	int PivotColumn = 0;
+	int num = 2;
+
+	// Type-independent zero element
+	// Float is [-EPSILON, +EPSILON], Fraction is 0/1
+	ElementType ZeroElement;
+	if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
+		ZeroElement = EPSILON;
+	} else {
+		ZeroElement = Fraction(0, 1);
+	}
+
+	while (PivotRow < (matrix.RowNumber - 1) && PivotColumn < matrix.ColNumber - 1) {
+		// Find max value in a column
+		ElementType MaxPivot;
+		MaxPivot = Genfabs(matrix[PivotRow][PivotColumn]);
+
+		int MaxPivotIdx = PivotRow;
+		for (int i = PivotRow; i < matrix.RowNumber - PivotRow - 1 - 1; i++) {
+			if (Genfabs(matrix[i][PivotColumn]) > MaxPivot) {
+				MaxPivot = Genfabs(matrix[i][PivotColumn]);
+				MaxPivotIdx = i;
+			}
+		}
+
+		if (Genfabs(matrix[MaxPivotIdx][PivotColumn]) <= ZeroElement) {
+			PivotColumn += 1;
+		} else {
+			matrix.SwapRows(PivotRow, MaxPivotIdx);
+
+			// Substract all rows below pivot
+			for (int i = PivotRow + 1; i < matrix.RowNumber - 1; i++) {
+
+				ElementType Factor = matrix[i][PivotColumn] / matrix[PivotRow][PivotColumn];
+				if constexpr (IS_SAME_TYPE(ElementType, float)) {
+					matrix[i][PivotColumn] = 0.0f;
+				} else {
+					matrix[i][PivotColumn] = Fraction(0, 1);
+				}
+
+				for (int j = PivotColumn + 1; j < matrix.ColNumber; j++) {
+					matrix[i][j] = matrix[i][j] - matrix[PivotRow][j] * Factor;
+				}
+			}
+
+			PivotRow++;
+			PivotColumn++;
+		}
+	}
+
+	// Backward substitution
+	for (int i = matrix.RowNumber - 2; i > 0; i--) {
+		if (Genfabs(matrix[i][i]) <= ZeroElement) continue;
+		for (int j = i; j > 0; j--) {
+			ElementType Factor = matrix[j - 1][i] / matrix[i][i];
+			for (int k = i; k < matrix.ColNumber - 1; k++) {
+				matrix[j - 1][k] = matrix[j - 1][k] - matrix[i][k] * Factor;
+			}
+
+			matrix[j - 1][matrix.ColNumber - 1] = matrix[j - 1][matrix.ColNumber - 1] - matrix[i][matrix.ColNumber - 1] * Factor;
+		}
+	}
+
+	// Normalization
+	for (int i = 0; i < matrix.RowNumber - 1; i++) {
+		ElementType Pivot = matrix[i][i];
+		if (Genfabs(Pivot) <= ZeroElement) continue;
+
+		for (int j = i; j < matrix.ColNumber; j++) {
+			matrix[i][j] = matrix[i][j] / Pivot;
+		}
+	}
+}
+
+void Print(Matrix& matrix) {
+	printf("\n");
+	for (int i = 0; i < matrix.RowNumber - 1; i++) {
+		for (int j = 0; j < matrix.ColNumber; j++) {
+			printf("%f ", matrix[i][j]);
+		}
+		printf("\n");
+	}
+}
+
+template<typename MatrixType, typename ElementType>Step ExplicitBasis(Step step, MatrixType& matrix, std::vector<ElementType>& ExplicitBasis, std::vector<bool>& ActiveBasis, std::vector<ElementType>& TargetFunction) {
+	// Type-independent zero element
+	// Float is [-EPSILON, +EPSILON], Fraction is 0/1
+	ElementType ZeroElement;
+	if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
+		ZeroElement = EPSILON;
+	} else {
+		ZeroElement = Fraction(0, 1);
+	}
+
+	// 1. Prepare matrix to Gauss elimination
+	std::vector<int> PositionsOfActiveElements;
+	std::vector<int> VariablesPositions;
+	for (int i = 0; i < ExplicitBasis.size(); i++) {
+		VariablesPositions.push_back(i + 1);
+	}
+
+	// 1.1 Find positions of non-zero elements
+	for (int i = 0; i < ActiveBasis.size(); i++) {
+		if (ActiveBasis[i]) {
+			PositionsOfActiveElements.push_back(i);
+		}
+	}
+
+	// 1.2 Swap matrix column and variables to first (RowNumber) columns
+	for (int i = 0; i < PositionsOfActiveElements.size(); i++) {
+		int NonZeroPosition = PositionsOfActiveElements[i];
+		matrix.SwapColumns(i, NonZeroPosition);
+		std::swap(VariablesPositions[i], VariablesPositions[NonZeroPosition]);
+	}
+
+	// 2. Gauss Elimination
+	ProfileClock::time_point GaussStart = ProfileClock::now();
+	GaussElimination<MatrixType, ElementType>(matrix);
+	Profiler.Add(PROFILE_GAUSS_ELIMINATION, GaussStart);
+
+	// 3. Complete table for first step of simplex alogrithm
+	// 3.1 Delete first RowNumber columns
+	for (int i = 0; i < matrix.RowNumber - 1; i++) {
+		matrix.DeleteColumn(0);
+	}
+
+	step.NumbersOfVariables = VariablesPositions;
+	MakeSimplexAlgorithmFunctionCoefficients(matrix, step.NumbersOfVariables, TargetFunction);
+	return step;
+}
+
+
+// Headless solving
+// --------------------
+// Problem in the same layout the GUI works with: the matrix has one extra row for
+// function coefficients and one extra column for vector B, target function has C as its last element
+struct Problem {
+	int NumberOfLimitations = 0;
+	int NumberOfVariables = 0;
+	bool IsFractionalCoefficients = false;
+	Matrix RealMatrix;
+	FractionalMatrix FracMatrix;
+	std::vector<float> RealTargetFunction;
+	std::vector<Fraction> FractionalTargetFunction;
+	// Solve modes, only configuration files set them
+	bool HasSolveModes = false;
+	bool IsArtificialBasis = true;
+	bool IsAutomatic = true;
+	// Maximization is solved as minimization of -f, the objective of its solution gets the sign of f back
+	bool IsMaximization = false;
+
+	Problem() : RealMatrix(1, 1), FracMatrix(1, 1) {}
+
+	void Resize(int NewNumberOfLimitations, int NewNumberOfVariables) {
+		NumberOfLimitations = NewNumberOfLimitations;
+		NumberOfVariables = NewNumberOfVariables;
+		RealMatrix.Resize(NumberOfLimitations + 1, NumberOfVariables + 1);
+		FracMatrix.Resize(NumberOfLimitations + 1, NumberOfVariables + 1);
+		RealTargetFunction.assign(NumberOfVariables + 1, 0.0f);
+		FractionalTargetFunction.assign(NumberOfVariables + 1, Fraction(0, 1));
+		for (int i = 0; i < RealMatrix.RowNumber * RealMatrix.ColNumber; i++) {
+			RealMatrix.matrix[i] = 0.0f;
+			FracMatrix.matrix[i] = Fraction(0, 1);
+		}
+	}
+};
+
+// Pivot of an automatic solution. Objective is the one of its method, the sum of artificial variables in the artificial basis method
+struct PivotStatistics {
+	bool IsArtificialStep;
+	int StepID;
+	int EnteringVariable;
+	int LeavingVariable;
+	double Objective;
+	long long Nanoseconds;
+};
+
+struct Solution {
+	AlgorithmState State = UNDEFINED;
+	int ArtificialPivots = 0;
+	int SimplexPivots = 0;
+	double Objective = 0.0;
+	std::vector<double> X;
+	// Basis variables of the final table, numbers start from 1. Artificial variables aren't included
+	std::vector<int> Basis;
+	// Every pivot of both methods in the order they were made
+	std::vector<PivotStatistics> Pivots;
+};
+
+static double ToDouble(float value) { return value; }
+static double ToDouble(Fraction value) { return (double)value.numerator / value.denominator; }
+
+// Returns matrix of a step that is used by the chosen type of coefficients
+template<typename MatrixType> MatrixType& StepMatrix(Step& step) {
+	if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
+		return step.RealMatrix;
+	} else {
+		return step.FracMatrix;
+	}
+}
+
+// Rearranges variables after a pivot of the artificial basis method
+// and deletes column of the artificial variable that has left the basis
+template<typename MatrixType> void CompleteArtificialStep(Step& NewStep, int OriginalColNumber) {
+	MatrixType& matrix = StepMatrix<MatrixType>(NewStep);
+	int RowNumber = matrix.RowNumber;
+
+	// Change order of variables in the array of variables
+	std::swap(NewStep.NumbersOfVariables[NewStep.StepChosenRC.Row], NewStep.NumbersOfVariables[(RowNumber - 1) + NewStep.StepChosenRC.Column]);
+	for (int i = RowNumber - 1; i < NewStep.NumbersOfVariables.size(); i++) {
+		if (NewStep.NumbersOfVariables[i] > OriginalColNumber - 1) {
+			NewStep.NumbersOfVariables.erase(NewStep.NumbersOfVariables.begin() + i);
+			matrix.DeleteColumn(i - (RowNumber - 1));
+			break;
+		}
+	}
+
+	// Disables "confirm" button
+	AlgorithmState state = CheckAlgorithmState(matrix, false, NewStep.IsArtificialStep);
+	if (state == COMPLETED) {
+		NewStep.IsCompleted = true;
+	}
+}
+
+// Rearranges variables after a pivot of the simplex algorithm
+template<typename MatrixType> void CompleteSimplexStep(Step& NewStep) {
+	MatrixType& matrix = StepMatrix<MatrixType>(NewStep);
+	int RowNumber = matrix.RowNumber;
+
+	// Change order of variables in the array of variables
+	std::swap(NewStep.NumbersOfVariables[NewStep.StepChosenRC.Row], NewStep.NumbersOfVariables[(RowNumber - 1) + NewStep.StepChosenRC.Column]);
+
+	// Disables "confirm" button
+	AlgorithmState state = CheckAlgorithmState(matrix, false, NewStep.IsArtificialStep);
+	if (state == COMPLETED) {
+		NewStep.IsCompleted = true;
+	}
+}
+
+// Builds first step of the artificial basis method from a problem
+template<typename MatrixType> Step MakeArtificialBasisStep(Problem& problem) {
+	Step step(problem.RealMatrix, problem.FracMatrix);
+	step.StepID = 0;
+	step.IsAutomatic = true;
+	step.IsWaitingForInput = false;
+	step.IsCompleted = false;
+	step.IsArtificialStep = true;
+
+	MatrixType& matrix = StepMatrix<MatrixType>(step);
+	// Artificial variables
+	for (int i = 0; i < matrix.RowNumber - 1; i++) {
+		step.NumbersOfVariables.push_back(matrix.ColNumber + i);
+	}
+	// Variables
+	for (int i = 0; i < matrix.ColNumber - 1; i++) {
+		step.NumbersOfVariables.push_back(i + 1);
+	}
+
+	if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
+		MakeArtificialFunctionCoefficients(step.RealMatrix);
+	} else {
+		MakeArtificialFunctionCeofficients(step.FracMatrix);
+	}
+	return step;
+}
+
+// Builds first step of the artificial basis method from a basis of an earlier solution.
+// Basis variables are taken into rows by Gauss-Jordan pivots, each row gets the variable with the biggest element.
+// Variables that don't get a row and rows whose B becomes negative are left to artificial variables,
+// so a basis that still fits the problem needs no pivots of the artificial basis method at all
+template<typename MatrixType, typename ElementType> Step MakeWarmStartStep(Problem& problem, const std::vector<int>& Basis) {
+	int NumberOfLimitations = problem.NumberOfLimitations;
+	int NumberOfVariables = problem.NumberOfVariables;
+	MatrixType matrix;
+	if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
+		matrix = problem.RealMatrix;
+	} else {
+		matrix = problem.FracMatrix;
+	}
+
+	ElementType ZeroElement;
+	if constexpr (IS_SAME_TYPE(ElementType, float)) {
+		ZeroElement = EPSILON;
+	} else {
+		ZeroElement = Fraction(0, 1);
+	}
+
+	ProfileClock::time_point GaussStart = ProfileClock::now();
+	std::vector<int> RowVariables(NumberOfLimitations, 0);
+	std::vector<bool> IsBasisVariable(NumberOfVariables + 1, false);
+	int FreeRows = NumberOfLimitations;
+	for (int Variable : Basis) {
+		if (FreeRows == 0) {
+			break;
+		}
+		if (Variable < 1 || Variable > NumberOfVariables || IsBasisVariable[Variable]) {
+			continue;
+		}
+		int Column = Variable - 1;
+		int PivotRow = -1;
+		for (int i = 0; i < NumberOfLimitations; i++) {
+			if (RowVariables[i] == 0 && Genfabs(matrix[i][Column]) > ZeroElement && (PivotRow == -1 || Genfabs(matrix[i][Column]) > Genfabs(matrix[PivotRow][Column]))) {
+				PivotRow = i;
+			}
+		}
+		if (PivotRow == -1) {
+			continue;
+		}
+
+		ElementType Pivot = matrix[PivotRow][Column];
+		for (int j = 0; j < matrix.ColNumber; j++) {
+			matrix[PivotRow][j] = matrix[PivotRow][j] / Pivot;
+		}
+		for (int i = 0; i < NumberOfLimitations; i++) {
+			ElementType Factor = matrix[i][Column];
+			if (i == PivotRow || Genfabs(Factor) <= ZeroElement) {
+				continue;
+			}
+			for (int j = 0; j < matrix.ColNumber; j++) {
+				matrix[i][j] = matrix[i][j] - matrix[PivotRow][j] * Factor;
+			}
+		}
+		RowVariables[PivotRow] = Variable;
+		IsBasisVariable[Variable] = true;
+		FreeRows -= 1;
+	}
+
+	// Basis variable of a row with negative B would be negative, the row goes to an artificial variable
+	int LastColumn = matrix.ColNumber - 1;
+	for (int i = 0; i < NumberOfLimitations; i++) {
+		if (matrix[i][LastColumn] < -ZeroElement) {
+			IsBasisVariable[RowVariables[i]] = false;
+			RowVariables[i] = 0;
+			for (int j = 0; j < matrix.ColNumber; j++) {
+				matrix[i][j] = matrix[i][j] * (-1);
+			}
+		}
+	}
+	Profiler.Add(PROFILE_GAUSS_ELIMINATION, GaussStart);
+
+	// Table keeps only columns of variables outside of the basis
+	Step step(problem.RealMatrix, problem.FracMatrix);
+	step.StepID = 0;
+	step.IsAutomatic = true;
+	step.IsWaitingForInput = false;
+	step.IsCompleted = false;
+	step.IsArtificialStep = true;
+	for (int i = 0; i < NumberOfLimitations; i++) {
+		step.NumbersOfVariables.push_back(RowVariables[i] != 0 ? RowVariables[i] : NumberOfVariables + 1 + i);
+	}
+	for (int Variable = 1; Variable <= NumberOfVariables; Variable++) {
+		if (!IsBasisVariable[Variable]) {
+			step.NumbersOfVariables.push_back(Variable);
+		}
+	}
+
+	int NumberOfColumns = (int)step.NumbersOfVariables.size() - NumberOfLimitations + 1;
+	MatrixType& Table = StepMatrix<MatrixType>(step);
+	Table.Resize(NumberOfLimitations + 1, NumberOfColumns);
+	for (int i = 0; i < NumberOfLimitations; i++) {
+		for (int j = 0; j < NumberOfColumns - 1; j++) {
+			Table[i][j] = matrix[i][step.NumbersOfVariables[NumberOfLimitations + j] - 1];
+		}
+		Table[i][NumberOfColumns - 1] = matrix[i][LastColumn];
+	}
+
+	// Function of the artificial basis method is the sum of artificial variables
+	for (int j = 0; j < NumberOfColumns; j++) {
+		ElementType ColumnSum;
+		if constexpr (IS_SAME_TYPE(ElementType, float)) {
+			ColumnSum = 0.0f;
+		} else {
+			ColumnSum = Fraction(0, 1);
+		}
+		for (int i = 0; i < NumberOfLimitations; i++) {
+			if (RowVariables[i] == 0) {
+				ColumnSum = ColumnSum + Table[i][j];
+			}
+		}
+		Table[NumberOfLimitations][j] = -ColumnSum;
+	}
+	return step;
+}
+
+// Reads answer out of a final step
+template<typename MatrixType> void ExtractSolution(Step& step, int NumberOfVariables, Solution& solution) {
+	MatrixType& matrix = StepMatrix<MatrixType>(step);
+	int LastColumnIndex = matrix.ColNumber - 1;
+
+	solution.X.assign(NumberOfVariables, 0.0);
+	for (int i = 0; i < matrix.RowNumber - 1; i++) {
+		int Variable = step.NumbersOfVariables[i];
+		if (Variable <= NumberOfVariables) {
+			solution.X[Variable - 1] = ToDouble(matrix[i][LastColumnIndex]);
+			solution.Basis.push_back(Variable);
+		}
+	}
+	solution.Objective = -ToDouble(matrix[matrix.RowNumber - 1][LastColumnIndex]);
+}
+
+// Trace of the steps is written to a file (StepTrace.h)
+struct StepTrace;
+void TraceTable(StepTrace* Trace, Step& step);
+void TracePivot(StepTrace* Trace, Step& OldStep, Step& NewStep, long long Nanoseconds);
+
+// NewStep is made by a pivot of OldStep and has its variables rearranged
+template<typename MatrixType> void AddPivotStatistics(Solution& solution, Step& OldStep, Step& NewStep, long long Nanoseconds) {
+	MatrixType& matrix = StepMatrix<MatrixType>(NewStep);
+	int Row = NewStep.StepChosenRC.Row;
+	PivotStatistics Pivot;
+	Pivot.IsArtificialStep = NewStep.IsArtificialStep;
+	Pivot.StepID = NewStep.StepID;
+	Pivot.EnteringVariable = NewStep.NumbersOfVariables[Row];
+	Pivot.LeavingVariable = OldStep.NumbersOfVariables[Row];
+	Pivot.Objective = -ToDouble(matrix[matrix.RowNumber - 1][matrix.ColNumber - 1]);
+	Pivot.Nanoseconds = Nanoseconds;
+	solution.Pivots.push_back(Pivot);
+}
+
+// Solves problem automatically with artificial basis method and simplex algorithm without any GUI involved,
+// starting from the first step of the artificial basis method.
+// MaxPivots limits number of pivots of each phase, 0 means a limit based on the problem size.
+// If the limit is hit state of the solution is CONTINUE. Every pivot goes to Trace if it's given
+template<typename MatrixType, typename ElementType> Solution SolveFromStep(Problem& problem, Step step, int MaxPivots, StepTrace* Trace = NULL) {
+	Solution solution;
+	if (MaxPivots == 0) {
+		MaxPivots = 50 * (problem.NumberOfLimitations + problem.NumberOfVariables) + 100;
+	}
+
+	std::vector<ElementType>* TargetFunction;
+	if constexpr (IS_SAME_TYPE(ElementType, float)) {
+		TargetFunction = &problem.RealTargetFunction;
+	} else {
+		TargetFunction = &problem.FractionalTargetFunction;
+	}
+
+	// Artificial basis
+	int OriginalColNumber = problem.NumberOfVariables + 1;
+	if (Trace) {
+		TraceTable(Trace, step);
+	}
+	while (!step.IsCompleted && solution.ArtificialPivots < MaxPivots) {
+		ProfileClock::time_point PivotStart = ProfileClock::now();
+		Step NewStep = SimplexStep<MatrixType, ElementType>(step);
+		if (NewStep.IsCompleted) {
+			break;
+		}
+
+		CompleteArtificialStep<MatrixType>(NewStep, OriginalColNumber);
+		solution.ArtificialPivots += 1;
+		long long Nanoseconds = SolverProfile::Elapsed(PivotStart, ProfileClock::now());
+		AddPivotStatistics<MatrixType>(solution, step, NewStep, Nanoseconds);
+		if (Trace) {
+			TracePivot(Trace, step, NewStep, Nanoseconds);
+		}
+		step = NewStep;
+	}
+
+	solution.State = CheckAlgorithmState(StepMatrix<MatrixType>(step), false, true);
+	if (solution.State != COMPLETED) {
+		return solution;
+	}
+
+	ElementType ZeroElement;
+	if constexpr (IS_SAME_TYPE(ElementType, float)) {
+		ZeroElement = 0.0f;
+	} else {
+		ZeroElement = Fraction(0, 1);
+	}
+
+	// Artificial variables that stayed in basis on zero level get zero coefficients
+	std::vector<ElementType> Coefficients(TargetFunction->begin(), TargetFunction->end() - 1);
+	for (int i = 0; i < problem.NumberOfLimitations; i++) {
+		Coefficients.push_back(ZeroElement);
+	}
+	Coefficients.push_back(TargetFunction->back());
+
+	// Simplex algorithm
+	step.StepID = 0;
+	step.IsCompleted = false;
+	step.IsArtificialStep = false;
+	MakeSimplexAlgorithmFunctionCoefficients(StepMatrix<MatrixType>(step), step.NumbersOfVariables, Coefficients);
+	if (Trace) {
+		TraceTable(Trace, step);
+	}
+	while (!step.IsCompleted && solution.SimplexPivots < MaxPivots) {
+		ProfileClock::time_point PivotStart = ProfileClock::now();
+		Step NewStep = SimplexStep<MatrixType, ElementType>(step);
+		if (NewStep.IsCompleted) {
+			break;
+		}
+
+		CompleteSimplexStep<MatrixType>(NewStep);
+		solution.SimplexPivots += 1;
+		long long Nanoseconds = SolverProfile::Elapsed(PivotStart, ProfileClock::now());
+		AddPivotStatistics<MatrixType>(solution, step, NewStep, Nanoseconds);
+		if (Trace) {
+			TracePivot(Trace, step, NewStep, Nanoseconds);
+		}
+		step = NewStep;
+	}
+
+	solution.State = CheckAlgorithmState(StepMatrix<MatrixType>(step), false, false);
+	if (solution.State == COMPLETED) {
+		ExtractSolution<MatrixType>(step, problem.NumberOfVariables, solution);
+		if (problem.IsMaximization) {
+			solution.Objective = -solution.Objective;
+		}
+	}
+	return solution;
+}
+
+template<typename MatrixType, typename ElementType> Solution SolveProblem(Problem& problem, int MaxPivots = 0, StepTrace* Trace = NULL) {
+	return SolveFromStep<MatrixType, ElementType>(problem, MakeArtificialBasisStep<MatrixType>(problem), MaxPivots, Trace);
+}
+
+Solution SolveProblem(Problem& problem, int MaxPivots = 0, StepTrace* Trace = NULL) {
+	if (problem.IsFractionalCoefficients) {
+		return SolveProblem<FractionalMatrix, Fraction>(problem, MaxPivots, Trace);
+	} else {
+		return SolveProblem<Matrix, float>(problem, MaxPivots, Trace);
+	}
+}
+
+// Warm start: solving begins from a basis of an earlier solution of a similar problem
+Solution SolveFromBasis(Problem& problem, const std::vector<int>& Basis, int MaxPivots = 0, StepTrace* Trace = NULL) {
+	if (problem.IsFractionalCoefficients) {
+		return SolveFromStep<FractionalMatrix, Fraction>(problem, MakeWarmStartStep<FractionalMatrix, Fraction>(problem, Basis), MaxPivots, Trace);
+	} else {
+		return SolveFromStep<Matrix, float>(problem, MakeWarmStartStep<Matrix, float>(problem, Basis), MaxPivots, Trace);
+	}
+}
+//--------------------
@@ -0,0 +1,457 @@
+#pragma once
+
+// Binary snapshot of a solution: the problem, explicit basis, tables the solution has stopped at and
+// an optional journal of pivots. Tables are stored exactly as they are in memory, so solving goes on
+// from the same numbers after the snapshot is opened.
+//
+// File is a header and a payload. Numbers are little-endian (hosts are little-endian, as in NumberParser),
+// every part of the payload takes a multiple of four bytes, so the checksum goes over 32-bit words.
+// Payload:
+//   NumberOfLimitations, NumberOfVariables, matrix of limitations, target function,
+//   explicit basis and its active elements,
+//   steps of the artificial basis method and of the simplex algorithm,
+//   journal of both if SNAPSHOT_JOURNAL is set.
+// Only elements of the type of the problem are stored, elements of the other type are zero after reading
+
+const uint32_t SnapshotVersion = 1;
+
+enum SnapshotFlag {
+	SNAPSHOT_FRACTIONS = 1,
+	SNAPSHOT_ARTIFICIAL_BASIS = 2,
+	SNAPSHOT_AUTOMATIC = 4,
+	SNAPSHOT_JOURNAL = 8,
+	SNAPSHOT_SOLUTION_SHOWN = 16,
+	SNAPSHOT_SIMPLEX_STARTED = 32,
+	SNAPSHOT_MAXIMIZATION = 64,
+};
+
+enum SnapshotStepFlag {
+	SNAPSHOT_STEP_AUTOMATIC = 1,
+	SNAPSHOT_STEP_WAITING_FOR_INPUT = 2,
+	SNAPSHOT_STEP_COMPLETED = 4,
+	SNAPSHOT_STEP_ARTIFICIAL = 8,
+};
+
+struct SnapshotHeader {
+	char Magic[4];
+	uint32_t Version;
+	uint32_t Flags;
+	uint32_t Reserved;
+	uint64_t PayloadSize;
+	// Fletcher checksum of the payload
+	uint64_t Sum;
+	uint64_t SumOfSums;
+};
+
+static_assert(sizeof(SnapshotHeader) == 40, "Header of snapshot has no padding");
+static_assert(sizeof(Fraction) == 2 * sizeof(int32_t), "Fractions are stored as two integers");
+
+struct SolutionSnapshot {
+	Problem problem;
+	std::vector<float> RealExplicitBasis;
+	std::vector<Fraction> FractionalExplicitBasis;
+	std::vector<bool> BasisActive;
+	bool IsSolutionShown = false;
+	bool IsSimplexAlgorithmStarted = false;
+	// First and last steps of both methods, the template step before the artificial basis method isn't stored
+	std::vector<Step> ArtificialBasisSteps;
+	std::vector<Step> SimplexAlgorithmSteps;
+	// Pivots between the first and the last steps
+	bool HasJournal = false;
+	StepSummaries ArtificialBasisJournal;
+	StepSummaries SimplexAlgorithmJournal;
+};
+
+// Fletcher checksum over 32-bit words. Four words go at once, so sums don't wait for each other on every word
+struct SnapshotChecksum {
+	uint64_t Sum = 0;
+	uint64_t SumOfSums = 0;
+
+	void Add(const void* Data, size_t Size) {
+		assert(Size % 4 == 0);
+		const char* Bytes = (const char*)Data;
+		size_t Count = Size / 4;
+		size_t i = 0;
+		for (; i + 4 <= Count; i += 4) {
+			uint32_t Words[4];
+			memcpy(Words, Bytes + i * 4, sizeof(Words));
+			SumOfSums += 4 * Sum + 4 * (uint64_t)Words[0] + 3 * (uint64_t)Words[1] + 2 * (uint64_t)Words[2] + Words[3];
+			Sum += (uint64_t)Words[0] + Words[1] + Words[2] + Words[3];
+		}
+		for (; i < Count; i++) {
+			uint32_t Word;
+			memcpy(&Word, Bytes + i * 4, sizeof(Word));
+			Sum += Word;
+			SumOfSums += Sum;
+		}
+	}
+};
+
+// Small parts are gathered in a buffer, big arrays are written straight from memory
+struct SnapshotWriter {
+	FILE* File;
+	std::vector<char> Buffer;
+	SnapshotChecksum Checksum;
+	uint64_t PayloadSize = 0;
+	bool IsFailed = false;
+
+	static const size_t BufferSize = 1 << 16;
+
+	SnapshotWriter(FILE* File) : File(File) {
+		Buffer.reserve(BufferSize);
+	}
+
+	void WriteThrough(const void* Data, size_t Size) {
+		Checksum.Add(Data, Size);
+		PayloadSize += Size;
+		IsFailed = IsFailed || fwrite(Data, 1, Size, File) != Size;
+	}
+
+	void Flush() {
+		if (!Buffer.empty()) {
+			WriteThrough(Buffer.data(), Buffer.size());
+			Buffer.clear();
+		}
+	}
+
+	void Append(const void* Data, size_t Size) {
+		if (Buffer.size() + Size > BufferSize) {
+			Flush();
+		}
+		if (Size >= BufferSize) {
+			WriteThrough(Data, Size);
+		} else {
+			Buffer.insert(Buffer.end(), (const char*)Data, (const char*)Data + Size);
+		}
+	}
+
+	void Int(int32_t Value) {
+		Append(&Value, sizeof(Value));
+	}
+
+	// Numbers of variables, bytes of flags and other arrays are padded to four bytes
+	void Ints(const std::vector<int>& Values) {
+		Int((int32_t)Values.size());
+		Append(Values.data(), Values.size() * sizeof(int32_t));
+	}
+
+	void Flags(const std::vector<bool>& Values) {
+		Int((int32_t)Values.size());
+		std::vector<uint8_t> Bytes((Values.size() + 3) / 4 * 4, 0);
+		for (size_t i = 0; i < Values.size(); i++) {
+			Bytes[i] = Values[i];
+		}
+		Append(Bytes.data(), Bytes.size());
+	}
+
+	template<typename ElementType> void Elements(const std::vector<ElementType>& Values) {
+		Int((int32_t)Values.size());
+		Append(Values.data(), Values.size() * sizeof(ElementType));
+	}
+
+	template<typename MatrixType> void Table(MatrixType& matrix) {
+		Int(matrix.RowNumber);
+		Int(matrix.ColNumber);
+		Append(matrix.matrix, (size_t)matrix.RowNumber * matrix.ColNumber * sizeof(*matrix.matrix));
+	}
+
+	void WriteStep(Step& step, bool IsFractionalCoefficients) {
+		Int(step.StepID);
+		Int(step.StepChosenRC.Row);
+		Int(step.StepChosenRC.Column);
+		Int(step.LeadElementRC.Row);
+		Int(step.LeadElementRC.Column);
+		Int((step.IsAutomatic ? SNAPSHOT_STEP_AUTOMATIC : 0) | (step.IsWaitingForInput ? SNAPSHOT_STEP_WAITING_FOR_INPUT : 0)
+			| (step.IsCompleted ? SNAPSHOT_STEP_COMPLETED : 0) | (step.IsArtificialStep ? SNAPSHOT_STEP_ARTIFICIAL : 0));
+		Ints(step.NumbersOfVariables);
+		if (IsFractionalCoefficients) {
+			Table(step.FracMatrix);
+		} else {
+			Table(step.RealMatrix);
+		}
+	}
+
+	void WriteSteps(std::vector<Step>& Steps, bool IsFractionalCoefficients) {
+		Int((int32_t)Steps.size());
+		for (Step& step : Steps) {
+			WriteStep(step, IsFractionalCoefficients);
+		}
+	}
+
+	void WriteJournal(const StepSummaries& Journal) {
+		Int((int32_t)Journal.Rows.size());
+		for (const StepSummary& Summary : Journal.Rows) {
+			Int(Summary.StepID);
+			Int(Summary.EnteringVariable);
+			Int(Summary.LeavingVariable);
+			Append(&Summary.Objective, sizeof(Summary.Objective));
+		}
+		Ints(Journal.LastVariables);
+	}
+};
+
+// Returns NULL on success and error message otherwise
+const char* WriteSnapshot(const char* FileName, SolutionSnapshot& Snapshot) {
+	Problem& problem = Snapshot.problem;
+	bool IsFractionalCoefficients = problem.IsFractionalCoefficients;
+	FILE* File = fopen(FileName, "wb");
+	if (!File) {
+		return "Can't open file";
+	}
+
+	// Header is written again when the checksum is known
+	SnapshotHeader Header = {};
+	memcpy(Header.Magic, "SPXS", 4);
+	Header.Version = SnapshotVersion;
+	Header.Flags = (IsFractionalCoefficients ? SNAPSHOT_FRACTIONS : 0) | (problem.IsArtificialBasis ? SNAPSHOT_ARTIFICIAL_BASIS : 0)
+		| (problem.IsAutomatic ? SNAPSHOT_AUTOMATIC : 0) | (Snapshot.HasJournal ? SNAPSHOT_JOURNAL : 0)
+		| (Snapshot.IsSolutionShown ? SNAPSHOT_SOLUTION_SHOWN : 0) | (Snapshot.IsSimplexAlgorithmStarted ? SNAPSHOT_SIMPLEX_STARTED : 0)
+		| (problem.IsMaximization ? SNAPSHOT_MAXIMIZATION : 0);
+	bool IsFailed = fwrite(&Header, sizeof(Header), 1, File) != 1;
+
+	SnapshotWriter Writer(File);
+	Writer.Int(problem.NumberOfLimitations);
+	Writer.Int(problem.NumberOfVariables);
+	if (IsFractionalCoefficients) {
+		Writer.Table(problem.FracMatrix);
+		Writer.Elements(problem.FractionalTargetFunction);
+		Writer.Elements(Snapshot.FractionalExplicitBasis);
+	} else {
+		Writer.Table(problem.RealMatrix);
+		Writer.Elements(problem.RealTargetFunction);
+		Writer.Elements(Snapshot.RealExplicitBasis);
+	}
+	Writer.Flags(Snapshot.BasisActive);
+	Writer.WriteSteps(Snapshot.ArtificialBasisSteps, IsFractionalCoefficients);
+	Writer.WriteSteps(Snapshot.SimplexAlgorithmSteps, IsFractionalCoefficients);
+	if (Snapshot.HasJournal) {
+		Writer.WriteJournal(Snapshot.ArtificialBasisJournal);
+		Writer.WriteJournal(Snapshot.SimplexAlgorithmJournal);
+	}
+	Writer.Flush();
+
+	Header.PayloadSize = Writer.PayloadSize;
+	Header.Sum = Writer.Checksum.Sum;
+	Header.SumOfSums = Writer.Checksum.SumOfSums;
+	IsFailed = IsFailed || Writer.IsFailed || fseek(File, 0, SEEK_SET) != 0 || fwrite(&Header, sizeof(Header), 1, File) != 1;
+	IsFailed = fclose(File) != 0 || IsFailed;
+	return IsFailed ? "Can't write file" : NULL;
+}
+
+// Every read checks that the payload has enough bytes, so damaged sizes can't make huge allocations
+struct SnapshotReader {
+	const char* Position;
+	const char* End;
+	bool IsFailed = false;
+
+	SnapshotReader(const char* Data, size_t Size) : Position(Data), End(Data + Size) {}
+
+	bool Has(uint64_t Size) {
+		IsFailed = IsFailed || Size > (uint64_t)(End - Position);
+		return !IsFailed;
+	}
+
+	void Read(void* Data, size_t Size) {
+		if (Size != 0 && Has(Size)) {
+			memcpy(Data, Position, Size);
+			Position += Size;
+		}
+	}
+
+	int32_t Int() {
+		int32_t Value = 0;
+		Read(&Value, sizeof(Value));
+		return Value;
+	}
+
+	// Count of elements that follows, negative counts are errors
+	int32_t Count(size_t ElementSize) {
+		int32_t Value = Int();
+		if (Value < 0 || !Has((uint64_t)Value * ElementSize)) {
+			IsFailed = true;
+			return 0;
+		}
+		return Value;
+	}
+
+	void Ints(std::vector<int>& Values) {
+		Values.resize(Count(sizeof(int32_t)));
+		Read(Values.data(), Values.size() * sizeof(int32_t));
+	}
+
+	void Flags(std::vector<bool>& Values) {
+		int32_t Size = Count(1);
+		const char* Bytes = Position;
+		Values.assign(Bytes, Bytes + Size);
+		Has((Size + 3) / 4 * 4);
+		Position += IsFailed ? 0 : (Size + 3) / 4 * 4;
+	}
+
+	template<typename ElementType> void Elements(std::vector<ElementType>& Values) {
+		Values.resize(Count(sizeof(ElementType)));
+		Read(Values.data(), Values.size() * sizeof(ElementType));
+	}
+
+	// Table of the stored type and a zero table of the same size of the other type
+	void Tables(Matrix& RealMatrix, FractionalMatrix& FracMatrix, bool IsFractionalCoefficients) {
+		int32_t RowNumber = Int();
+		int32_t ColNumber = Int();
+		size_t ElementSize = IsFractionalCoefficients ? sizeof(Fraction) : sizeof(float);
+		if (RowNumber < 1 || ColNumber < 1 || !Has((uint64_t)RowNumber * ColNumber * ElementSize)) {
+			IsFailed = true;
+			return;
+		}
+		size_t Elements = (size_t)RowNumber * ColNumber;
+		RealMatrix.Resize(RowNumber, ColNumber);
+		FracMatrix.Resize(RowNumber, ColNumber);
+		if (IsFractionalCoefficients) {
+			Read(FracMatrix.matrix, Elements * sizeof(Fraction));
+			std::fill(RealMatrix.matrix, RealMatrix.matrix + Elements, 0.0f);
+		} else {
+			Read(RealMatrix.matrix, Elements * sizeof(float));
+			std::fill(FracMatrix.matrix, FracMatrix.matrix + Elements, Fraction(0, 1));
+		}
+	}
+
+	// Steps go to the interface as they are, so their tables and variables are checked against the problem
+	void ReadStep(Step& step, bool IsFractionalCoefficients, int NumberOfLimitations, int NumberOfVariables) {
+		step.StepID = Int();
+		step.StepChosenRC.Row = Int();
+		step.StepChosenRC.Column = Int();
+		step.LeadElementRC.Row = Int();
+		step.LeadElementRC.Column = Int();
+		int32_t Flags = Int();
+		step.IsAutomatic = (Flags & SNAPSHOT_STEP_AUTOMATIC) != 0;
+		step.IsWaitingForInput = (Flags & SNAPSHOT_STEP_WAITING_FOR_INPUT) != 0;
+		step.IsCompleted = (Flags & SNAPSHOT_STEP_COMPLETED) != 0;
+		step.IsArtificialStep = (Flags & SNAPSHOT_STEP_ARTIFICIAL) != 0;
+		Ints(step.NumbersOfVariables);
+		Tables(step.RealMatrix, step.FracMatrix, IsFractionalCoefficients);
+		if (IsFailed) {
+			return;
+		}
+
+		// Table has a row for every limitation and the function. First variables of the step are basis variables
+		// of its rows and the rest are variables of its columns, only the artificial basis method has artificial variables
+		int RowNumber = step.RealMatrix.RowNumber;
+		int ColNumber = step.RealMatrix.ColNumber;
+		int64_t LastVariable = step.IsArtificialStep ? (int64_t)NumberOfVariables + NumberOfLimitations : NumberOfVariables;
+		if (RowNumber - 1 != NumberOfLimitations || ColNumber - 1 > NumberOfVariables
+			|| step.NumbersOfVariables.size() != RowNumber + ColNumber - 2) {
+			IsFailed = true;
+			return;
+		}
+		std::vector<int> Variables(step.NumbersOfVariables);
+		std::sort(Variables.begin(), Variables.end());
+		if ((!Variables.empty() && (Variables.front() < 1 || Variables.back() > LastVariable)) || std::adjacent_find(Variables.begin(), Variables.end()) != Variables.end()) {
+			IsFailed = true;
+		}
+	}
+
+	void ReadSteps(std::vector<Step>& Steps, bool IsFractionalCoefficients, int NumberOfLimitations, int NumberOfVariables) {
+		// Every step takes at least ten integers
+		Steps.resize(Count(10 * sizeof(int32_t)));
+		for (Step& step : Steps) {
+			ReadStep(step, IsFractionalCoefficients, NumberOfLimitations, NumberOfVariables);
+			if (IsFailed) {
+				return;
+			}
+		}
+	}
+
+	void ReadJournal(StepSummaries& Journal) {
+		const size_t SummarySize = 3 * sizeof(int32_t) + sizeof(double);
+		Journal.Rows.resize(Count(SummarySize));
+		for (StepSummary& Summary : Journal.Rows) {
+			Summary.StepID = Int();
+			Summary.EnteringVariable = Int();
+			Summary.LeavingVariable = Int();
+			Read(&Summary.Objective, sizeof(Summary.Objective));
+		}
+		Ints(Journal.LastVariables);
+	}
+};
+
+// Reads snapshot with one mapping of the file. Returns NULL on success and error message otherwise
+const char* ReadSnapshot(const char* FileName, SolutionSnapshot& Snapshot, ReadStatistics& Statistics) {
+	auto Start = std::chrono::steady_clock::now();
+	Snapshot = SolutionSnapshot();
+	MappedFile File;
+	if (const char* Error = File.Open(FileName)) {
+		return Error;
+	}
+	Statistics.Bytes = File.Size;
+
+	SnapshotHeader Header;
+	if (File.Size < sizeof(Header)) {
+		return "File isn't a snapshot";
+	}
+	memcpy(&Header, File.Data, sizeof(Header));
+	if (memcmp(Header.Magic, "SPXS", 4) != 0) {
+		return "File isn't a snapshot";
+	}
+	if (Header.Version != SnapshotVersion) {
+		return "Version of the snapshot isn't supported";
+	}
+	if (Header.PayloadSize != File.Size - sizeof(Header) || Header.PayloadSize % 4 != 0) {
+		return "Snapshot is truncated";
+	}
+	SnapshotChecksum Checksum;
+	Checksum.Add(File.Data + sizeof(Header), Header.PayloadSize);
+	if (Checksum.Sum != Header.Sum || Checksum.SumOfSums != Header.SumOfSums) {
+		return "Checksum of the snapshot doesn't match";
+	}
+
+	bool IsFractionalCoefficients = (Header.Flags & SNAPSHOT_FRACTIONS) != 0;
+	Problem& problem = Snapshot.problem;
+	problem.IsFractionalCoefficients = IsFractionalCoefficients;
+	problem.HasSolveModes = true;
+	problem.IsArtificialBasis = (Header.Flags & SNAPSHOT_ARTIFICIAL_BASIS) != 0;
+	problem.IsAutomatic = (Header.Flags & SNAPSHOT_AUTOMATIC) != 0;
+	problem.IsMaximization = (Header.Flags & SNAPSHOT_MAXIMIZATION) != 0;
+	Snapshot.HasJournal = (Header.Flags & SNAPSHOT_JOURNAL) != 0;
+	Snapshot.IsSolutionShown = (Header.Flags & SNAPSHOT_SOLUTION_SHOWN) != 0;
+	Snapshot.IsSimplexAlgorithmStarted = (Header.Flags & SNAPSHOT_SIMPLEX_STARTED) != 0;
+
+	SnapshotReader Reader(File.Data + sizeof(Header), Header.PayloadSize);
+	problem.NumberOfLimitations = Reader.Int();
+	problem.NumberOfVariables = Reader.Int();
+	Reader.Tables(problem.RealMatrix, problem.FracMatrix, IsFractionalCoefficients);
+	if (IsFractionalCoefficients) {
+		Reader.Elements(problem.FractionalTargetFunction);
+		Reader.Elements(Snapshot.FractionalExplicitBasis);
+		problem.RealTargetFunction.assign(problem.FractionalTargetFunction.size(), 0.0f);
+		Snapshot.RealExplicitBasis.assign(Snapshot.FractionalExplicitBasis.size(), 0.0f);
+	} else {
+		Reader.Elements(problem.RealTargetFunction);
+		Reader.Elements(Snapshot.RealExplicitBasis);
+		problem.FractionalTargetFunction.assign(problem.RealTargetFunction.size(), Fraction(0, 1));
+		Snapshot.FractionalExplicitBasis.assign(Snapshot.RealExplicitBasis.size(), Fraction(0, 1));
+	}
+	Reader.Flags(Snapshot.BasisActive);
+	if (Reader.IsFailed) {
+		return "Snapshot is damaged";
+	}
+
+	int NumberOfVariables = problem.NumberOfVariables;
+	if (problem.NumberOfLimitations < 1 || NumberOfVariables < problem.NumberOfLimitations
+		|| problem.RealMatrix.RowNumber != problem.NumberOfLimitations + 1 || problem.RealMatrix.ColNumber != NumberOfVariables + 1
+		|| problem.RealTargetFunction.size() != NumberOfVariables + 1 || Snapshot.RealExplicitBasis.size() != NumberOfVariables
+		|| Snapshot.BasisActive.size() != NumberOfVariables) {
+		return "Wrong dimensions of the problem";
+	}
+
+	Reader.ReadSteps(Snapshot.ArtificialBasisSteps, IsFractionalCoefficients, problem.NumberOfLimitations, NumberOfVariables);
+	Reader.ReadSteps(Snapshot.SimplexAlgorithmSteps, IsFractionalCoefficients, problem.NumberOfLimitations, NumberOfVariables);
+	if (Snapshot.HasJournal) {
+		Reader.ReadJournal(Snapshot.ArtificialBasisJournal);
+		Reader.ReadJournal(Snapshot.SimplexAlgorithmJournal);
+	}
+	if (Reader.IsFailed || Reader.Position != Reader.End) {
+		return "Snapshot is damaged";
+	}
+
+	Statistics.Elements = (long long)problem.NumberOfLimitations * (NumberOfVariables + 1);
+	Statistics.Milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+	return NULL;
+}
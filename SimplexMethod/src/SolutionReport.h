@@ -0,0 +1,335 @@
+#pragma once
+
+// Report of a solution for analytics: values of variables, reduced costs, dual values, basis status and statistics of pivots.
+// Report is a set of columns, every column is an array that is used as it is after the file is mapped into memory.
+//
+// File is a header, a directory of columns and the columns. Numbers are little-endian, as in snapshots.
+// Every column starts at a multiple of 8 bytes from the beginning of the file, so its elements are aligned.
+// Columns:
+//   primal           float64  value of every variable
+//   reduced_cost     float64  c - y * A of every variable, zero for basis variables
+//   basis_status     int32    BASIS_BASIC or BASIS_AT_ZERO of every variable
+//   dual             float64  dual value y of every limitation
+//   pivot_method     int32    1 artificial basis method, 2 simplex algorithm
+//   pivot_step       int32    number of the step in its method
+//   pivot_entering   int32    variables of the pivot, numbers start from 1,
+//   pivot_leaving    int32    artificial variable of limitation i is NumberOfVariables + 1 + i
+//   pivot_objective  float64  function of the method after the pivot
+//   pivot_ns         int64    time of the pivot
+// Columns of variables and limitations are empty if the solution isn't completed
+
+const uint32_t ReportVersion = 1;
+
+enum ReportColumnType {
+	REPORT_INT32 = 1,
+	REPORT_INT64 = 2,
+	REPORT_FLOAT64 = 3,
+};
+
+enum BasisStatus {
+	BASIS_AT_ZERO = 0,
+	BASIS_BASIC = 1,
+};
+
+struct ReportHeader {
+	char Magic[4];
+	uint32_t Version;
+	uint32_t State;
+	uint32_t ColumnCount;
+	int32_t NumberOfLimitations;
+	int32_t NumberOfVariables;
+	int32_t ArtificialPivots;
+	int32_t SimplexPivots;
+	double Objective;
+};
+
+struct ReportColumn {
+	char Name[16];
+	uint32_t Type;
+	uint32_t Reserved;
+	uint64_t Count;
+	uint64_t Offset;
+};
+
+static_assert(sizeof(ReportHeader) == 40, "Header of report has no padding");
+static_assert(sizeof(ReportColumn) == 40, "Column of report has no padding");
+
+struct SolutionReport {
+	AlgorithmState State = UNDEFINED;
+	int NumberOfLimitations = 0;
+	int NumberOfVariables = 0;
+	int ArtificialPivots = 0;
+	int SimplexPivots = 0;
+	double Objective = 0.0;
+	std::vector<double> Primal;
+	std::vector<double> ReducedCosts;
+	std::vector<int32_t> BasisStatuses;
+	std::vector<double> Duals;
+	std::vector<int32_t> PivotMethods;
+	std::vector<int32_t> PivotSteps;
+	std::vector<int32_t> PivotEntering;
+	std::vector<int32_t> PivotLeaving;
+	std::vector<double> PivotObjectives;
+	std::vector<int64_t> PivotNanoseconds;
+};
+
+static double ProblemCoefficient(Problem& problem, int Row, int Column) {
+	return problem.IsFractionalCoefficients ? ToDouble(problem.FracMatrix[Row][Column]) : problem.RealMatrix[Row][Column];
+}
+
+static double TargetCoefficient(Problem& problem, int Column) {
+	return problem.IsFractionalCoefficients ? ToDouble(problem.FractionalTargetFunction[Column]) : problem.RealTargetFunction[Column];
+}
+
+// Dual values solve y * A_v = c_v for every basis variable v. Gauss-Jordan elimination chooses the biggest element
+// of every equation. Limitations left to artificial variables on zero level aren't determined by the basis, their dual values are zero
+static void ComputeDuals(Problem& problem, const std::vector<int>& Basis, std::vector<double>& Duals) {
+	int NumberOfLimitations = problem.NumberOfLimitations;
+	int Equations = Basis.size();
+	int Width = NumberOfLimitations + 1;
+	std::vector<double> System((size_t)Equations * Width);
+	for (int k = 0; k < Equations; k++) {
+		double* Equation = &System[(size_t)k * Width];
+		for (int i = 0; i < NumberOfLimitations; i++) {
+			Equation[i] = ProblemCoefficient(problem, i, Basis[k] - 1);
+		}
+		Equation[NumberOfLimitations] = TargetCoefficient(problem, Basis[k] - 1);
+	}
+
+	std::vector<int> PivotColumns(Equations, -1);
+	std::vector<bool> IsColumnUsed(NumberOfLimitations, false);
+	for (int k = 0; k < Equations; k++) {
+		double* Equation = &System[(size_t)k * Width];
+		int Column = -1;
+		for (int i = 0; i < NumberOfLimitations; i++) {
+			if (!IsColumnUsed[i] && (Column < 0 || fabs(Equation[i]) > fabs(Equation[Column]))) {
+				Column = i;
+			}
+		}
+		if (Column < 0 || fabs(Equation[Column]) < 1e-12) {
+			continue;
+		}
+		PivotColumns[k] = Column;
+		IsColumnUsed[Column] = true;
+
+		double Lead = Equation[Column];
+		for (int i = 0; i < Width; i++) {
+			Equation[i] /= Lead;
+		}
+		for (int Other = 0; Other < Equations; Other++) {
+			double* OtherEquation = &System[(size_t)Other * Width];
+			double Factor = OtherEquation[Column];
+			if (Other == k || Factor == 0.0) {
+				continue;
+			}
+			for (int i = 0; i < Width; i++) {
+				OtherEquation[i] -= Factor * Equation[i];
+			}
+		}
+	}
+
+	Duals.assign(NumberOfLimitations, 0.0);
+	for (int k = 0; k < Equations; k++) {
+		if (PivotColumns[k] >= 0) {
+			Duals[PivotColumns[k]] = System[(size_t)k * Width + NumberOfLimitations];
+		}
+	}
+}
+
+void MakeSolutionReport(Problem& problem, Solution& solution, SolutionReport& Report) {
+	Report = SolutionReport();
+	Report.State = solution.State;
+	Report.NumberOfLimitations = problem.NumberOfLimitations;
+	Report.NumberOfVariables = problem.NumberOfVariables;
+	Report.ArtificialPivots = solution.ArtificialPivots;
+	Report.SimplexPivots = solution.SimplexPivots;
+	Report.Objective = solution.Objective;
+
+	for (PivotStatistics& Pivot : solution.Pivots) {
+		Report.PivotMethods.push_back(Pivot.IsArtificialStep ? 1 : 2);
+		Report.PivotSteps.push_back(Pivot.StepID);
+		Report.PivotEntering.push_back(Pivot.EnteringVariable);
+		Report.PivotLeaving.push_back(Pivot.LeavingVariable);
+		Report.PivotObjectives.push_back(Pivot.Objective);
+		Report.PivotNanoseconds.push_back(Pivot.Nanoseconds);
+	}
+
+	if (solution.State != COMPLETED) {
+		return;
+	}
+	int NumberOfVariables = problem.NumberOfVariables;
+	Report.Primal = solution.X;
+	Report.BasisStatuses.assign(NumberOfVariables, BASIS_AT_ZERO);
+	for (int Variable : solution.Basis) {
+		Report.BasisStatuses[Variable - 1] = BASIS_BASIC;
+	}
+	ComputeDuals(problem, solution.Basis, Report.Duals);
+
+	Report.ReducedCosts.assign(NumberOfVariables, 0.0);
+	for (int j = 0; j < NumberOfVariables; j++) {
+		if (Report.BasisStatuses[j] == BASIS_BASIC) {
+			continue;
+		}
+		double ReducedCost = TargetCoefficient(problem, j);
+		for (int i = 0; i < problem.NumberOfLimitations; i++) {
+			ReducedCost -= Report.Duals[i] * ProblemCoefficient(problem, i, j);
+		}
+		Report.ReducedCosts[j] = ReducedCost;
+	}
+
+	// Coefficients of a maximization problem are the ones of -f, duals and reduced costs are given for f
+	if (problem.IsMaximization) {
+		for (double& Dual : Report.Duals) {
+			Dual = -Dual;
+		}
+		for (double& ReducedCost : Report.ReducedCosts) {
+			ReducedCost = -ReducedCost;
+		}
+	}
+}
+
+static size_t ReportElementSize(uint32_t Type) {
+	return Type == REPORT_INT32 ? 4 : 8;
+}
+
+// Header and directory go in one write and every column in one more. Returns NULL on success and error message otherwise
+const char* WriteSolutionReport(const char* FileName, const SolutionReport& Report) {
+	struct ColumnData {
+		const char* Name;
+		uint32_t Type;
+		const void* Data;
+		size_t Count;
+	};
+	const ColumnData Columns[] = {
+		{ "primal", REPORT_FLOAT64, Report.Primal.data(), Report.Primal.size() },
+		{ "reduced_cost", REPORT_FLOAT64, Report.ReducedCosts.data(), Report.ReducedCosts.size() },
+		{ "basis_status", REPORT_INT32, Report.BasisStatuses.data(), Report.BasisStatuses.size() },
+		{ "dual", REPORT_FLOAT64, Report.Duals.data(), Report.Duals.size() },
+		{ "pivot_method", REPORT_INT32, Report.PivotMethods.data(), Report.PivotMethods.size() },
+		{ "pivot_step", REPORT_INT32, Report.PivotSteps.data(), Report.PivotSteps.size() },
+		{ "pivot_entering", REPORT_INT32, Report.PivotEntering.data(), Report.PivotEntering.size() },
+		{ "pivot_leaving", REPORT_INT32, Report.PivotLeaving.data(), Report.PivotLeaving.size() },
+		{ "pivot_objective", REPORT_FLOAT64, Report.PivotObjectives.data(), Report.PivotObjectives.size() },
+		{ "pivot_ns", REPORT_INT64, Report.PivotNanoseconds.data(), Report.PivotNanoseconds.size() },
+	};
+	const uint32_t ColumnCount = sizeof(Columns) / sizeof(Columns[0]);
+
+	ReportHeader Header = {};
+	memcpy(Header.Magic, "SPXR", 4);
+	Header.Version = ReportVersion;
+	Header.State = Report.State;
+	Header.ColumnCount = ColumnCount;
+	Header.NumberOfLimitations = Report.NumberOfLimitations;
+	Header.NumberOfVariables = Report.NumberOfVariables;
+	Header.ArtificialPivots = Report.ArtificialPivots;
+	Header.SimplexPivots = Report.SimplexPivots;
+	Header.Objective = Report.Objective;
+
+	std::vector<char> Head(sizeof(Header) + ColumnCount * sizeof(ReportColumn));
+	memcpy(Head.data(), &Header, sizeof(Header));
+	uint64_t Offset = Head.size();
+	for (uint32_t i = 0; i < ColumnCount; i++) {
+		ReportColumn Column = {};
+		strncpy(Column.Name, Columns[i].Name, sizeof(Column.Name) - 1);
+		Column.Type = Columns[i].Type;
+		Column.Count = Columns[i].Count;
+		Column.Offset = (Offset + 7) & ~(uint64_t)7;
+		memcpy(Head.data() + sizeof(Header) + i * sizeof(ReportColumn), &Column, sizeof(Column));
+		Offset = Column.Offset + Column.Count * ReportElementSize(Column.Type);
+	}
+
+	FILE* File = fopen(FileName, "wb");
+	if (!File) {
+		return "Can't open file";
+	}
+	bool IsFailed = fwrite(Head.data(), 1, Head.size(), File) != Head.size();
+	uint64_t Position = Head.size();
+	const char Padding[8] = {};
+	for (uint32_t i = 0; i < ColumnCount && !IsFailed; i++) {
+		size_t PaddingSize = (size_t)(((Position + 7) & ~(uint64_t)7) - Position);
+		size_t Size = Columns[i].Count * ReportElementSize(Columns[i].Type);
+		IsFailed = (PaddingSize != 0 && fwrite(Padding, 1, PaddingSize, File) != PaddingSize) || (Size != 0 && fwrite(Columns[i].Data, 1, Size, File) != Size);
+		Position += PaddingSize + Size;
+	}
+	IsFailed = fclose(File) != 0 || IsFailed;
+	return IsFailed ? "Can't write file" : NULL;
+}
+
+// Mapped report, columns are taken straight from the mapping
+struct ReportFile {
+	MappedFile File;
+	ReportHeader Header;
+	const ReportColumn* Columns = NULL;
+
+	// Returns NULL on success and error message otherwise
+	const char* Open(const char* FileName) {
+		if (const char* Error = File.Open(FileName)) {
+			return Error;
+		}
+		if (File.Size < sizeof(Header)) {
+			return "File isn't a report";
+		}
+		memcpy(&Header, File.Data, sizeof(Header));
+		if (memcmp(Header.Magic, "SPXR", 4) != 0) {
+			return "File isn't a report";
+		}
+		if (Header.Version != ReportVersion) {
+			return "Version of the report isn't supported";
+		}
+		if (Header.ColumnCount > (File.Size - sizeof(Header)) / sizeof(ReportColumn)) {
+			return "Report is truncated";
+		}
+		Columns = (const ReportColumn*)(File.Data + sizeof(Header));
+		for (uint32_t i = 0; i < Header.ColumnCount; i++) {
+			if (Columns[i].Type < REPORT_INT32 || Columns[i].Type > REPORT_FLOAT64) {
+				return "Type of a column isn't supported";
+			}
+			size_t ElementSize = ReportElementSize(Columns[i].Type);
+			if (Columns[i].Offset % 8 != 0 || Columns[i].Offset > File.Size || Columns[i].Count > (File.Size - Columns[i].Offset) / ElementSize) {
+				return "Report is truncated";
+			}
+		}
+		return NULL;
+	}
+
+	// Elements of a column or NULL if the report has no such column
+	const void* Column(const char* Name, uint32_t Type, size_t& Count) const {
+		for (uint32_t i = 0; i < Header.ColumnCount; i++) {
+			if (Columns[i].Type == Type && strncmp(Columns[i].Name, Name, sizeof(Columns[i].Name)) == 0) {
+				Count = Columns[i].Count;
+				return File.Data + Columns[i].Offset;
+			}
+		}
+		Count = 0;
+		return NULL;
+	}
+};
+
+// Writes a report as text, a line for every column. Returns NULL on success and error message otherwise
+const char* PrintSolutionReport(const char* FileName, FILE* Output) {
+	ReportFile Report;
+	if (const char* Error = Report.Open(FileName)) {
+		return Error;
+	}
+	const char* StateNames[] = { "undefined", "completed", "unlimited", "stopped", "no solution" };
+	ReportHeader& Header = Report.Header;
+	fprintf(Output, "state,%s\nlimitations,%d\nvariables,%d\nobjective,%.17g\nartificial_pivots,%d\nsimplex_pivots,%d\n",
+		Header.State < sizeof(StateNames) / sizeof(StateNames[0]) ? StateNames[Header.State] : "unknown",
+		Header.NumberOfLimitations, Header.NumberOfVariables, Header.Objective, Header.ArtificialPivots, Header.SimplexPivots);
+	for (uint32_t i = 0; i < Header.ColumnCount; i++) {
+		const ReportColumn& Column = Report.Columns[i];
+		const char* Data = Report.File.Data + Column.Offset;
+		fprintf(Output, "%.*s", (int)sizeof(Column.Name), Column.Name);
+		for (uint64_t k = 0; k < Column.Count; k++) {
+			if (Column.Type == REPORT_INT32) {
+				fprintf(Output, ",%d", ((const int32_t*)Data)[k]);
+			} else if (Column.Type == REPORT_INT64) {
+				fprintf(Output, ",%lld", (long long)((const int64_t*)Data)[k]);
+			} else {
+				fprintf(Output, ",%.17g", ((const double*)Data)[k]);
+			}
+		}
+		fprintf(Output, "\n");
+	}
+	return NULL;
+}
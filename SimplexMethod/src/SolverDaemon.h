@@ -0,0 +1,439 @@
+#pragma once
+
+// Long-lived solver listening on a Unix domain socket.
+// Every request and response is a frame: 4 bytes of magic, 4 bytes of little-endian payload length and payload.
+//   "SPXT" - problem in the text format of problem files with real numbers, configuration files give their own type
+//   "SPXF" - the same with fractions a/b
+//   "SPXB" - binary problem: int32 number of limitations, int32 number of variables, int32 fractional flag,
+//            then rows of limitations with vector B and target function with constant C.
+//            Each element is float32 or a pair of int32 (numerator, denominator)
+//   "SPXR" - response: text with solution state, objective value, pivots and timings, vector x on the second line
+// Accepting thread polls the listener and idle connections and queues connections that sent something.
+// Pool of threads is created once, every thread reads one request of a queued connection, solves it
+// and gives the connection back, keeping its problem and frame buffers between requests.
+// Connection that is silent for too long is closed, slow client gives up its thread after a receive timeout.
+// Fraction arithmetic isn't checked for overflow and may raise SIGFPE, so fractional problems are solved
+// in a forked process and a crash of the solver is only an error of its request
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+struct DaemonFrameHeader {
+	char Magic[4];
+	uint32_t Length;
+};
+
+static const uint32_t MAX_DAEMON_FRAME_LENGTH = 256u << 20;
+// Time to receive a request or to send a response, so a slow client doesn't keep a thread of the pool
+static const int DAEMON_TRANSFER_TIMEOUT_SECONDS = 5;
+// Time a connection may stay without requests
+static const int DAEMON_IDLE_TIMEOUT_SECONDS = 60;
+
+// Decodes "SPXB" payload into problem. Returns NULL on success and error message otherwise
+const char* DecodeBinaryProblem(const char* Payload, size_t Length, Problem& problem) {
+	int32_t Header[3];
+	if (Length < sizeof(Header)) {
+		return "Frame is too short";
+	}
+	memcpy(Header, Payload, sizeof(Header));
+
+	int NumberOfLimitations = Header[0];
+	int NumberOfVariables = Header[1];
+	bool IsFractionalCoefficients = Header[2] != 0;
+	if (NumberOfLimitations < 1 || NumberOfVariables < 1 || NumberOfLimitations > NumberOfVariables) {
+		return "Wrong dimensions of the problem";
+	}
+
+	// Dimensions come from the client, so they are checked against the frame limit before any other arithmetic
+	size_t ElementSize = IsFractionalCoefficients ? 2 * sizeof(int32_t) : sizeof(float);
+	int64_t Count = ((int64_t)NumberOfLimitations + 1) * ((int64_t)NumberOfVariables + 1);
+	if (Count > MAX_DAEMON_FRAME_LENGTH / ElementSize) {
+		return "Problem doesn't fit into a frame";
+	}
+	if (Length != sizeof(Header) + (size_t)Count * ElementSize) {
+		return "Frame length doesn't match dimensions of the problem";
+	}
+
+	problem.IsFractionalCoefficients = IsFractionalCoefficients;
+	if (problem.NumberOfLimitations != NumberOfLimitations || problem.NumberOfVariables != NumberOfVariables) {
+		problem.Resize(NumberOfLimitations, NumberOfVariables);
+	}
+
+	const char* Element = Payload + sizeof(Header);
+	for (int i = 0; i < NumberOfLimitations + 1; i++) {
+		for (int j = 0; j < NumberOfVariables + 1; j++, Element += ElementSize) {
+			if (IsFractionalCoefficients) {
+				Fraction Value;
+				memcpy(&Value.numerator, Element, sizeof(int32_t));
+				memcpy(&Value.denominator, Element + sizeof(int32_t), sizeof(int32_t));
+				if (Value.denominator == 0) {
+					return "Zero denominator";
+				}
+				// Last row is target function
+				if (i < NumberOfLimitations) {
+					problem.FracMatrix[i][j] = Value;
+				} else {
+					problem.FractionalTargetFunction[j] = Value;
+				}
+			} else {
+				float Value;
+				memcpy(&Value, Element, sizeof(float));
+				if (i < NumberOfLimitations) {
+					problem.RealMatrix[i][j] = Value;
+				} else {
+					problem.RealTargetFunction[j] = Value;
+				}
+			}
+		}
+	}
+
+	return NULL;
+}
+
+#ifndef _WIN32
+// Both fail after Deadline, every call waits no more than the timeout of the socket
+static bool ReadFull(int Socket, void* Buffer, size_t Size, std::chrono::steady_clock::time_point Deadline) {
+	char* Destination = (char*)Buffer;
+	while (Size > 0) {
+		if (std::chrono::steady_clock::now() > Deadline) {
+			return false;
+		}
+		ssize_t Received = recv(Socket, Destination, Size, 0);
+		if (Received <= 0) {
+			return false;
+		}
+		Destination += Received;
+		Size -= Received;
+	}
+	return true;
+}
+
+static bool WriteFull(int Socket, const void* Buffer, size_t Size, std::chrono::steady_clock::time_point Deadline) {
+	const char* Source = (const char*)Buffer;
+	while (Size > 0) {
+		if (std::chrono::steady_clock::now() > Deadline) {
+			return false;
+		}
+		ssize_t Sent = send(Socket, Source, Size, MSG_NOSIGNAL);
+		if (Sent <= 0) {
+			return false;
+		}
+		Source += Sent;
+		Size -= Sent;
+	}
+	return true;
+}
+
+static void FormatDaemonResponse(std::string& Response, const char* Error, Solution& solution, double ParseMicroseconds, double SolveMicroseconds) {
+	const char* StateNames[] = { "undefined", "completed", "unlimited", "stopped", "no_solution" };
+	char Line[256];
+
+	Response.clear();
+	if (Error) {
+		snprintf(Line, sizeof(Line), "error=%s\n", Error);
+		Response += Line;
+		return;
+	}
+
+	snprintf(Line, sizeof(Line), "state=%s objective=%.9g pivots=%d parse_us=%.1f solve_us=%.1f\nx=",
+		StateNames[solution.State], solution.Objective, solution.ArtificialPivots + solution.SimplexPivots, ParseMicroseconds, SolveMicroseconds);
+	Response += Line;
+	for (int i = 0; i < solution.X.size(); i++) {
+		snprintf(Line, sizeof(Line), i == 0 ? "%.9g" : " %.9g", solution.X[i]);
+		Response += Line;
+	}
+	Response += "\n";
+}
+
+// Solves the problem in a child process that sends the response back through a pipe
+static void SolveInChildProcess(std::string& Response, Problem& problem, double ParseMicroseconds) {
+	Solution solution;
+	int Pipe[2];
+	if (pipe(Pipe) != 0) {
+		FormatDaemonResponse(Response, "Can't start solver process", solution, ParseMicroseconds, 0.0);
+		return;
+	}
+
+	pid_t Pid = fork();
+	if (Pid < 0) {
+		close(Pipe[0]);
+		close(Pipe[1]);
+		FormatDaemonResponse(Response, "Can't start solver process", solution, ParseMicroseconds, 0.0);
+		return;
+	}
+	if (Pid == 0) {
+		close(Pipe[0]);
+		auto Start = std::chrono::steady_clock::now();
+		solution = SolveSeparable(problem);
+		FormatDaemonResponse(Response, NULL, solution, ParseMicroseconds, MillisecondsSince(Start) * 1000.0);
+		const char* Source = Response.data();
+		size_t Size = Response.size();
+		while (Size > 0) {
+			ssize_t Written = write(Pipe[1], Source, Size);
+			if (Written < 0 && errno == EINTR) {
+				continue;
+			}
+			if (Written <= 0) {
+				_exit(1);
+			}
+			Source += Written;
+			Size -= Written;
+		}
+		_exit(0);
+	}
+	close(Pipe[1]);
+
+	Response.clear();
+	char Buffer[4096];
+	for (;;) {
+		ssize_t Received = read(Pipe[0], Buffer, sizeof(Buffer));
+		if (Received < 0 && errno == EINTR) {
+			continue;
+		}
+		if (Received <= 0) {
+			break;
+		}
+		Response.append(Buffer, Received);
+	}
+	close(Pipe[0]);
+
+	int WaitStatus = 0;
+	while (waitpid(Pid, &WaitStatus, 0) < 0 && errno == EINTR) {
+	}
+	if (!WIFEXITED(WaitStatus) || WEXITSTATUS(WaitStatus) != 0) {
+		char Error[128];
+		snprintf(Error, sizeof(Error), "Solver crashed: %s", WIFSIGNALED(WaitStatus) ? strsignal(WTERMSIG(WaitStatus)) : "solver process failed");
+		FormatDaemonResponse(Response, Error, solution, ParseMicroseconds, 0.0);
+	}
+}
+
+// Reads one request and sends its response. Returns false if the connection has to be closed
+static bool ServeDaemonRequest(int Socket, Problem& problem, std::vector<char>& Payload, std::string& Response) {
+	auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(DAEMON_TRANSFER_TIMEOUT_SECONDS);
+	DaemonFrameHeader Header;
+	if (!ReadFull(Socket, &Header, sizeof(Header), Deadline) || Header.Length > MAX_DAEMON_FRAME_LENGTH) {
+		return false;
+	}
+	Payload.resize(Header.Length + 1);
+	if (!ReadFull(Socket, Payload.data(), Header.Length, Deadline)) {
+		return false;
+	}
+	Payload[Header.Length] = '\0';
+
+	auto Start = std::chrono::steady_clock::now();
+	const char* Error = NULL;
+	if (memcmp(Header.Magic, "SPXT", 4) == 0 || memcmp(Header.Magic, "SPXF", 4) == 0) {
+		ReadStatistics Statistics;
+		Error = ParseProblem(Payload.data(), Header.Length, Header.Magic[3] == 'F', problem, Statistics);
+	} else if (memcmp(Header.Magic, "SPXB", 4) == 0) {
+		Error = DecodeBinaryProblem(Payload.data(), Header.Length, problem);
+	} else {
+		Error = "Unknown frame";
+	}
+	double ParseMicroseconds = MillisecondsSince(Start) * 1000.0;
+
+	if (!Error && problem.IsFractionalCoefficients) {
+		SolveInChildProcess(Response, problem, ParseMicroseconds);
+	} else {
+		Solution solution;
+		Start = std::chrono::steady_clock::now();
+		if (!Error) {
+			solution = SolveSeparable(problem);
+		}
+		FormatDaemonResponse(Response, Error, solution, ParseMicroseconds, MillisecondsSince(Start) * 1000.0);
+	}
+	DaemonFrameHeader ResponseHeader = { { 'S', 'P', 'X', 'R' }, (uint32_t)Response.size() };
+	Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(DAEMON_TRANSFER_TIMEOUT_SECONDS);
+	return WriteFull(Socket, &ResponseHeader, sizeof(ResponseHeader), Deadline) && WriteFull(Socket, Response.data(), Response.size(), Deadline);
+}
+
+// Connections passed between the accepting thread and the pool
+struct DaemonQueue {
+	std::mutex Mutex;
+	std::condition_variable RequestAdded;
+	// Connections with a request to serve
+	std::deque<int> Requests;
+	// Served connections that go back to polling, the accepting thread is woken by a byte in WakePipe
+	std::deque<int> Served;
+	int WakePipe[2] = { -1, -1 };
+	bool IsStopping = false;
+};
+
+static void RunDaemonWorker(DaemonQueue& Queue) {
+	Problem problem;
+	std::vector<char> Payload;
+	std::string Response;
+	for (;;) {
+		int Socket;
+		{
+			std::unique_lock<std::mutex> Lock(Queue.Mutex);
+			Queue.RequestAdded.wait(Lock, [&Queue]() { return Queue.IsStopping || !Queue.Requests.empty(); });
+			if (Queue.IsStopping) {
+				return;
+			}
+			Socket = Queue.Requests.front();
+			Queue.Requests.pop_front();
+		}
+
+		if (!ServeDaemonRequest(Socket, problem, Payload, Response)) {
+			close(Socket);
+			continue;
+		}
+		{
+			std::lock_guard<std::mutex> Lock(Queue.Mutex);
+			Queue.Served.push_back(Socket);
+		}
+		char Byte = 0;
+		if (write(Queue.WakePipe[1], &Byte, 1) < 0) {
+			// Pipe is full, so the accepting thread is woken already
+		}
+	}
+}
+
+int RunDaemon(const char* SocketPath, int Threads) {
+	sockaddr_un Address = {};
+	Address.sun_family = AF_UNIX;
+	if (strlen(SocketPath) >= sizeof(Address.sun_path)) {
+		printf("Socket path is too long\n");
+		return 1;
+	}
+	strcpy(Address.sun_path, SocketPath);
+
+	int Listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (Listener < 0) {
+		perror("socket");
+		return 1;
+	}
+
+	unlink(SocketPath);
+	if (bind(Listener, (sockaddr*)&Address, sizeof(Address)) != 0 || listen(Listener, 64) != 0) {
+		perror("bind");
+		close(Listener);
+		return 1;
+	}
+
+	DaemonQueue Queue;
+	if (pipe(Queue.WakePipe) != 0) {
+		perror("pipe");
+		close(Listener);
+		return 1;
+	}
+	// Neither the pool nor the accepting thread waits for the pipe
+	fcntl(Queue.WakePipe[0], F_SETFL, O_NONBLOCK);
+	fcntl(Queue.WakePipe[1], F_SETFL, O_NONBLOCK);
+
+	printf("Listening on %s with %d threads\n", SocketPath, Threads);
+	fflush(stdout);
+
+	std::vector<std::thread> Pool;
+	for (int i = 0; i < Threads; i++) {
+		Pool.emplace_back([&Queue]() { RunDaemonWorker(Queue); });
+	}
+
+	// Connections waiting for a request and time of their last request
+	struct IdleConnection {
+		int Socket;
+		std::chrono::steady_clock::time_point LastActive;
+	};
+	std::vector<IdleConnection> Idle;
+	std::vector<pollfd> Polled;
+	timeval TransferTimeout = { DAEMON_TRANSFER_TIMEOUT_SECONDS, 0 };
+	for (;;) {
+		Polled.clear();
+		Polled.push_back({ Listener, POLLIN, 0 });
+		Polled.push_back({ Queue.WakePipe[0], POLLIN, 0 });
+		for (IdleConnection& Connection : Idle) {
+			Polled.push_back({ Connection.Socket, POLLIN, 0 });
+		}
+		if (poll(Polled.data(), Polled.size(), 1000) < 0) {
+			if (errno == EINTR) { continue; }
+			perror("poll");
+			break;
+		}
+		auto Now = std::chrono::steady_clock::now();
+
+		// Connections that sent something go to the pool, silent ones are closed after the idle timeout.
+		// Polled holds the connections in the order of Idle
+		std::vector<int> Requests;
+		int Kept = 0;
+		for (int i = 0; i < Idle.size(); i++) {
+			if (Polled[i + 2].revents != 0) {
+				Requests.push_back(Idle[i].Socket);
+			} else if (Now - Idle[i].LastActive > std::chrono::seconds(DAEMON_IDLE_TIMEOUT_SECONDS)) {
+				close(Idle[i].Socket);
+			} else {
+				Idle[Kept++] = Idle[i];
+			}
+		}
+		Idle.resize(Kept);
+
+		if (Polled[1].revents != 0) {
+			char Bytes[64];
+			if (read(Queue.WakePipe[0], Bytes, sizeof(Bytes)) < 0) {
+				// Nothing to drain, served connections are taken anyway
+			}
+			std::lock_guard<std::mutex> Lock(Queue.Mutex);
+			for (int Socket : Queue.Served) {
+				Idle.push_back({ Socket, Now });
+			}
+			Queue.Served.clear();
+		}
+
+		if (Polled[0].revents != 0) {
+			int Socket = accept(Listener, NULL, NULL);
+			if (Socket >= 0) {
+				setsockopt(Socket, SOL_SOCKET, SO_RCVTIMEO, &TransferTimeout, sizeof(TransferTimeout));
+				setsockopt(Socket, SOL_SOCKET, SO_SNDTIMEO, &TransferTimeout, sizeof(TransferTimeout));
+				Idle.push_back({ Socket, Now });
+			} else if (errno != EINTR && errno != ECONNABORTED) {
+				perror("accept");
+				break;
+			}
+		}
+
+		if (!Requests.empty()) {
+			{
+				std::lock_guard<std::mutex> Lock(Queue.Mutex);
+				Queue.Requests.insert(Queue.Requests.end(), Requests.begin(), Requests.end());
+			}
+			Queue.RequestAdded.notify_all();
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> Lock(Queue.Mutex);
+		Queue.IsStopping = true;
+	}
+	Queue.RequestAdded.notify_all();
+	for (std::thread& Thread : Pool) {
+		Thread.join();
+	}
+
+	for (IdleConnection& Connection : Idle) {
+		close(Connection.Socket);
+	}
+	for (int Socket : Queue.Requests) {
+		close(Socket);
+	}
+	for (int Socket : Queue.Served) {
+		close(Socket);
+	}
+	close(Queue.WakePipe[0]);
+	close(Queue.WakePipe[1]);
+	close(Listener);
+	unlink(SocketPath);
+	return 0;
+}
+#else
+int RunDaemon(const char* SocketPath, int Threads) {
+	printf("Solver daemon is not supported on Windows\n");
+	return 1;
+}
+#endif
@@ -0,0 +1,221 @@
+#pragma once
+
+// Speculative pivots for step by step mode.
+// While user chooses lead element, the next step is calculated for every potential lead on idle cores.
+// Results are kept by basis of the step while the steps stay the same, so a lead that the user looks at again
+// takes its step from the cache as well.
+// Tasks run on a pool of threads that lives as long as the cache. The interface never waits for a task
+// it doesn't need: forgotten tasks are taken out of the queue and results of tasks that are already running
+// are thrown away when they are done
+
+struct SpeculativePivots {
+	// Phase, lead row and column and then numbers of variables of the step.
+	// Basis doesn't tell what the table holds, so the cache is cleared every time steps are changed
+	typedef std::vector<int> Key;
+
+	static const int MaxCachedSteps = 64;
+
+	struct Entry {
+		bool IsStarted = false;
+		bool IsReady = false;
+		Step Result;
+	};
+
+	struct Task {
+		Key TaskKey;
+		// Tasks of the cache before Clear() don't give their results
+		unsigned Generation;
+		std::function<Step()> Calculate;
+	};
+
+	std::mutex Mutex;
+	std::condition_variable TaskAdded;
+	std::condition_variable TaskDone;
+	std::map<Key, Entry> Cache;
+	std::deque<Key> InsertionOrder;
+	std::deque<Task> Tasks;
+	std::vector<std::thread> Workers;
+	unsigned Generation = 0;
+	bool IsStopping = false;
+
+	~SpeculativePivots() {
+		{
+			std::lock_guard<std::mutex> Lock(Mutex);
+			IsStopping = true;
+			Tasks.clear();
+		}
+		TaskAdded.notify_all();
+		for (std::thread& Worker : Workers) {
+			Worker.join();
+		}
+	}
+
+	static Key MakeKey(const Step& step, RowAndColumn Lead) {
+		Key key;
+		key.reserve(step.NumbersOfVariables.size() + 3);
+		key.push_back(step.IsArtificialStep);
+		key.push_back(Lead.Row);
+		key.push_back(Lead.Column);
+		key.insert(key.end(), step.NumbersOfVariables.begin(), step.NumbersOfVariables.end());
+		return key;
+	}
+
+	static int MaxTasksInFlight() {
+		return std::max(1, (int)std::thread::hardware_concurrency() - 1);
+	}
+
+	void RunWorker() {
+		// Steps that the user may never choose don't go to the performance panel
+		SolverProfile::IsSkipped = true;
+		std::unique_lock<std::mutex> Lock(Mutex);
+		for (;;) {
+			TaskAdded.wait(Lock, [this]() { return IsStopping || !Tasks.empty(); });
+			if (IsStopping) {
+				return;
+			}
+			Task Current = std::move(Tasks.front());
+			Tasks.pop_front();
+			auto Found = Cache.find(Current.TaskKey);
+			if (Found == Cache.end() || Current.Generation != Generation) {
+				continue;
+			}
+			Found->second.IsStarted = true;
+
+			Lock.unlock();
+			Step Result = Current.Calculate();
+			Lock.lock();
+
+			// Step could be forgotten while it was calculated
+			Found = Cache.find(Current.TaskKey);
+			if (Found != Cache.end() && Current.Generation == Generation) {
+				Found->second.Result = std::move(Result);
+				Found->second.IsReady = true;
+			}
+			TaskDone.notify_all();
+		}
+	}
+
+	// Takes a step out of the cache together with its task if it hasn't started yet. Mutex is locked
+	void Forget(const Key& key) {
+		Cache.erase(key);
+		for (auto Current = Tasks.begin(); Current != Tasks.end(); ++Current) {
+			if (Current->TaskKey == key) {
+				Tasks.erase(Current);
+				break;
+			}
+		}
+		auto Position = std::find(InsertionOrder.begin(), InsertionOrder.end(), key);
+		if (Position != InsertionOrder.end()) {
+			InsertionOrder.erase(Position);
+		}
+	}
+
+	// Queues calculation of the next step for leads that are not in the cache yet, chosen lead goes first.
+	// Called every frame, only keys are looked up when everything is queued.
+	// Leads past the size of the cache aren't queued, otherwise they would push out the first ones every frame
+	template<typename MatrixType, typename ElementType> void Prefetch(const Step& step, const std::vector<RowAndColumn>& Leads, RowAndColumn ChosenLead, int OriginalColNumber) {
+		std::vector<RowAndColumn> Order(Leads.begin(), Leads.begin() + std::min((int)Leads.size(), MaxCachedSteps - 1));
+		for (int i = 0; i < Leads.size(); i++) {
+			if (Leads[i].Row == ChosenLead.Row && Leads[i].Column == ChosenLead.Column) {
+				Order.insert(Order.begin(), Leads[i]);
+				break;
+			}
+		}
+
+		std::lock_guard<std::mutex> Lock(Mutex);
+		while (Workers.size() < MaxTasksInFlight()) {
+			Workers.emplace_back([this]() { RunWorker(); });
+		}
+
+		int AddedTasks = 0;
+		for (int i = 0; i < Order.size(); i++) {
+			Key key = MakeKey(step, Order[i]);
+			auto Found = Cache.find(key);
+			if (Found != Cache.end()) {
+				// Chosen lead that is still waiting goes to the front of the queue
+				if (i == 0 && !Found->second.IsStarted && Tasks.size() > 1 && Tasks.front().TaskKey != key) {
+					for (auto Current = Tasks.begin(); Current != Tasks.end(); ++Current) {
+						if (Current->TaskKey == key) {
+							Task Chosen = std::move(*Current);
+							Tasks.erase(Current);
+							Tasks.push_front(std::move(Chosen));
+							break;
+						}
+					}
+				}
+				continue;
+			}
+
+			Step Candidate = step;
+			Candidate.IsWaitingForInput = false;
+			Candidate.LeadElementRC = Order[i];
+			Cache[key] = Entry();
+			Tasks.push_back({ key, Generation, [Candidate, OriginalColNumber]() {
+				Step NewStep = SimplexStep<MatrixType, ElementType>(Candidate);
+				if (NewStep.IsCompleted) {
+					// Nothing to cache, caller finishes the solution itself
+					return NewStep;
+				}
+
+				if (NewStep.IsArtificialStep) {
+					CompleteArtificialStep<MatrixType>(NewStep, OriginalColNumber);
+				} else {
+					CompleteSimplexStep<MatrixType>(NewStep);
+				}
+				return NewStep;
+			} });
+			InsertionOrder.push_back(key);
+			AddedTasks += 1;
+		}
+
+		// Forget the oldest steps
+		while (InsertionOrder.size() > MaxCachedSteps) {
+			Forget(InsertionOrder.front());
+		}
+		if (AddedTasks > 0) {
+			TaskAdded.notify_all();
+		}
+	}
+
+	// Takes next step for the lead chosen in step. Waits only if it's being calculated already.
+	// Returns false if the step wasn't prefetched, hasn't started yet or the solution is completed
+	bool Take(const Step& step, Step& NewStep) {
+		Key key = MakeKey(step, step.LeadElementRC);
+		std::unique_lock<std::mutex> Lock(Mutex);
+		auto Found = Cache.find(key);
+		if (Found == Cache.end()) {
+			return false;
+		}
+		if (!Found->second.IsStarted) {
+			// Caller calculates it sooner than the queue
+			Forget(key);
+			return false;
+		}
+
+		unsigned TakenGeneration = Generation;
+		TaskDone.wait(Lock, [&]() {
+			Found = Cache.find(key);
+			return Generation != TakenGeneration || Found == Cache.end() || Found->second.IsReady;
+		});
+		if (Generation != TakenGeneration || Found == Cache.end()) {
+			return false;
+		}
+
+		const Step& Result = Found->second.Result;
+		if (Result.StepID == step.StepID) {
+			return false;
+		}
+
+		NewStep = Result;
+		return true;
+	}
+
+	// Forgets all steps without waiting for tasks that are running
+	void Clear() {
+		std::lock_guard<std::mutex> Lock(Mutex);
+		Generation += 1;
+		Tasks.clear();
+		Cache.clear();
+		InsertionOrder.clear();
+	}
+};
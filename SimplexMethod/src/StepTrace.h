@@ -0,0 +1,299 @@
+#pragma once
+
+// Trace of an automatic solution streamed to a file while it is solved.
+// Every pivot adds a short record, the whole table is written only for the first step of a method and
+// for every TableInterval-th step, so a solution of any length takes the same memory.
+// Any step is made again from the nearest table before it by repeating the recorded pivots.
+//
+// File is a header and records. Numbers are little-endian, as in snapshots.
+// Record is a kind and
+//   TRACE_PIVOT: PivotRecord
+//   TRACE_TABLE: step, written the same way as in snapshots
+// File of a solution that has been interrupted ends with whole records up to the last flush
+
+const uint32_t TraceVersion = 1;
+
+enum TraceFlag {
+	TRACE_FRACTIONS = 1,
+};
+
+enum TraceRecordKind {
+	TRACE_PIVOT = 1,
+	TRACE_TABLE = 2,
+};
+
+struct TraceHeader {
+	char Magic[4];
+	uint32_t Version;
+	uint32_t Flags;
+	int32_t TableInterval;
+	int32_t NumberOfLimitations;
+	int32_t NumberOfVariables;
+};
+
+struct PivotRecord {
+	int32_t StepID;
+	int32_t IsArtificialStep;
+	int32_t EnteringVariable;
+	int32_t LeavingVariable;
+	// Lead element in the table before the pivot
+	int32_t Row;
+	int32_t Column;
+	double LeadElement;
+	double Objective;
+	int64_t Nanoseconds;
+};
+
+static_assert(sizeof(TraceHeader) == 24, "Header of trace has no padding");
+static_assert(sizeof(PivotRecord) == 48, "Pivot of trace has no padding");
+
+struct StepTrace {
+	FILE* File = NULL;
+	SnapshotWriter Writer{ NULL };
+	bool IsFractionalCoefficients = false;
+	int TableInterval = 0;
+
+	~StepTrace() {
+		Close();
+	}
+
+	bool IsOpen() {
+		return File != NULL;
+	}
+
+	// Returns NULL on success and error message otherwise. TableInterval 0 writes only the first tables of the methods
+	const char* Open(const char* FileName, int NumberOfLimitations, int NumberOfVariables, bool IsFractional, int Interval) {
+		Close();
+		File = fopen(FileName, "wb");
+		if (!File) {
+			return "Can't open file";
+		}
+		IsFractionalCoefficients = IsFractional;
+		TableInterval = std::max(0, Interval);
+		Writer = SnapshotWriter(File);
+
+		TraceHeader Header = {};
+		memcpy(Header.Magic, "SPXT", 4);
+		Header.Version = TraceVersion;
+		Header.Flags = IsFractionalCoefficients ? TRACE_FRACTIONS : 0;
+		Header.TableInterval = TableInterval;
+		Header.NumberOfLimitations = NumberOfLimitations;
+		Header.NumberOfVariables = NumberOfVariables;
+		Writer.Append(&Header, sizeof(Header));
+		return NULL;
+	}
+
+	// Returns NULL on success and error message otherwise
+	const char* Close() {
+		if (!File) {
+			return NULL;
+		}
+		Writer.Flush();
+		bool IsFailed = fclose(File) != 0 || Writer.IsFailed;
+		File = NULL;
+		return IsFailed ? "Can't write file" : NULL;
+	}
+
+	// Records are kept in the buffer until it is full, so a finished solution has to be flushed to be seen in the file
+	void Flush() {
+		if (File) {
+			Writer.Flush();
+			fflush(File);
+		}
+	}
+
+	void AddTable(Step& step) {
+		Writer.Int(TRACE_TABLE);
+		Writer.WriteStep(step, IsFractionalCoefficients);
+	}
+
+	// NewStep is made by a pivot of OldStep and has its variables rearranged
+	void AddPivot(Step& OldStep, Step& NewStep, long long Nanoseconds) {
+		PivotRecord Pivot;
+		int Row = NewStep.StepChosenRC.Row;
+		int Column = NewStep.StepChosenRC.Column;
+		Pivot.StepID = NewStep.StepID;
+		Pivot.IsArtificialStep = NewStep.IsArtificialStep;
+		Pivot.EnteringVariable = NewStep.NumbersOfVariables[Row];
+		Pivot.LeavingVariable = OldStep.NumbersOfVariables[Row];
+		Pivot.Row = Row;
+		Pivot.Column = Column;
+		if (IsFractionalCoefficients) {
+			FractionalMatrix& matrix = NewStep.FracMatrix;
+			Pivot.LeadElement = ToDouble(OldStep.FracMatrix[Row][Column]);
+			Pivot.Objective = -ToDouble(matrix[matrix.RowNumber - 1][matrix.ColNumber - 1]);
+		} else {
+			Matrix& matrix = NewStep.RealMatrix;
+			Pivot.LeadElement = ToDouble(OldStep.RealMatrix[Row][Column]);
+			Pivot.Objective = -ToDouble(matrix[matrix.RowNumber - 1][matrix.ColNumber - 1]);
+		}
+		Pivot.Nanoseconds = Nanoseconds;
+		Writer.Int(TRACE_PIVOT);
+		Writer.Append(&Pivot, sizeof(Pivot));
+
+		if (TableInterval != 0 && NewStep.StepID % TableInterval == 0) {
+			AddTable(NewStep);
+		}
+	}
+};
+
+// Solver doesn't know about files, it calls these when it has a trace
+void TraceTable(StepTrace* Trace, Step& step) {
+	Trace->AddTable(step);
+}
+
+void TracePivot(StepTrace* Trace, Step& OldStep, Step& NewStep, long long Nanoseconds) {
+	Trace->AddPivot(OldStep, NewStep, Nanoseconds);
+}
+
+// Mapped trace that is read record by record
+struct TraceFile {
+	MappedFile File;
+	TraceHeader Header;
+	bool IsFractionalCoefficients = false;
+
+	// Returns NULL on success and error message otherwise
+	const char* Open(const char* FileName) {
+		if (const char* Error = File.Open(FileName)) {
+			return Error;
+		}
+		if (File.Size < sizeof(Header)) {
+			return "File isn't a trace";
+		}
+		memcpy(&Header, File.Data, sizeof(Header));
+		if (memcmp(Header.Magic, "SPXT", 4) != 0) {
+			return "File isn't a trace";
+		}
+		if (Header.Version != TraceVersion) {
+			return "Version of the trace isn't supported";
+		}
+		// Problem whose rows are all "0 = 0" is traced without rows
+		if (Header.NumberOfLimitations < 0 || Header.NumberOfVariables < 1) {
+			return "Wrong dimensions of the problem";
+		}
+		IsFractionalCoefficients = (Header.Flags & TRACE_FRACTIONS) != 0;
+		return NULL;
+	}
+
+	SnapshotReader Records() {
+		return SnapshotReader(File.Data + sizeof(Header), File.Size - sizeof(Header));
+	}
+
+	// Reads kind of the next record and the record if it's a pivot, tables are read by the caller.
+	// Returns false at the end of the trace, Reader.IsFailed tells that the last record is cut off
+	bool Next(SnapshotReader& Reader, int32_t& Kind, PivotRecord& Pivot) {
+		if (Reader.Position == Reader.End) {
+			return false;
+		}
+		Kind = Reader.Int();
+		if (Kind == TRACE_PIVOT) {
+			Reader.Read(&Pivot, sizeof(Pivot));
+		} else if (Kind != TRACE_TABLE) {
+			Reader.IsFailed = true;
+		}
+		return !Reader.IsFailed;
+	}
+
+	void SkipTable(SnapshotReader& Reader) {
+		Step step;
+		Reader.ReadStep(step, IsFractionalCoefficients, Header.NumberOfLimitations, Header.NumberOfVariables);
+	}
+};
+
+// Writes pivots of a trace as CSV. Returns NULL on success and error message otherwise
+const char* PrintTrace(const char* FileName, FILE* Output) {
+	TraceFile Trace;
+	if (const char* Error = Trace.Open(FileName)) {
+		return Error;
+	}
+
+	fprintf(Output, "method,step,entering,leaving,row,column,lead,objective,ns\n");
+	SnapshotReader Reader = Trace.Records();
+	int32_t Kind;
+	PivotRecord Pivot;
+	while (Trace.Next(Reader, Kind, Pivot)) {
+		if (Kind == TRACE_TABLE) {
+			Trace.SkipTable(Reader);
+			continue;
+		}
+		fprintf(Output, "%s,%d,%d,%d,%d,%d,%.9g,%.9g,%lld\n", Pivot.IsArtificialStep ? "artificial" : "simplex", Pivot.StepID,
+			Pivot.EnteringVariable, Pivot.LeavingVariable, Pivot.Row, Pivot.Column, Pivot.LeadElement, Pivot.Objective, (long long)Pivot.Nanoseconds);
+	}
+	return Reader.IsFailed ? "Trace is truncated" : NULL;
+}
+
+// Lead element of a pivot has to be inside of the table and the table has to be the one the pivot was made on
+template<typename MatrixType, typename ElementType> bool RepeatPivot(Step& step, PivotRecord& Pivot, int OriginalColNumber) {
+	MatrixType& matrix = StepMatrix<MatrixType>(step);
+	if (Pivot.Row < 0 || Pivot.Row >= matrix.RowNumber - 1 || Pivot.Column < 0 || Pivot.Column >= matrix.ColNumber - 1
+		|| step.NumbersOfVariables.size() != matrix.RowNumber + matrix.ColNumber - 2 || step.NumbersOfVariables[Pivot.Row] != Pivot.LeavingVariable) {
+		return false;
+	}
+	step.IsAutomatic = false;
+	step.LeadElementRC.Row = Pivot.Row;
+	step.LeadElementRC.Column = Pivot.Column;
+	Step NewStep = SimplexStep<MatrixType, ElementType>(step);
+	if (NewStep.IsCompleted) {
+		return false;
+	}
+	if (step.IsArtificialStep) {
+		CompleteArtificialStep<MatrixType>(NewStep, OriginalColNumber);
+	} else {
+		CompleteSimplexStep<MatrixType>(NewStep);
+	}
+	step = NewStep;
+	return step.NumbersOfVariables[Pivot.Row] == Pivot.EnteringVariable;
+}
+
+// Makes step StepID of a method again from the last table of the method before it.
+// If a method has been run more than once the last run is taken. Returns NULL on success and error message otherwise
+const char* ReplayTrace(const char* FileName, bool IsArtificialStep, int StepID, Step& Result, bool& IsFractionalCoefficients) {
+	TraceFile Trace;
+	if (const char* Error = Trace.Open(FileName)) {
+		return Error;
+	}
+	IsFractionalCoefficients = Trace.IsFractionalCoefficients;
+
+	// Table to start from
+	SnapshotReader Reader = Trace.Records();
+	const char* TablePosition = NULL;
+	int32_t Kind;
+	PivotRecord Pivot;
+	while (Trace.Next(Reader, Kind, Pivot)) {
+		if (Kind == TRACE_TABLE) {
+			const char* Position = Reader.Position;
+			Step step;
+			Reader.ReadStep(step, IsFractionalCoefficients, Trace.Header.NumberOfLimitations, Trace.Header.NumberOfVariables);
+			if (!Reader.IsFailed && step.IsArtificialStep == IsArtificialStep && step.StepID <= StepID) {
+				TablePosition = Position;
+			}
+		}
+	}
+	if (!TablePosition) {
+		return "Trace has no table before the step";
+	}
+
+	Reader.Position = TablePosition;
+	Reader.IsFailed = false;
+	Reader.ReadStep(Result, IsFractionalCoefficients, Trace.Header.NumberOfLimitations, Trace.Header.NumberOfVariables);
+	int OriginalColNumber = Trace.Header.NumberOfVariables + 1;
+	while (Result.StepID != StepID && Trace.Next(Reader, Kind, Pivot)) {
+		if (Kind == TRACE_TABLE) {
+			Trace.SkipTable(Reader);
+			continue;
+		}
+		if ((bool)Pivot.IsArtificialStep != IsArtificialStep) {
+			continue;
+		}
+		// Next run of the method starts with its own table and can't continue this one
+		if (Pivot.StepID != Result.StepID + 1) {
+			break;
+		}
+		bool IsRepeated = IsFractionalCoefficients ? RepeatPivot<FractionalMatrix, Fraction>(Result, Pivot, OriginalColNumber)
+			: RepeatPivot<Matrix, float>(Result, Pivot, OriginalColNumber);
+		if (!IsRepeated) {
+			return "Trace doesn't match its tables";
+		}
+	}
+	return Result.StepID == StepID ? NULL : "Trace has no such step";
+}
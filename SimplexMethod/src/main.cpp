@@ -13,415 +13,111 @@
 #include <string>
 #include <type_traits>
 #include <algorithm>
-#include <regex>
-
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <new>
+#include <thread>
+#include <future>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstdint>
+#include <cerrno>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+
+#ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include "windows.h" // For GetModuleFilename
+#endif
 #include "tinyfiledialogs.h"
 #include "Common.h"
+#include "Profiler.h"
+#include "Simplex.h"
+#include "Decomposition.h"
+#include "NumberParser.h"
+#include "MpsFile.h"
+#include "LpFile.h"
+#include "ProblemFile.h"
+#include "CsvFile.h"
+#include "Snapshot.h"
+#include "StepTrace.h"
+#include "BasisFile.h"
+#include "SolutionReport.h"
+#include "BatchSolver.h"
+#include "SolverDaemon.h"
+#include "BackgroundSolver.h"
+#include "SpeculativePivots.h"
+#include "CommandLine.h"
+#include "Heatmap.h"
 #include "GUILayer.h"
 
 std::vector<Step> ArtificialBasisSteps;
 std::vector<Step> SimplexAlgorithmSteps;
 std::vector<Step> ExplicitBasisSteps;
-
-AlgorithmState CheckAlgorithmState(Matrix& matrix, bool IsAutomatic, bool IsArtificialStep) {
-	AlgorithmState state = UNDEFINED;
-
-	for (int i = 0; i < matrix.ColNumber - 1; i++) {
-		if (matrix[matrix.RowNumber - 1][i] < -EPSILON) {
-			state = UNDEFINED;
-			// Check if there is at least one positive element in a column
-			for (int j = 0; j < matrix.RowNumber - 1; j++) {
-				if (matrix[j][i] > EPSILON) {
-					state = CONTINUE;
-					break;
-				}
-			}
-			if (state == UNDEFINED) {
-				state = UNLIMITED_SOLUTION;
-				break;
-			}
-		}
-	}
-
-	if (state == UNDEFINED) {
-		state = COMPLETED;
-
-		// Check if system of equalities have solutions
-		if (IsArtificialStep) {
-			if (matrix[matrix.RowNumber - 1][matrix.ColNumber - 1] < -EPSILON) {
-				state = SOLUTION_DOESNT_EXIST;
-			}
-		}
-	}
-
-	// Check if rows are indepenedent
-	for (int i = 0; i < matrix.RowNumber - 1; i++) {
-		int ZeroElementsCount = 0;
-		for (int j = 0; j < matrix.ColNumber - 1; j++) {
-			// if element is zero
-			if (fabs(matrix[i][j]) < EPSILON) {
-				ZeroElementsCount++;
-			}
-		}
-		if (ZeroElementsCount == matrix.ColNumber - 1) {
-			state = SOLUTION_DOESNT_EXIST;
-			break;
-		}
-	}
-
-	assert(state != UNDEFINED);
-	return state;
-}
-
-AlgorithmState CheckAlgorithmState(FractionalMatrix& matrix, bool IsAutomatic, bool IsArtificialStep) {
-	AlgorithmState state = UNDEFINED;
-
-	for (int i = 0; i < matrix.ColNumber - 1; i++) {
-		// Last row contains negative numbers
-		if (matrix[matrix.RowNumber - 1][i] < 0) {
-			state = UNDEFINED;
-			// Check if there is at least one positive element in a column
-			for (int j = 0; j < matrix.RowNumber - 1; j++) {
-				if (matrix[j][i] > 0) {
-					state = CONTINUE;
-					break;
-				}
-			}
-			if (state == UNDEFINED) {
-				state = UNLIMITED_SOLUTION;
-				break;
-			}
-		}
-	}
-
-	if (state == UNDEFINED) {
-		state = COMPLETED;
-
-		// Check if system of equalities have solutions
-		if (IsArtificialStep) {
-			if (matrix[matrix.RowNumber - 1][matrix.ColNumber - 1] < -EPSILON) {
-				state = SOLUTION_DOESNT_EXIST;
-			}
-		}
-	}
-
-	// Check if rows are indepenedent
-	for (int i = 0; i < matrix.RowNumber - 1; i++) {
-		int ZeroElementsCount = 0;
-		for (int j = 0; j < matrix.ColNumber - 1; j++) {
-			// if element is zero
-			if (matrix[i][j] == Fraction(0, 1)) {
-				ZeroElementsCount++;
-			}
-		}
-		if (ZeroElementsCount == matrix.ColNumber - 1) {
-			state = SOLUTION_DOESNT_EXIST;
-			break;
-		}
-	}
-
-	assert(state != UNDEFINED);
-	return state;
-}
-
-template<typename MatrixType, typename ElementType> Step SimplexStep(Step step) {
-	int CurrentColumnIndex = -1;
-	int CurrentRowIndex = -1;
-	ElementType CurrentLead;
-
-	if (step.IsCompleted) {
-		return step;
-	}
-
-	// Choose matrix based on input
-	MatrixType matrix;
-	if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
-		// Real case
-		matrix = step.RealMatrix;
-	} else {
-		// Fractional case
-		matrix = step.FracMatrix;
-	}
-
-	// Define generic zero for both real and fractional cases
-	ElementType ZeroElement;
-	if constexpr (IS_SAME_TYPE(ElementType, float)) {
-		// Real case
-		ZeroElement = EPSILON;
-	} else {
-		// Fractional case
-		ZeroElement = Fraction(0, 1);
-	}
-
-	// Check what algorithm state is
-	AlgorithmState state = UNDEFINED;
-	state = CheckAlgorithmState(matrix, step.IsAutomatic, step.IsArtificialStep);
-	assert(state != UNDEFINED);
-
-	if (state == UNLIMITED_SOLUTION) {
-		step.IsCompleted = true;
-		return step;
-	} else if (state == COMPLETED) {
-		step.IsCompleted = true;
-		return step;
-	} else if (state == SOLUTION_DOESNT_EXIST) {
-		step.IsCompleted = true;
-		return step;
-	}
-
-	// Choose lead element
-	if (step.IsAutomatic) {
-		CurrentRowIndex = -1;
-		// Assigning appropriate values to these variables
-		ElementType ColumnMinimum;
-		if constexpr (IS_SAME_TYPE(ElementType, float)) {
-			// Real case
-			CurrentLead = FLT_MAX;
-			ColumnMinimum = FLT_MAX;
-		} else {
-			// Fractional case
-			CurrentLead = Fraction(INT32_MAX, 1);
-			ColumnMinimum = Fraction(INT32_MAX, 1);
-		}
-
-		// Find number of column of an available element
-		for (int i = 0; i < matrix.RowNumber - 1; i++) {
-			for (int j = 0; j < matrix.ColNumber - 1; j++) {
-				if (matrix[matrix.RowNumber - 1][j] < -ZeroElement) {
-					if (matrix[i][j] > ZeroElement) {
-						CurrentColumnIndex = j;
-						break;
-					}
-				}
-			}
-		}
-
-		// Choose any available lead element
-		for (int i = 0; i < matrix.RowNumber - 1; i++) {
-			if (matrix[i][CurrentColumnIndex] > ZeroElement) {
-				if (matrix[i][matrix.ColNumber - 1] / matrix[i][CurrentColumnIndex] < ColumnMinimum) {
-					CurrentLead = matrix[i][CurrentColumnIndex];
-					ColumnMinimum = matrix[i][matrix.ColNumber - 1] / matrix[i][CurrentColumnIndex];
-					CurrentRowIndex = i;
-				}
-			}
-		}
-	} else {
-		CurrentColumnIndex = step.LeadElementRC.Column;
-		CurrentRowIndex = step.LeadElementRC.Row;
-
-		// Assignment of lead element
-		CurrentLead = matrix[step.LeadElementRC.Row][step.LeadElementRC.Column];
-	}
-
-	assert(CurrentRowIndex != -1);
-	assert(CurrentColumnIndex != -1);
-	if constexpr (IS_SAME_TYPE(MatrixType, FractionalMatrix)) {
-		assert(CurrentLead.numerator != -1);
-	} else {
-		assert(CurrentLead != -1);
-	}
-
-	// Lead element is equal to 1 / Lead
-	if constexpr (IS_SAME_TYPE(ElementType, float)) {
-		// Real case
-		matrix[CurrentRowIndex][CurrentColumnIndex] = 1 / CurrentLead;
-	} else {
-		// Fractional case
-		matrix[CurrentRowIndex][CurrentColumnIndex] = Fraction(1, 1) / CurrentLead;
-	}
-
-	// Divide Row by lead
-	for (int i = 0; i < matrix.ColNumber; i++) {
-		if (i == CurrentColumnIndex) { continue; }
-		matrix[CurrentRowIndex][i] = matrix[CurrentRowIndex][i] / CurrentLead;
-	}
-
-	// Divide Column by negative lead
-	for (int i = 0; i < matrix.RowNumber; i++) {
-		if (i == CurrentRowIndex) { continue; }
-		matrix[i][CurrentColumnIndex] = (matrix[i][CurrentColumnIndex] / (-CurrentLead));
-	}
-
-	// Subtract all other rows by lead row
-	for (int i = 0; i < matrix.RowNumber; i++) {
-		if (i == CurrentRowIndex) { continue; }
-		for (int j = 0; j < matrix.ColNumber; j++) {
-			if (j == CurrentColumnIndex) { continue; }
-			matrix[i][j] = matrix[i][j] - CurrentLead * matrix[i][CurrentColumnIndex] * matrix[CurrentRowIndex][j] * (-1);
-		}
-	}
-
-	// Assign new step matricies
-	Step NewStep = step;
-	if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
-		// Real case
-		NewStep.RealMatrix = matrix;
-		NewStep.FracMatrix = step.FracMatrix;
-	} else {
-		// Fractional case
-		NewStep.RealMatrix = step.RealMatrix;
-		NewStep.FracMatrix = matrix;
-	}
-	NewStep.StepID += 1;
-	NewStep.StepChosenRC.Row = CurrentRowIndex;
-	NewStep.StepChosenRC.Column = CurrentColumnIndex;
-	return NewStep;
-}
-
-void MakeArtificialFunctionCoefficients(Matrix& matrix) {
-	for (int i = 0; i < matrix.ColNumber; i++) {
-		float ColumnSum = 0.0f;
-		for (int j = 0; j < matrix.RowNumber - 1; j++) {
-			ColumnSum += matrix[j][i];
-		}
-		matrix[matrix.RowNumber - 1][i] = -ColumnSum;
-	}
-
-	// If last element in a row is less than zero multiply row by (-1)
-	int LastElementInARow = matrix.ColNumber - 1;
-	for (int i = 0; i < matrix.RowNumber - 1; i++) {
-		if (matrix[i][LastElementInARow] < -EPSILON) {
-			for (int j = 0; j < matrix.ColNumber; j++) {
-				matrix[i][j] = matrix[i][j] * (-1);
-			}
-		}
-	}
-}
-
-void MakeArtificialFunctionCeofficients(FractionalMatrix& matrix) {
-	for (int i = 0; i < matrix.ColNumber; i++) {
-		Fraction ColumnSum = Fraction(0, 1);
-		for (int j = 0; j < matrix.RowNumber - 1; j++) {
-			ColumnSum = ColumnSum + matrix[j][i];
-		}
-		matrix[matrix.RowNumber - 1][i] = -ColumnSum;
-	}
-
-	// If last element in a row is less than zero multiply row by (-1)
-	int LastElementInARow = matrix.ColNumber - 1;
-	for (int i = 0; i < matrix.RowNumber - 1; i++) {
-		if (matrix[i][LastElementInARow] < 0) {
-			for (int j = 0; j < matrix.ColNumber; j++) {
-				matrix[i][j] = matrix[i][j] * (-1);
-			}
-		}
-	}
-}
-
-void MakeSimplexAlgorithmFunctionCoefficients(Step& step, std::vector<float>& RealTargetFunction) {
-	Matrix TargetFunctionCoefficientsMatrix(step.RealMatrix);
-
-	// Copy table one to one multiplying basis rows on coefficients of target function
-	for (int i = 0; i < step.RealMatrix.RowNumber - 1; i++) {
-		for (int j = 0; j < step.RealMatrix.ColNumber; j++) {
-			if (j < step.RealMatrix.ColNumber - 1) {
-				TargetFunctionCoefficientsMatrix[i][j] = (-1) * RealTargetFunction[step.NumbersOfVariables[i] - 1] * step.RealMatrix[i][j];
-			} else {
-				TargetFunctionCoefficientsMatrix[i][j] = RealTargetFunction[step.NumbersOfVariables[i] - 1] * step.RealMatrix[i][j];
-			}
-		}
-	}
-
-	// Fill new target function coefficients
-	for (int i = 0; i < TargetFunctionCoefficientsMatrix.ColNumber - 1; i++) {
-		float ColumnSum = 0.0f;
-		for (int j = 0; j < TargetFunctionCoefficientsMatrix.RowNumber - 1; j++) {
-			ColumnSum += TargetFunctionCoefficientsMatrix[j][i];
-		}
-		ColumnSum += RealTargetFunction[step.NumbersOfVariables[i + step.RealMatrix.RowNumber - 1] - 1];
-		step.RealMatrix[step.RealMatrix.RowNumber - 1][i] = ColumnSum;
+// Steps of automatic solution whose tables aren't kept
+StepSummaries ArtificialBasisSummaries;
+StepSummaries SimplexAlgorithmSummaries;
+
+// First and last steps go to the snapshot, steps between them are summarized in its journal
+static void TakeSnapshotSteps(std::vector<Step>& Steps, int StartIndex, StepSummaries& Summaries, bool IsFractionalCoefficients,
+	std::vector<Step>& SnapshotSteps, StepSummaries& Journal) {
+	if (Steps.size() <= StartIndex) {
+		return;
 	}
-
-	// Free coefficient
-	float ColumnSum = 0.0f;
-	for (int i = 0; i < TargetFunctionCoefficientsMatrix.RowNumber - 1; i++) {
-		ColumnSum += TargetFunctionCoefficientsMatrix[i][TargetFunctionCoefficientsMatrix.ColNumber - 1];
+	Journal = Summaries;
+	GUILayer::ForgetStaleSummaries(Steps, StartIndex, Journal);
+	GUILayer::SummarizeSteps(Steps, StartIndex, Steps.size() - 1, Journal, IsFractionalCoefficients);
+	SnapshotSteps.push_back(Steps[StartIndex]);
+	if (Steps.size() > StartIndex + 1) {
+		SnapshotSteps.push_back(Steps.back());
 	}
-	ColumnSum += RealTargetFunction[RealTargetFunction.size() - 1];
-	step.RealMatrix[step.RealMatrix.RowNumber - 1][step.RealMatrix.ColNumber - 1] = -ColumnSum;
 }
 
-template<typename MatrixType, typename ElementType> void MakeSimplexAlgorithmFunctionCoefficients(MatrixType& matrix, std::vector<int> NumbersOfVariables, std::vector<ElementType>& TargetFunction) {
-	MatrixType TargetFunctionCoefficientsMatrix(matrix);
-
-	// Type-independent zero element
-	// Float is [-EPSILON, +EPSILON], Fraction is 0/1
-	ElementType ZeroElement;
-	if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
-		ZeroElement = EPSILON;
-	} else {
-		ZeroElement = Fraction(0, 1);
-	}
-
-	// Copy table one to one multiplying basis rows on coefficients of target function
-	for (int i = 0; i < matrix.RowNumber - 1; i++) {
-		for (int j = 0; j < matrix.ColNumber; j++) {
-			if (j < matrix.ColNumber - 1) {
-				TargetFunctionCoefficientsMatrix[i][j] = TargetFunction[NumbersOfVariables[i] - 1] * matrix[i][j] * (-1);
-			} else {
-				TargetFunctionCoefficientsMatrix[i][j] = TargetFunction[NumbersOfVariables[i] - 1] * matrix[i][j];
-			}
-		}
-	}
-
-	// Fill new target function coefficients
-	for (int i = 0; i < TargetFunctionCoefficientsMatrix.ColNumber - 1; i++) {
-		ElementType ColumnSum;
-		if constexpr (IS_SAME_TYPE(ElementType, float)) {
-			ColumnSum = 0.0f;
-		} else {
-			ColumnSum = Fraction(0, 1);
-		}
-		for (int j = 0; j < TargetFunctionCoefficientsMatrix.RowNumber - 1; j++) {
-			ColumnSum = ColumnSum + TargetFunctionCoefficientsMatrix[j][i];
-		}
-		ColumnSum = ColumnSum + TargetFunction[NumbersOfVariables[i + matrix.RowNumber - 1] - 1];
-		matrix[matrix.RowNumber - 1][i] = ColumnSum;
+// Pivots of steps and of their summaries go to the report of the solution, steps aren't timed
+static void TakeReportPivots(std::vector<Step>& Steps, int StartIndex, StepSummaries& Summaries, bool IsFractionalCoefficients, bool IsArtificialStep,
+	Solution& solution) {
+	if (Steps.size() <= StartIndex) {
+		return;
 	}
-
-	// Free coefficient
-	ElementType ColumnSum = ZeroElement;
-	for (int i = 0; i < TargetFunctionCoefficientsMatrix.RowNumber - 1; i++) {
-		ColumnSum = ColumnSum + TargetFunctionCoefficientsMatrix[i][TargetFunctionCoefficientsMatrix.ColNumber - 1];
+	StepSummaries Journal = Summaries;
+	GUILayer::ForgetStaleSummaries(Steps, StartIndex, Journal);
+	GUILayer::SummarizeSteps(Steps, StartIndex, Steps.size(), Journal, IsFractionalCoefficients);
+	for (StepSummary& Summary : Journal.Rows) {
+		PivotStatistics Pivot = { IsArtificialStep, Summary.StepID, Summary.EnteringVariable, Summary.LeavingVariable, Summary.Objective, 0 };
+		solution.Pivots.push_back(Pivot);
 	}
-	ColumnSum = ColumnSum + TargetFunction[TargetFunction.size() - 1];
-	matrix[matrix.RowNumber - 1][matrix.ColNumber - 1] = -ColumnSum;
+	(IsArtificialStep ? solution.ArtificialPivots : solution.SimplexPivots) += Journal.Rows.size();
 }
 
-void MakeSimplexAlgorithmFunctionCoefficients(Step& step, std::vector<Fraction>& FracTargetFunction) {
-	FractionalMatrix TargetFunctionCoefficientsMatrix(step.FracMatrix);
-
-	// Copy table one to one multiplying basis rows on coefficients of target function
-	for (int i = 0; i < step.FracMatrix.RowNumber - 1; i++) {
-		for (int j = 0; j < step.FracMatrix.ColNumber; j++) {
-			if (j < step.FracMatrix.ColNumber - 1) {
-				TargetFunctionCoefficientsMatrix[i][j] = FracTargetFunction[step.NumbersOfVariables[i] - 1] * step.FracMatrix[i][j] * (-1);
-			} else {
-				TargetFunctionCoefficientsMatrix[i][j] = FracTargetFunction[step.NumbersOfVariables[i] - 1] * step.FracMatrix[i][j];
-			}
-		}
+// Trace of automatic solution, workers write into it. It's declared before the workers, so it's closed after they stop
+StepTrace SolutionTrace;
+// Workers of automatic solution
+BackgroundSolver ArtificialBasisSolver;
+BackgroundSolver SimplexAlgorithmSolver;
+// Next steps of step by step mode calculated ahead
+SpeculativePivots SpeculativeSteps;
+
+// Simplex algorithm continues the trace of the artificial basis method that has been solved automatically,
+// otherwise the trace begins again. Returns NULL if the solution isn't traced
+static StepTrace* OpenSolutionTrace(bool IsContinued, int NumberOfLimitations, int NumberOfVariables, bool IsFractionalCoefficients) {
+	if (GUILayer::TraceFileName.empty()) {
+		return NULL;
 	}
-
-	// Fill new target function coefficients
-	for (int i = 0; i < TargetFunctionCoefficientsMatrix.ColNumber - 1; i++) {
-		Fraction ColumnSum = Fraction(0, 1);
-		for (int j = 0; j < TargetFunctionCoefficientsMatrix.RowNumber - 1; j++) {
-			ColumnSum += TargetFunctionCoefficientsMatrix[j][i];
-		}
-		ColumnSum += FracTargetFunction[step.NumbersOfVariables[i + step.FracMatrix.RowNumber - 1] - 1];
-		step.FracMatrix[step.FracMatrix.RowNumber - 1][i] = ColumnSum;
+	if (IsContinued && SolutionTrace.IsOpen()) {
+		return &SolutionTrace;
 	}
-
-	// Free coefficient
-	Fraction ColumnSum = Fraction(0, 1);
-	for (int i = 0; i < TargetFunctionCoefficientsMatrix.RowNumber - 1; i++) {
-		ColumnSum += TargetFunctionCoefficientsMatrix[i][TargetFunctionCoefficientsMatrix.ColNumber - 1];
+	if (SolutionTrace.Open(GUILayer::TraceFileName.c_str(), NumberOfLimitations, NumberOfVariables, IsFractionalCoefficients, GUILayer::TraceTableInterval) != NULL) {
+		GUILayer::TraceError = u8"     ";
+		GUILayer::TraceFileName.clear();
+		return NULL;
 	}
-	ColumnSum += FracTargetFunction[FracTargetFunction.size() - 1];
-	step.FracMatrix[step.FracMatrix.RowNumber - 1][step.FracMatrix.ColNumber - 1] = -ColumnSum;
+	return &SolutionTrace;
 }
 
 static int PreviousArtificialStepID = -1;
@@ -539,6 +235,8 @@ template<typename MatrixType, typename ElementType> void ArtificialBasis(Step st
 				PreviousArtificialStepID = step.StepID;
 			}
 
+			SpeculativeSteps.Prefetch<MatrixType, ElementType>(step, GUILayer::PotentialLeads, GUILayer::CurrentLeadPos, StepMatrix<MatrixType>(ArtificialBasisSteps[1]).ColNumber);
+
 			if (ImGui::Button(u8"")) {
 				assert(Column != -1);
 				step.IsWaitingForInput = false;
@@ -557,44 +255,16 @@ template<typename MatrixType, typename ElementType> void ArtificialBasis(Step st
 	if (!step.IsWaitingForInput) {
 		int RowNumber = matrix.RowNumber;
 		for (int iteration = 0; iteration < RowNumber; iteration++) {
-			// Calculate current step
-			Step NewStep = SimplexStep<MatrixType, ElementType>(step);
+			// Calculate current step unless it was calculated ahead
+			Step NewStep;
+			if (step.IsAutomatic || !SpeculativeSteps.Take(step, NewStep)) {
+				NewStep = SimplexStep<MatrixType, ElementType>(step);
 
-			if (NewStep.IsCompleted) {
-				break;
-			}
-
-			// Change order of variables in the array of variables
-			std::swap(NewStep.NumbersOfVariables[NewStep.StepChosenRC.Row], NewStep.NumbersOfVariables[(RowNumber - 1) + NewStep.StepChosenRC.Column]);
-			for (int i = RowNumber - 1; i < NewStep.NumbersOfVariables.size(); i++) {
-				if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
-					if (NewStep.NumbersOfVariables[i] > ArtificialBasisSteps[1].RealMatrix.ColNumber - 1) {
-						NewStep.NumbersOfVariables.erase(NewStep.NumbersOfVariables.begin() + i);
-						NewStep.RealMatrix.DeleteColumn(i - (RowNumber - 1));
-						break;
-					}
-				} else {
-					if (NewStep.NumbersOfVariables[i] > ArtificialBasisSteps[1].FracMatrix.ColNumber - 1) {
-						NewStep.NumbersOfVariables.erase(NewStep.NumbersOfVariables.begin() + i);
-						NewStep.FracMatrix.DeleteColumn(i - (RowNumber - 1));
-						break;
-					}
+				if (NewStep.IsCompleted) {
+					break;
 				}
-			}
 
-			// Disables "confirm" button
-			if constexpr (IS_SAME_TYPE(ElementType, float)) {
-				// Real case
-				AlgorithmState state = CheckAlgorithmState(NewStep.RealMatrix, false, NewStep.IsArtificialStep);
-				if (state == COMPLETED) {
-					NewStep.IsCompleted = true;
-				}
-			} else {
-				// Fractional case
-				AlgorithmState state = CheckAlgorithmState(NewStep.FracMatrix, false, NewStep.IsArtificialStep);
-				if (state == COMPLETED) {
-					NewStep.IsCompleted = true;
-				}
+				CompleteArtificialStep<MatrixType>(NewStep, StepMatrix<MatrixType>(ArtificialBasisSteps[1]).ColNumber);
 			}
 
 			if (!NewStep.IsAutomatic) {
@@ -719,6 +389,8 @@ template<typename MatrixType, typename ElementType> void SimplexAlgorithm(Step s
 				PreviousSimplexStepID = step.StepID;
 			}
 
+			SpeculativeSteps.Prefetch<MatrixType, ElementType>(step, GUILayer::PotentialLeads, GUILayer::CurrentLeadPos, 0);
+
 			if (ImGui::Button(u8"")) {
 				assert(Column != -1);
 				step.IsWaitingForInput = false;
@@ -737,28 +409,16 @@ template<typename MatrixType, typename ElementType> void SimplexAlgorithm(Step s
 	if (!step.IsWaitingForInput) {
 		int RowNumber = matrix.RowNumber;
 		for (int iteration = 0; iteration < RowNumber; iteration++) {
-			Step NewStep = SimplexStep<MatrixType, ElementType>(step);
-
-			if (NewStep.IsCompleted) {
-				break;
-			}
-
-			// Change order of variables in the array of variables
-			std::swap(NewStep.NumbersOfVariables[NewStep.StepChosenRC.Row], NewStep.NumbersOfVariables[(RowNumber - 1) + NewStep.StepChosenRC.Column]);
+			// Calculate current step unless it was calculated ahead
+			Step NewStep;
+			if (step.IsAutomatic || !SpeculativeSteps.Take(step, NewStep)) {
+				NewStep = SimplexStep<MatrixType, ElementType>(step);
 
-			// Disables "confirm" button
-			if constexpr (IS_SAME_TYPE(ElementType, float)) {
-				// Real case
-				AlgorithmState state = CheckAlgorithmState(NewStep.RealMatrix, false, NewStep.IsArtificialStep);
-				if (state == COMPLETED) {
-					NewStep.IsCompleted = true;
-				}
-			} else {
-				// Fractional case
-				AlgorithmState state = CheckAlgorithmState(NewStep.FracMatrix, false, NewStep.IsArtificialStep);
-				if (state == COMPLETED) {
-					NewStep.IsCompleted = true;
+				if (NewStep.IsCompleted) {
+					break;
 				}
+
+				CompleteSimplexStep<MatrixType>(NewStep);
 			}
 
 			// If it is not automatic execution rise waiting for input flag
@@ -773,142 +433,74 @@ template<typename MatrixType, typename ElementType> void SimplexAlgorithm(Step s
 	}
 }
 
-template<typename MatrixType, typename ElementType> void GaussElimination(MatrixType& matrix) {
-	int PivotRow = 0;
-	int PivotColumn = 0;
-	int num = 2;
-
-	// Type-independent zero element
-	// Float is [-EPSILON, +EPSILON], Fraction is 0/1
-	ElementType ZeroElement;
-	if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
-		ZeroElement = EPSILON;
-	} else {
-		ZeroElement = Fraction(0, 1);
-	}
-
-	while (PivotRow < (matrix.RowNumber - 1) && PivotColumn < matrix.ColNumber - 1) {
-		// Find max value in a column
-		ElementType MaxPivot;
-		MaxPivot = Genfabs(matrix[PivotRow][PivotColumn]);
-
-		int MaxPivotIdx = PivotRow;
-		for (int i = PivotRow; i < matrix.RowNumber - PivotRow - 1 - 1; i++) {
-			if (Genfabs(matrix[i][PivotColumn]) > MaxPivot) {
-				MaxPivot = Genfabs(matrix[i][PivotColumn]);
-				MaxPivotIdx = i;
-			}
-		}
-
-		if (Genfabs(matrix[MaxPivotIdx][PivotColumn]) <= ZeroElement) {
-			PivotColumn += 1;
-		} else {
-			matrix.SwapRows(PivotRow, MaxPivotIdx);
-
-			// Substract all rows below pivot
-			for (int i = PivotRow + 1; i < matrix.RowNumber - 1; i++) {
-
-				ElementType Factor = matrix[i][PivotColumn] / matrix[PivotRow][PivotColumn];
-				if constexpr (IS_SAME_TYPE(ElementType, float)) {
-					matrix[i][PivotColumn] = 0.0f;
-				} else {
-					matrix[i][PivotColumn] = Fraction(0, 1);
-				}
-
-				for (int j = PivotColumn + 1; j < matrix.ColNumber; j++) {
-					matrix[i][j] = matrix[i][j] - matrix[PivotRow][j] * Factor;
-				}
-			}
-
-			PivotRow++;
-			PivotColumn++;
-		}
-	}
-
-	// Backward substitution
-	for (int i = matrix.RowNumber - 2; i > 0; i--) {
-		if (Genfabs(matrix[i][i]) <= ZeroElement) continue;
-		for (int j = i; j > 0; j--) {
-			ElementType Factor = matrix[j - 1][i] / matrix[i][i];
-			for (int k = i; k < matrix.ColNumber - 1; k++) {
-				matrix[j - 1][k] = matrix[j - 1][k] - matrix[i][k] * Factor;
-			}
-
-			matrix[j - 1][matrix.ColNumber - 1] = matrix[j - 1][matrix.ColNumber - 1] - matrix[i][matrix.ColNumber - 1] * Factor;
-		}
-	}
-
-	// Normalization
-	for (int i = 0; i < matrix.RowNumber - 1; i++) {
-		ElementType Pivot = matrix[i][i];
-		if (Genfabs(Pivot) <= ZeroElement) continue;
+// Idle mode
+// --------------------
+// Without input and running solvers nothing on the screen changes, so the window sleeps until an event comes.
+// ImGui needs a couple of frames after an input to settle sizes and positions of windows
+static const int FramesAfterEvent = 3;
+// Window is redrawn at least that often, so blinking text cursor and similar things stay alive
+static const double IdleRedrawSeconds = 0.5;
+static int FramesToRedraw = FramesAfterEvent;
+
+static void RequestRedraw() {
+	FramesToRedraw = FramesAfterEvent;
+}
 
-		for (int j = i; j < matrix.ColNumber; j++) {
-			matrix[i][j] = matrix[i][j] / Pivot;
-		}
-	}
+static void OnMouseButton(GLFWwindow* window, int Button, int Action, int Mods) { RequestRedraw(); }
+static void OnScroll(GLFWwindow* window, double OffsetX, double OffsetY) { RequestRedraw(); }
+static void OnKey(GLFWwindow* window, int Key, int Scancode, int Action, int Mods) { RequestRedraw(); }
+static void OnChar(GLFWwindow* window, unsigned int Character) { RequestRedraw(); }
+static void OnCursorPos(GLFWwindow* window, double X, double Y) { RequestRedraw(); }
+static void OnCursorEnter(GLFWwindow* window, int IsEntered) { RequestRedraw(); }
+static void OnWindowSize(GLFWwindow* window, int Width, int Height) { RequestRedraw(); }
+static void OnWindowRefresh(GLFWwindow* window) { RequestRedraw(); }
+static void OnWindowFocus(GLFWwindow* window, int IsFocused) { RequestRedraw(); }
+
+// Mouse, scroll, key and char callbacks are called by ImGui backend, it has to be initialized after this
+static void InstallRedrawCallbacks(GLFWwindow* window) {
+	glfwSetMouseButtonCallback(window, OnMouseButton);
+	glfwSetScrollCallback(window, OnScroll);
+	glfwSetKeyCallback(window, OnKey);
+	glfwSetCharCallback(window, OnChar);
+	glfwSetCursorPosCallback(window, OnCursorPos);
+	glfwSetCursorEnterCallback(window, OnCursorEnter);
+	glfwSetWindowSizeCallback(window, OnWindowSize);
+	glfwSetWindowRefreshCallback(window, OnWindowRefresh);
+	glfwSetWindowFocusCallback(window, OnWindowFocus);
 }
 
-void Print(Matrix& matrix) {
-	printf("\n");
-	for (int i = 0; i < matrix.RowNumber - 1; i++) {
-		for (int j = 0; j < matrix.ColNumber; j++) {
-			printf("%f ", matrix[i][j]);
-		}
-		printf("\n");
-	}
+// Steps published by workers wake the window up
+static void OnStepPublished() {
+	glfwPostEmptyEvent();
 }
 
-template<typename MatrixType, typename ElementType>Step ExplicitBasis(Step step, MatrixType& matrix, std::vector<ElementType>& ExplicitBasis, std::vector<bool>& ActiveBasis, std::vector<ElementType>& TargetFunction) {
-	// Type-independent zero element
-	// Float is [-EPSILON, +EPSILON], Fraction is 0/1
-	ElementType ZeroElement;
-	if constexpr (IS_SAME_TYPE(MatrixType, Matrix)) {
-		ZeroElement = EPSILON;
+static void WaitForEvents() {
+	bool IsSolving = ArtificialBasisSolver.IsRunning.load() || SimplexAlgorithmSolver.IsRunning.load();
+	if (IsSolving) {
+		// Every published step wakes the window, so steps are shown as they come
+		glfwWaitEventsTimeout(IdleRedrawSeconds);
+		RequestRedraw();
+	} else if (FramesToRedraw > 0) {
+		glfwPollEvents();
+		FramesToRedraw -= 1;
 	} else {
-		ZeroElement = Fraction(0, 1);
-	}
-
-	// 1. Prepare matrix to Gauss elimination
-	std::vector<int> PositionsOfActiveElements;
-	std::vector<int> VariablesPositions;
-	for (int i = 0; i < ExplicitBasis.size(); i++) {
-		VariablesPositions.push_back(i + 1);
+		glfwWaitEventsTimeout(IdleRedrawSeconds);
 	}
+}
+//--------------------
 
-	// 1.1 Find positions of non-zero elements
-	for (int i = 0; i < ActiveBasis.size(); i++) {
-		if (ActiveBasis[i]) {
-			PositionsOfActiveElements.push_back(i);
-		}
-	}
-
-	// 1.2 Swap matrix column and variables to first (RowNumber) columns
-	for (int i = 0; i < PositionsOfActiveElements.size(); i++) {
-		int NonZeroPosition = PositionsOfActiveElements[i];
-		matrix.SwapColumns(i, NonZeroPosition);
-		std::swap(VariablesPositions[i], VariablesPositions[NonZeroPosition]);
-	}
-
-	// 2. Gauss Elimination
-	GaussElimination<MatrixType, ElementType>(matrix);
-
-	// 3. Complete table for first step of simplex alogrithm
-	// 3.1 Delete first RowNumber columns
-	for (int i = 0; i < matrix.RowNumber - 1; i++) {
-		matrix.DeleteColumn(0);
+int main(int argc, char** argv) {
+	// Batch solving and other modes without window
+	if (argc > 1) {
+		return RunCommandLine(argc, argv);
 	}
 
-	step.NumbersOfVariables = VariablesPositions;
-	MakeSimplexAlgorithmFunctionCoefficients(matrix, step.NumbersOfVariables, TargetFunction);
-	return step;
-}
-
-int main() {
 	// Problem characteristics
 	int NumberOfVariables;
 	int NumberOfLimitations;
 	int IsAutomatic = 1;
+	// Only problems read from LP and MPS files are maximized
+	bool IsMaximization = false;
 	int SizeConfirmedClicked = 0;
 	int OldSizeCondfirmedClicked = 0;
 
@@ -939,6 +531,90 @@ int main() {
 
 	bool FocusOnSolutionWindow = false;
 
+	// Snapshot read by the menu, it's applied after the problem is taken from it
+	SolutionSnapshot Snapshot;
+	// Problem that has been entered
+	auto TakeProblem = [&](Problem& problem) -> const char* {
+		if (!ContinueToProblemInput) {
+			return "Problem isn't entered yet";
+		}
+		problem.NumberOfLimitations = RealMatrix.RowNumber - 1;
+		problem.NumberOfVariables = RealMatrix.ColNumber - 1;
+		if (problem.NumberOfLimitations > problem.NumberOfVariables) {
+			return "Wrong dimensions of the problem";
+		}
+		problem.IsFractionalCoefficients = IsFractionalCoefficients;
+		problem.IsArtificialBasis = IsArtificialBasis;
+		problem.IsAutomatic = IsAutomatic;
+		problem.IsMaximization = IsMaximization;
+		problem.RealMatrix = RealMatrix;
+		problem.FracMatrix = FracMatrix;
+		problem.RealTargetFunction = RealTargetFunction;
+		problem.FractionalTargetFunction = FractionalTargetFunction;
+		return NULL;
+	};
+	auto SaveSnapshot = [&](const char* FileName, bool IsJournalSaved) -> const char* {
+		SolutionSnapshot Saved;
+		if (const char* Error = TakeProblem(Saved.problem)) {
+			return Error;
+		}
+		Saved.RealExplicitBasis = RealExplicitBasis;
+		Saved.FractionalExplicitBasis = FractionalExplicitBasis;
+		Saved.BasisActive = BasisActive;
+
+		Saved.IsSolutionShown = ShowSolution;
+		Saved.IsSimplexAlgorithmStarted = ShowSolution && StartSimplexAlgorithm;
+		Saved.HasJournal = IsJournalSaved;
+		if (Saved.IsSolutionShown) {
+			TakeSnapshotSteps(ArtificialBasisSteps, 1, ArtificialBasisSummaries, IsFractionalCoefficients, Saved.ArtificialBasisSteps, Saved.ArtificialBasisJournal);
+		}
+		if (Saved.IsSimplexAlgorithmStarted) {
+			TakeSnapshotSteps(SimplexAlgorithmSteps, 0, SimplexAlgorithmSummaries, IsFractionalCoefficients, Saved.SimplexAlgorithmSteps, Saved.SimplexAlgorithmJournal);
+		}
+		return WriteSnapshot(FileName, Saved);
+	};
+	// Report of the solution on the screen. Solution that hasn't got to the end of the simplex algorithm is stopped
+	auto SaveReport = [&](const char* FileName) -> const char* {
+		Problem problem;
+		if (const char* Error = TakeProblem(problem)) {
+			return Error;
+		}
+		if (!ShowSolution) {
+			return "Problem isn't solved yet";
+		}
+		Solution solution;
+		solution.State = CONTINUE;
+		TakeReportPivots(ArtificialBasisSteps, 1, ArtificialBasisSummaries, IsFractionalCoefficients, true, solution);
+		if (ArtificialBasisSteps.size() > 1) {
+			Step& step = ArtificialBasisSteps.back();
+			AlgorithmState State = IsFractionalCoefficients ? CheckAlgorithmState(step.FracMatrix, false, true) : CheckAlgorithmState(step.RealMatrix, false, true);
+			if (State == SOLUTION_DOESNT_EXIST) {
+				solution.State = State;
+			}
+		}
+		if (StartSimplexAlgorithm && !SimplexAlgorithmSteps.empty()) {
+			TakeReportPivots(SimplexAlgorithmSteps, 0, SimplexAlgorithmSummaries, IsFractionalCoefficients, false, solution);
+			Step& step = SimplexAlgorithmSteps.back();
+			if (IsFractionalCoefficients) {
+				solution.State = CheckAlgorithmState(step.FracMatrix, false, false);
+				if (solution.State == COMPLETED) {
+					ExtractSolution<FractionalMatrix>(step, problem.NumberOfVariables, solution);
+				}
+			} else {
+				solution.State = CheckAlgorithmState(step.RealMatrix, false, false);
+				if (solution.State == COMPLETED) {
+					ExtractSolution<Matrix>(step, problem.NumberOfVariables, solution);
+				}
+			}
+		}
+		if (solution.State == COMPLETED && IsMaximization) {
+			solution.Objective = -solution.Objective;
+		}
+		SolutionReport Report;
+		MakeSolutionReport(problem, solution, Report);
+		return WriteSolutionReport(FileName, Report);
+	};
+
 	glfwInit();
 
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
@@ -965,11 +641,17 @@ int main() {
 	ImGui::StyleColorsLight();
 
 	// Setup Platform/Renderer bindings
+	InstallRedrawCallbacks(window);
+	ArtificialBasisSolver.OnPublish = OnStepPublished;
+	SimplexAlgorithmSolver.OnPublish = OnStepPublished;
 	ImGui_ImplGlfw_InitForOpenGL(window, true);
 	ImGui_ImplOpenGL3_Init("#version 430 core");
 
+	// CPU time of the previous frame for the performance panel
+	float FrameMilliseconds = 0.0f;
 	while (!glfwWindowShouldClose(window)) {
-		glfwPollEvents();
+		WaitForEvents();
+		ProfileClock::time_point FrameStart = ProfileClock::now();
 
 		ImGui_ImplOpenGL3_NewFrame();
 		ImGui_ImplGlfw_NewFrame();
@@ -977,11 +659,15 @@ int main() {
 
 		// Main menu bar
 		bool IsReadHasHappened = false;
-		GUILayer::MainMenuBar(RealMatrix, FracMatrix, BasisActive, NumberOfVariables, NumberOfLimitations, IsReadHasHappened, IsFractionalCoefficients);
+		bool IsSnapshotLoaded = false;
+		GUILayer::MainMenuBar(RealMatrix, FracMatrix, RealTargetFunction, FractionalTargetFunction, BasisActive, NumberOfVariables, NumberOfLimitations, IsReadHasHappened, IsFractionalCoefficients,
+			IsArtificialBasis, IsAutomatic, IsMaximization, Snapshot, IsSnapshotLoaded, SaveSnapshot, SaveReport);
 
 		// If we read data from a file we fast forward all configuration steps
 		if (IsReadHasHappened) {
 			UnconfirmedIsFractionalCoefficients = IsFractionalCoefficients;
+			UnconfirmedIsArtificialBasis = IsArtificialBasis;
+			UnconfirmedIsAutomatic = IsAutomatic;
 			SizeConfirmedReadyToContinue = true;
 			ContinueToProblemInput = true;
 			RealTargetFunction.resize(NumberOfVariables);
@@ -998,11 +684,30 @@ int main() {
 			ExplicitBasisSteps.clear();
 			PreviousSimplexStepID = -1;
 			PreviousArtificialStepID = -1;
+			ArtificialBasisSolver.Reset();
+			SimplexAlgorithmSolver.Reset();
+			SpeculativeSteps.Clear();
+			GUILayer::Overview.Release();
 
 			StartSimplexAlgorithm = false;
 			ShowSolution = false;
 		}
 
+		// Solution of a snapshot goes on from the steps it has stopped at
+		if (IsSnapshotLoaded) {
+			RealExplicitBasis = Snapshot.RealExplicitBasis;
+			FractionalExplicitBasis = Snapshot.FractionalExplicitBasis;
+			BasisActive = Snapshot.BasisActive;
+			ArtificialBasisSteps.insert(ArtificialBasisSteps.end(), Snapshot.ArtificialBasisSteps.begin(), Snapshot.ArtificialBasisSteps.end());
+			SimplexAlgorithmSteps = Snapshot.SimplexAlgorithmSteps;
+			ArtificialBasisSummaries = Snapshot.ArtificialBasisJournal;
+			SimplexAlgorithmSummaries = Snapshot.SimplexAlgorithmJournal;
+			ShowSolution = Snapshot.IsSolutionShown;
+			StartSimplexAlgorithm = Snapshot.IsSimplexAlgorithmStarted;
+			FocusOnSolutionWindow = ShowSolution;
+			Snapshot = SolutionSnapshot();
+		}
+
 		// Docking 
 		// --------------------------------------------
 		static bool opt_fullscreen_persistant = true;
@@ -1048,9 +753,9 @@ int main() {
 		ImGui::Separator();
 
 		// Choose number of variables
-		NumberOfVariables = GUILayer::ComboBox(GUILayer::ComboBoxVariablesLabel, NumberOfVariables - 2, NumberOfLimitations - 1, IsReadHasHappened);
+		NumberOfVariables = GUILayer::DimensionInput(GUILayer::DimensionVariablesLabel, NumberOfVariables - 2, NumberOfLimitations - 1, IsReadHasHappened);
 		// Choose number of limitations
-		NumberOfLimitations = GUILayer::ComboBox(GUILayer::ComboBoxLimitationsLabel, NumberOfVariables - 2, NumberOfLimitations - 1, IsReadHasHappened);
+		NumberOfLimitations = GUILayer::DimensionInput(GUILayer::DimensionLimitationsLabel, NumberOfVariables - 2, NumberOfLimitations - 1, IsReadHasHappened);
 
 		// Apply new sizes
 		if (ImGui::Button(u8"")) {
@@ -1101,6 +806,10 @@ int main() {
 				StartSimplexAlgorithm = false;
 				PreviousSimplexStepID = -1;
 				PreviousArtificialStepID = -1;
+				ArtificialBasisSolver.Reset();
+				SimplexAlgorithmSolver.Reset();
+				SpeculativeSteps.Clear();
+				GUILayer::Overview.Release();
 
 				IsFractionalCoefficients = UnconfirmedIsFractionalCoefficients;
 				IsArtificialBasis = UnconfirmedIsArtificialBasis;
@@ -1126,11 +835,8 @@ int main() {
 					// Real basis input
 					GUILayer::InputVector(RealExplicitBasis, &BasisActive, RealExplicitBasis.size(),
 						// Print Function
-						[](int Size) {
-							for (int i = 0; i < Size; i++) {
-								ImGui::Text((std::string("x") + std::to_string(i + 1)).c_str());
-								ImGui::NextColumn();
-							}
+						[](int Index, int Size) {
+							ImGui::Text("x%d", Index + 1);
 						});
 					ImGui::PopID();
 				} else {
@@ -1138,11 +844,8 @@ int main() {
 					// Fractional basis input
 					GUILayer::InputVector(FractionalExplicitBasis, &BasisActive, FractionalExplicitBasis.size(),
 						// Print Function
-						[](int Size) {
-							for (int i = 0; i < Size; i++) {
-								ImGui::Text((std::string("x") + std::to_string(i + 1)).c_str());
-								ImGui::NextColumn();
-							}
+						[](int Index, int Size) {
+							ImGui::Text("x%d", Index + 1);
 						});
 					ImGui::PopID();
 				}
@@ -1153,10 +856,11 @@ int main() {
 			// Matrix of limitations
 			ImGui::PushID("Matrix");
 			ImGui::Text(u8" ");
-			ImGui::SameLine(); GUILayer::HelpMarker(u8"*          Tab.\n*       .");
+			ImGui::SameLine(); GUILayer::HelpMarker(u8"*    ,  Enter  Tab.\n*          Shift.\n*Ctrl+C   , Ctrl+V   ,  ,     .\n*Delete   .");
 			// Group
-			ImGui::SetNextWindowContentSize(ImVec2(ImGui::GetCursorPos().x + RealMatrix.ColNumber * 170, RealMatrix.RowNumber * 30.0f));
-			ImGui::BeginChild("Matrix Of Limitations", ImVec2(ImGui::GetWindowWidth() - ImGui::GetCursorPos().x - 25.0f, ImGui::GetWindowHeight() * 0.7f > RealMatrix.RowNumber * 30.0f ? RealMatrix.RowNumber * 42.0f : ImGui::GetWindowHeight() * 0.7f), false, ImGuiWindowFlags_HorizontalScrollbar);
+			ImVec2 MatrixContentSize = GUILayer::MatrixInputContentSize(RealMatrix);
+			ImGui::SetNextWindowContentSize(MatrixContentSize);
+			ImGui::BeginChild("Matrix Of Limitations", ImVec2(ImGui::GetWindowWidth() - ImGui::GetCursorPos().x - 25.0f, std::min(MatrixContentSize.y + ImGui::GetStyle().ScrollbarSize, ImGui::GetIO().DisplaySize.y * 0.6f)), false, ImGuiWindowFlags_HorizontalScrollbar);
 			if (!IsFractionalCoefficients) {
 				GUILayer::MatrixInput(RealMatrix);
 			} else {
@@ -1174,13 +878,12 @@ int main() {
 				// Target function input with lambda expression
 				GUILayer::InputVector(RealTargetFunction, NULL, RealTargetFunction.size(),
 					// Print Function
-					[](int Size) {
-						for (int i = 0; i < Size - 1; i++) {
-							ImGui::Text((std::string("x") + std::to_string(i + 1)).c_str());
-							ImGui::NextColumn();
+					[](int Index, int Size) {
+						if (Index < Size - 1) {
+							ImGui::Text("x%d", Index + 1);
+						} else {
+							ImGui::Text("C");
 						}
-						ImGui::Text("C");
-						ImGui::NextColumn();
 					});
 				ImGui::PopID();
 			} else {
@@ -1189,13 +892,12 @@ int main() {
 				// Target function input with lambda expression
 				GUILayer::InputVector(FractionalTargetFunction, NULL, FractionalTargetFunction.size(),
 					// Print Function
-					[](int Size) {
-						for (int i = 0; i < Size - 1; i++) {
-							ImGui::Text((std::string("x") + std::to_string(i + 1)).c_str());
-							ImGui::NextColumn();
+					[](int Index, int Size) {
+						if (Index < Size - 1) {
+							ImGui::Text("x%d", Index + 1);
+						} else {
+							ImGui::Text("C");
 						}
-						ImGui::Text("C");
-						ImGui::NextColumn();
 					});
 
 				ImGui::PopID();
@@ -1213,6 +915,10 @@ int main() {
 				StartSimplexAlgorithm = false;
 				PreviousSimplexStepID = -1;
 				PreviousArtificialStepID = -1;
+				ArtificialBasisSolver.Reset();
+				SimplexAlgorithmSolver.Reset();
+				SpeculativeSteps.Clear();
+				GUILayer::Overview.Release();
 				FocusOnSolutionWindow = true;
 			}
 			ImGui::SameLine();  GUILayer::HelpMarker(u8"''      .");
@@ -1229,6 +935,10 @@ int main() {
 					StartSimplexAlgorithm = false;
 					PreviousSimplexStepID = -1;
 					PreviousArtificialStepID = -1;
+					ArtificialBasisSolver.Reset();
+					SimplexAlgorithmSolver.Reset();
+					SpeculativeSteps.Clear();
+					GUILayer::Overview.Release();
 				}
 			}
 		}
@@ -1267,6 +977,10 @@ int main() {
 				StartSimplexAlgorithm = false;
 				PreviousSimplexStepID = -1;
 				PreviousArtificialStepID = -1;
+				ArtificialBasisSolver.Reset();
+				SimplexAlgorithmSolver.Reset();
+				SpeculativeSteps.Clear();
+				GUILayer::Overview.Release();
 				ImGui::End();
 				goto BeforeShowSolutionTarget;
 			}
@@ -1314,6 +1028,7 @@ int main() {
 						} else {
 							MakeArtificialFunctionCoefficients(step.RealMatrix);
 						}
+						ArtificialBasisSolver.Reset();
 						ArtificialBasisSteps.push_back(step);
 					}
 
@@ -1323,14 +1038,38 @@ int main() {
 						step.IsWaitingForInput = false;
 					}
 
+					// Automatic solution is calculated by the worker thread
+					if (step.IsAutomatic) {
+						GUILayer::PotentialLeads.clear();
+						if (!ArtificialBasisSolver.IsStarted) {
+							// New solution of the artificial basis method makes the simplex algorithm start again, its worker mustn't write into the trace
+							SimplexAlgorithmSolver.Reset();
+							Matrix& FirstMatrix = ArtificialBasisSteps[1].RealMatrix;
+							StepTrace* Trace = OpenSolutionTrace(false, FirstMatrix.RowNumber - 1, FirstMatrix.ColNumber - 1, IsFractionalCoefficients);
+							if (!IsFractionalCoefficients) {
+								ArtificialBasisSolver.Start<Matrix, float>(step, ArtificialBasisSteps[1].RealMatrix.ColNumber, Trace);
+							} else {
+								ArtificialBasisSolver.Start<FractionalMatrix, Fraction>(step, ArtificialBasisSteps[1].FracMatrix.ColNumber, Trace);
+							}
+						}
+						if (ArtificialBasisSolver.Drain(ArtificialBasisSteps) != 0) {
+							step = ArtificialBasisSteps[ArtificialBasisSteps.size() - 1];
+						}
+						GUILayer::SummarizeOldSteps(ArtificialBasisSteps, 1, ArtificialBasisSummaries, IsFractionalCoefficients);
+						GUILayer::SolverProgress(ArtificialBasisSolver);
+						GUILayer::DisplayStepSummaries(ArtificialBasisSummaries);
+					}
+
 					// Display all steps that has been calculated
-					ImGui::SetNextWindowContentSize(ImVec2(ImGui::GetCursorPos().x + RealMatrix.ColNumber * 170, 0.0f));
+					ImGui::SetNextWindowContentSize(ImVec2(GUILayer::StepsContentWidth(ArtificialBasisSteps, IsFractionalCoefficients), 0.0f));
 					ImGui::BeginChild("Matrix Of Limitations", ImVec2(ImGui::GetWindowWidth() - ImGui::GetCursorPos().x - 25.0f, ImGui::GetWindowHeight() * 0.7f), true, ImGuiWindowFlags_HorizontalScrollbar);
 					GUILayer::DisplaySteps(ArtificialBasisSteps, 1, IsFractionalCoefficients);
-					if (!IsFractionalCoefficients) {
-						ArtificialBasis<Matrix, float>(step);
-					} else {
-						ArtificialBasis<FractionalMatrix, Fraction>(step);
+					if (!step.IsAutomatic) {
+						if (!IsFractionalCoefficients) {
+							ArtificialBasis<Matrix, float>(step);
+						} else {
+							ArtificialBasis<FractionalMatrix, Fraction>(step);
+						}
 					}
 
 					// Step back
@@ -1341,7 +1080,9 @@ int main() {
 						step = ArtificialBasisSteps[LastElementIndex - 1];
 						ArtificialBasisSteps.erase(ArtificialBasisSteps.begin() + LastElementIndex);
 						StartSimplexAlgorithm = false;
+						SimplexAlgorithmSolver.Reset();
 						SimplexAlgorithmSteps.clear();
+						SpeculativeSteps.Clear();
 						PreviousArtificialStepID = -1;
 					}
 
@@ -1562,8 +1303,8 @@ int main() {
 
 			// Sholution has been found
 			if (step.IsCompleted && step.IsArtificialStep) {
-				ImGui::SetNextWindowContentSize(ImVec2(ImGui::GetCursorPos().x + RealMatrix.ColNumber * 170, 0.0f));
-				ImGui::BeginChild("Solution", ImVec2(ImGui::GetWindowWidth() - ImGui::GetCursorPos().x - 25.0f, 130.0f), true, ImGuiWindowFlags_HorizontalScrollbar);
+				// Solution vector scrolls itself
+				ImGui::BeginChild("Solution", ImVec2(ImGui::GetWindowWidth() - ImGui::GetCursorPos().x - 25.0f, 130.0f), true);
 				ImGui::Text(u8"");
 				ImGui::Separator();
 
@@ -1615,7 +1356,9 @@ int main() {
 				if (ImGui::BeginTabItem(u8" ", &StartSimplexAlgorithm, SimplexAlgorithmTabFlags)) {
 					// Simplex algorithm's tab has been closed
 					if (StartSimplexAlgorithm == false) {
+						SimplexAlgorithmSolver.Reset();
 						SimplexAlgorithmSteps.clear();
+						SpeculativeSteps.Clear();
 						PreviousSimplexStepID = -1;
 						ImGui::EndTabItem();
 						goto ToStartOfSimplexAlgorithm;
@@ -1651,19 +1394,42 @@ int main() {
 						step.IsCompleted = false;
 						step.IsArtificialStep = false;
 
+						SimplexAlgorithmSolver.Reset();
 						SimplexAlgorithmSteps.push_back(step);
 					} else {
 						size_t LastSimplexAlgorithmElementIndex = SimplexAlgorithmSteps.size() - 1;
 						step = SimplexAlgorithmSteps[LastSimplexAlgorithmElementIndex];
 					}
+
+					// Automatic solution is calculated by the worker thread
+					if (step.IsAutomatic) {
+						GUILayer::PotentialLeads.clear();
+						if (!SimplexAlgorithmSolver.IsStarted) {
+							StepTrace* Trace = OpenSolutionTrace(ArtificialBasisSolver.IsStarted, RealMatrix.RowNumber - 1, RealMatrix.ColNumber - 1, IsFractionalCoefficients);
+							if (IsFractionalCoefficients) {
+								SimplexAlgorithmSolver.Start<FractionalMatrix, Fraction>(step, 0, Trace);
+							} else {
+								SimplexAlgorithmSolver.Start<Matrix, float>(step, 0, Trace);
+							}
+						}
+						if (SimplexAlgorithmSolver.Drain(SimplexAlgorithmSteps) != 0) {
+							step = SimplexAlgorithmSteps[SimplexAlgorithmSteps.size() - 1];
+						}
+						GUILayer::SummarizeOldSteps(SimplexAlgorithmSteps, 0, SimplexAlgorithmSummaries, IsFractionalCoefficients);
+						GUILayer::SolverProgress(SimplexAlgorithmSolver);
+						GUILayer::DisplayStepSummaries(SimplexAlgorithmSummaries);
+					}
+
 					ImGui::PushID("Simplex Algorithm");
-					ImGui::SetNextWindowContentSize(ImVec2(ImGui::GetCursorPos().x + RealMatrix.ColNumber * 170, 0.0f));
+					ImGui::SetNextWindowContentSize(ImVec2(GUILayer::StepsContentWidth(SimplexAlgorithmSteps, IsFractionalCoefficients), 0.0f));
 					ImGui::BeginChild("Matrix Of Limitations", ImVec2(ImGui::GetWindowWidth() - ImGui::GetCursorPos().x - 25.0f, ImGui::GetWindowHeight() * 0.7f), true, ImGuiWindowFlags_HorizontalScrollbar);
 					GUILayer::DisplaySteps(SimplexAlgorithmSteps, 0, IsFractionalCoefficients);
-					if (IsFractionalCoefficients) {
-						SimplexAlgorithm<FractionalMatrix, Fraction>(step);
-					} else {
-						SimplexAlgorithm<Matrix, float>(step);
+					if (!step.IsAutomatic) {
+						if (IsFractionalCoefficients) {
+							SimplexAlgorithm<FractionalMatrix, Fraction>(step);
+						} else {
+							SimplexAlgorithm<Matrix, float>(step);
+						}
 					}
 
 					// Step back
@@ -1675,6 +1441,7 @@ int main() {
 							// If it is first step we need to return to artificial basis steps
 							if (LastElementIndex == 0) {
 								SimplexAlgorithmSteps.clear();
+								SpeculativeSteps.Clear();
 								PreviousSimplexStepID = -1;
 								ImGui::PopID();
 								ImGui::EndChild();
@@ -1687,6 +1454,7 @@ int main() {
 							// One before this last element
 							step = SimplexAlgorithmSteps[LastElementIndex - 1];
 							SimplexAlgorithmSteps.erase(SimplexAlgorithmSteps.begin() + LastElementIndex);
+							SpeculativeSteps.Clear();
 						}
 						ImGui::PopID();
 					}
@@ -1711,7 +1479,7 @@ int main() {
 							} else if (state == COMPLETED) {
 								// Fractional case
 								BubbleSort(step.FracMatrix, BaseVariables, true);
-								GUILayer::DisplaySolutionVector(step.FracMatrix, BaseVariables, step.NumbersOfVariables.size(), true);
+								GUILayer::DisplaySolutionVector(step.FracMatrix, BaseVariables, step.NumbersOfVariables.size(), true, IsMaximization);
 							}
 							ImGui::EndChild();
 						}
@@ -1730,7 +1498,7 @@ int main() {
 							} else if (state == COMPLETED) {
 								// Real case
 								BubbleSort(step.RealMatrix, BaseVariables, true);
-								GUILayer::DisplaySolutionVector(step.RealMatrix, BaseVariables, step.NumbersOfVariables.size(), true);
+								GUILayer::DisplaySolutionVector(step.RealMatrix, BaseVariables, step.NumbersOfVariables.size(), true, IsMaximization);
 							}
 							ImGui::EndChild();
 						}
@@ -1742,6 +1510,9 @@ int main() {
 			ImGui::End();
 		}
 
+		size_t HistoryMemory = GUILayer::StepsMemory(ArtificialBasisSteps) + GUILayer::StepsMemory(SimplexAlgorithmSteps) + GUILayer::StepsMemory(ExplicitBasisSteps);
+		HistoryMemory += (ArtificialBasisSummaries.Rows.capacity() + SimplexAlgorithmSummaries.Rows.capacity()) * sizeof(StepSummary);
+		GUILayer::PerformanceWindow(FrameMilliseconds, HistoryMemory);
 
 		ImGui::Render();
 		int display_w, display_h;
@@ -1750,6 +1521,8 @@ int main() {
 		glClear(GL_COLOR_BUFFER_BIT);
 		glClearColor(0.3f, 0.3f, 0.3f, 1.0f);
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		// Waiting for vertical sync isn't counted
+		FrameMilliseconds = std::chrono::duration<float, std::milli>(ProfileClock::now() - FrameStart).count();
 
 		glfwSwapBuffers(window);
 	}
@@ -0,0 +1,172 @@
+// Test of the background solver without the interface: the worker publishes steps through the queue
+// with one producer and one consumer and wakes the consumer through OnPublish, the way glfwPostEmptyEvent
+// wakes the GUI. Consumer sleeps until it's woken, so a lost wake makes the test time out.
+// Build it with -fsanitize=thread to check the queue for data races.
+#include <stdio.h>
+
+#include <vector>
+#include <string>
+#include <type_traits>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <new>
+#include <thread>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <random>
+#include <cstdint>
+#include <cerrno>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include "windows.h" // For mapped files
+#endif
+#include "Common.h"
+#include "Profiler.h"
+#include "Simplex.h"
+#include "NumberParser.h"
+#include "MpsFile.h"
+#include "LpFile.h"
+#include "ProblemFile.h"
+#include "CsvFile.h"
+#include "Snapshot.h"
+#include "StepTrace.h"
+#include "BackgroundSolver.h"
+#include "../benchmark/GeneratedProblems.h"
+
+// Consumer gives up waiting for a wake after this time
+static const int WAKE_TIMEOUT_SECONDS = 10;
+
+static int Failures = 0;
+
+static void Check(bool Condition, const char* Message) {
+	if (!Condition) {
+		printf("FAILED: %s\n", Message);
+		Failures += 1;
+	}
+}
+
+// Pointers go through the queue in the order they were pushed, also when the queue is full and wraps around
+static void TestStepQueue() {
+	const size_t Count = 100000;
+	StepQueue Queue;
+	std::thread Producer([&Queue]() {
+		for (size_t i = 1; i <= Count; i++) {
+			// Queue never looks at the steps, so numbers are enough
+			while (!Queue.Push((Step*)i)) {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	size_t Expected = 1;
+	bool IsInOrder = true;
+	while (Expected <= Count) {
+		if (Step* step = Queue.Pop()) {
+			IsInOrder = IsInOrder && (size_t)step == Expected;
+			Expected += 1;
+		} else {
+			std::this_thread::yield();
+		}
+	}
+	Producer.join();
+	Check(IsInOrder, "steps come out of the queue in the order they were pushed");
+	Check(Queue.Pop() == NULL, "queue is empty after every step is taken");
+}
+
+// Wake hook of the worker, it stands for glfwPostEmptyEvent
+static std::mutex WakeMutex;
+static std::condition_variable WakeCondition;
+static int Wakes = 0;
+
+static void OnStepPublished() {
+	std::lock_guard<std::mutex> Lock(WakeMutex);
+	Wakes += 1;
+	WakeCondition.notify_one();
+}
+
+// Consumer takes steps only after a wake, as the main loop does. All steps of the artificial basis method
+// have to arrive, and the worker has to make the same pivots as the solver in the calling thread
+static void TestWakeHook(bool IsSlowConsumer) {
+	Problem problem;
+	GenerateProblem(40, 80, 7, problem);
+	Solution Expected = SolveProblem<Matrix, float>(problem);
+
+	BackgroundSolver Solver;
+	Solver.OnPublish = OnStepPublished;
+	{
+		std::lock_guard<std::mutex> Lock(WakeMutex);
+		Wakes = 0;
+	}
+	Solver.Start<Matrix, float>(MakeArtificialBasisStep<Matrix>(problem), problem.NumberOfVariables + 1);
+
+	std::vector<Step> Steps;
+	int SeenWakes = 0;
+	bool IsWakeLost = false;
+	while (true) {
+		// Worker wakes the consumer after it stops, so the steps drained after that are the last ones
+		bool IsStopped = !Solver.IsRunning.load(std::memory_order_acquire);
+		Solver.Drain(Steps);
+		if (IsStopped) {
+			break;
+		}
+		if (IsSlowConsumer) {
+			// Worker publishes several steps while the consumer is busy, they are taken after one wake
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}
+
+		std::unique_lock<std::mutex> Lock(WakeMutex);
+		if (!WakeCondition.wait_for(Lock, std::chrono::seconds(WAKE_TIMEOUT_SECONDS), [&SeenWakes]() { return Wakes != SeenWakes; })) {
+			IsWakeLost = true;
+			break;
+		}
+		SeenWakes = Wakes;
+	}
+	Solver.Reset();
+
+	Check(!IsWakeLost, "worker wakes the consumer for every published step and when it stops");
+	Check(Expected.ArtificialPivots > 0, "generated problem needs pivots of the artificial basis method");
+	Check(Steps.size() == Expected.ArtificialPivots, "every step of the artificial basis method is published");
+	bool IsSamePivots = Steps.size() == Expected.ArtificialPivots;
+	for (int i = 0; IsSamePivots && i < Steps.size(); i++) {
+		PivotStatistics& Pivot = Expected.Pivots[i];
+		IsSamePivots = Steps[i].StepID == Pivot.StepID && Steps[i].NumbersOfVariables[Steps[i].StepChosenRC.Row] == Pivot.EnteringVariable;
+	}
+	Check(IsSamePivots, "worker makes the same pivots as the solver in the calling thread");
+	Check(Wakes <= Steps.size() + 1, "consumer is woken once for a batch of steps, not for every step");
+}
+
+// Reset stops a worker in the middle of solving and frees the steps nobody has taken
+static void TestCancel() {
+	Problem problem;
+	GenerateProblem(200, 400, 11, problem);
+	BackgroundSolver Solver;
+	Solver.Start<Matrix, float>(MakeArtificialBasisStep<Matrix>(problem), problem.NumberOfVariables + 1);
+	while (Solver.Iteration.load() < 10) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	Solver.Reset();
+	Check(!Solver.IsRunning.load(), "worker is stopped after reset");
+	Check(Solver.Queue.Pop() == NULL, "reset frees the steps nobody has taken");
+}
+
+int main() {
+	TestStepQueue();
+	TestWakeHook(false);
+	TestWakeHook(true);
+	TestCancel();
+	if (Failures != 0) {
+		return 1;
+	}
+	printf("Background solver is fine\n");
+	return 0;
+}
@@ -0,0 +1,29 @@
+# Solves one problem by every way the batch solver has: decomposition, trace, warm start with a saved basis
+# and worker processes. Every run has to finish with status "done" and a line of the table that matches EXPECTED.
+# Flags of a run are separated by commas, so runs can be kept in one list.
+# Run with: cmake -DCLI=<SimplexMethodCli> -DPROBLEM=<file> -DWORK_DIR=<directory> -DEXPECTED=<regex> [-DFLAGS=...] -P CheckBatchPaths.cmake
+file(REMOVE_RECURSE ${WORK_DIR})
+file(MAKE_DIRECTORY ${WORK_DIR})
+get_filename_component(NAME ${PROBLEM} NAME)
+file(COPY ${PROBLEM} DESTINATION ${WORK_DIR})
+
+set(RUNS
+	"--workers,0"
+	"--workers,0,--trace,1"
+	"--workers,0,--save-basis"
+	"--workers,0,--warm-start"
+	"--workers,1,--report"
+)
+foreach(RUN IN LISTS RUNS)
+	string(REPLACE "," ";" RUN_FLAGS "${RUN}")
+	execute_process(COMMAND ${CLI} --batch ${FLAGS} ${RUN_FLAGS} ${NAME}
+		WORKING_DIRECTORY ${WORK_DIR}
+		RESULT_VARIABLE RESULT
+		OUTPUT_VARIABLE OUTPUT
+	)
+	if(NOT RESULT EQUAL 0 OR NOT OUTPUT MATCHES "${NAME} +done +${EXPECTED}")
+		# Table is printed as it is, the error message would reflow it
+		message("${OUTPUT}")
+		message(FATAL_ERROR "Batch run with ${RUN} exited with ${RESULT}, expected a line with ${EXPECTED}")
+	endif()
+endforeach()